@@ -13,5 +13,11 @@
 
 #include "ahh5_cmesh.h"
 #include "ahh5_mesh.h"
+#include "ahh5_smesh_query.h"
+#include "ahh5_umesh_bvh.h"
+#include "ahh5_umesh_geometry.h"
+#include "ahh5_umesh_partition.h"
+#include "ahh5_umesh_reorder.h"
+#include "ahh5_umesh_topo.h"
 
 #endif /* _AHH5_H_ */
@@ -0,0 +1,342 @@
+/**
+ * @file   ahh5_smesh_query.c
+ *
+ * @brief  Structured mesh queries on implicit indices.
+ *
+ * The uniform axes locate a point by a floor then a short walk on the nodes,
+ * so the result is always consistent with the stored nodes.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_smesh_query.h"
+
+
+// Absolute value (avoid the math library).
+static double ahh5_abs(double value)
+{
+  return value < 0 ? -value : value;
+}
+
+
+// Initialize the query of an axis, detect the uniform spacing.
+static char ahh5_init_saxis_query(ahh5_saxis_query_t *axis, const AH5_axis_t *nodes)
+{
+  double span, tolerance;
+  hsize_t i;
+
+  axis->nb_nodes = nodes->nb_nodes;
+  axis->nodes = nodes->nodes;
+  axis->uniform = AH5_FALSE;
+  axis->origin = 0;
+  axis->step = 0;
+
+  if (nodes->nb_nodes < 2 || nodes->nodes == NULL)
+    return AH5_FALSE;
+
+  for (i = 1; i < nodes->nb_nodes; ++i)
+    if (!(nodes->nodes[i - 1] < nodes->nodes[i]))
+      return AH5_FALSE;
+
+  axis->origin = nodes->nodes[0];
+  span = (double) nodes->nodes[nodes->nb_nodes - 1] - axis->origin;
+  axis->step = span / (double) (nodes->nb_nodes - 1);
+
+  // The nodes are floats: allow a few ulps of the largest magnitude.
+  tolerance = ahh5_abs(axis->origin) + ahh5_abs(span);
+  tolerance *= 4 * FLT_EPSILON;
+  axis->uniform = AH5_TRUE;
+  for (i = 1; i < nodes->nb_nodes - 1 && axis->uniform; ++i)
+    if (ahh5_abs(nodes->nodes[i] - (axis->origin + (double) i * axis->step)) > tolerance)
+      axis->uniform = AH5_FALSE;
+
+  return AH5_TRUE;
+}
+
+
+char ahh5_init_smesh_query(ahh5_smesh_query_t *query, const AH5_smesh_t *smesh)
+{
+  const AH5_axis_t *axes[3];
+  char success = AH5_TRUE;
+  int d;
+
+  axes[0] = &smesh->x;
+  axes[1] = &smesh->y;
+  axes[2] = &smesh->z;
+  for (d = 0; d < 3; ++d)
+  {
+    success &= ahh5_init_saxis_query(query->axes + d, axes[d]);
+    query->nb_cells[d] = axes[d]->nb_nodes > 0 ? axes[d]->nb_nodes - 1 : 0;
+  }
+
+  if (!success)
+    AH5_log_error("Structured mesh query: an axis is too small or not increasing.");
+  return success;
+}
+
+
+hsize_t ahh5_scell_id(const ahh5_smesh_query_t *query, hsize_t i, hsize_t j, hsize_t k)
+{
+  return i + query->nb_cells[0] * (j + query->nb_cells[1] * k);
+}
+
+
+hsize_t ahh5_snode_id(const ahh5_smesh_query_t *query, hsize_t i, hsize_t j, hsize_t k)
+{
+  return i + query->axes[0].nb_nodes * (j + query->axes[1].nb_nodes * k);
+}
+
+
+void ahh5_scell_ijk(const ahh5_smesh_query_t *query, hsize_t id, hsize_t ijk[3])
+{
+  ijk[0] = id % query->nb_cells[0];
+  id /= query->nb_cells[0];
+  ijk[1] = id % query->nb_cells[1];
+  ijk[2] = id / query->nb_cells[1];
+}
+
+
+char ahh5_saxis_locate(const ahh5_saxis_query_t *axis, float x, hsize_t *cell)
+{
+  hsize_t last, low, high, mid;
+  double guess;
+
+  if (axis->nb_nodes < 2 || !(x >= axis->nodes[0] && x <= axis->nodes[axis->nb_nodes - 1]))
+    return AH5_FALSE;
+
+  last = axis->nb_nodes - 2;
+  if (axis->uniform)
+  {
+    // The truncation of a positive guess is its floor.
+    guess = (x - axis->origin) / axis->step;
+    low = guess <= 0 ? 0 : (guess >= (double) last ? last : (hsize_t) guess);
+    // Fix the rounding of the floor against the stored nodes.
+    while (low > 0 && x < axis->nodes[low])
+      --low;
+    while (low < last && x >= axis->nodes[low + 1])
+      ++low;
+  }
+  else
+  {
+    // Largest low with nodes[low] <= x.
+    low = 0;
+    high = last;
+    while (low < high)
+    {
+      mid = low + (high - low + 1) / 2;
+      if (axis->nodes[mid] <= x)
+        low = mid;
+      else
+        high = mid - 1;
+    }
+  }
+
+  *cell = low;
+  return AH5_TRUE;
+}
+
+
+char ahh5_smesh_locate(const ahh5_smesh_query_t *query, const float point[3], hsize_t ijk[3])
+{
+  return ahh5_saxis_locate(query->axes + 0, point[0], ijk + 0)
+         && ahh5_saxis_locate(query->axes + 1, point[1], ijk + 1)
+         && ahh5_saxis_locate(query->axes + 2, point[2], ijk + 2);
+}
+
+
+char ahh5_sgroup_box(const AH5_sgroup_t *group, hsize_t row, ahh5_sbox_t *box)
+{
+  const int *element;
+  int d, dim, nb_spanned = 0;
+
+  if (row >= group->dims[0] || (group->dims[1] != 3 && group->dims[1] != 6))
+    return AH5_FALSE;
+
+  // Node bounds.
+  element = group->elements + row * group->dims[1];
+  for (d = 0; d < 3; ++d)
+  {
+    if (element[d] < 0 || element[group->dims[1] == 6 ? d + 3 : d] < element[d])
+      return AH5_FALSE;
+    box->min[d] = (hsize_t) element[d];
+    box->max[d] = (hsize_t) element[group->dims[1] == 6 ? d + 3 : d];
+    nb_spanned += box->max[d] > box->min[d];
+  }
+
+  box->axis = -1;
+  switch (group->entitytype)
+  {
+  case AH5_GROUP_VOLUME:
+    dim = 3;
+    break;
+  case AH5_GROUP_FACE:
+    dim = 2;
+    break;
+  case AH5_GROUP_EDGE:
+    dim = 1;
+    break;
+  default:
+    return AH5_TRUE;
+  }
+  if (nb_spanned != dim)
+    return AH5_FALSE;
+
+  // The entities between the spanned node bounds.
+  for (d = 0; d < 3; ++d)
+    if (box->max[d] > box->min[d])
+    {
+      --box->max[d];
+      if (dim == 1)
+        box->axis = d;
+    }
+    else if (dim == 2)
+      box->axis = d;
+  return AH5_TRUE;
+}
+
+
+hsize_t ahh5_sbox_size(const ahh5_sbox_t *box)
+{
+  hsize_t size = 1;
+  int d;
+
+  for (d = 0; d < 3; ++d)
+  {
+    if (box->max[d] < box->min[d])
+      return 0;
+    size *= box->max[d] - box->min[d] + 1;
+  }
+  return size;
+}
+
+
+char ahh5_sbox_contains(const ahh5_sbox_t *box, int axis, const hsize_t ijk[3])
+{
+  return box->axis == axis
+         && box->min[0] <= ijk[0] && ijk[0] <= box->max[0]
+         && box->min[1] <= ijk[1] && ijk[1] <= box->max[1]
+         && box->min[2] <= ijk[2] && ijk[2] <= box->max[2];
+}
+
+
+char ahh5_sbox_iterate(const ahh5_sbox_t *box, ahh5_sbox_run_func_t func, void *user_data)
+{
+  hsize_t ijk[3], count;
+
+  if (ahh5_sbox_size(box) == 0)
+    return AH5_TRUE;
+
+  count = box->max[0] - box->min[0] + 1;
+  ijk[0] = box->min[0];
+  for (ijk[2] = box->min[2]; ijk[2] <= box->max[2]; ++ijk[2])
+    for (ijk[1] = box->min[1]; ijk[1] <= box->max[1]; ++ijk[1])
+      if (!func(ijk, count, box->axis, user_data))
+        return AH5_FALSE;
+
+  return AH5_TRUE;
+}
+
+
+char ahh5_sgroup_iterate(const AH5_sgroup_t *group, ahh5_sbox_run_func_t func, void *user_data)
+{
+  ahh5_sbox_t box;
+  hsize_t row;
+
+  for (row = 0; row < group->dims[0]; ++row)
+    if (ahh5_sgroup_box(group, row, &box) && !ahh5_sbox_iterate(&box, func, user_data))
+      return AH5_FALSE;
+
+  return AH5_TRUE;
+}
+
+
+// Order the boxes by kmin.
+static int ahh5_compare_sbox(const void *a, const void *b)
+{
+  const ahh5_sbox_t *box_a = (const ahh5_sbox_t *) a;
+  const ahh5_sbox_t *box_b = (const ahh5_sbox_t *) b;
+
+  if (box_a->min[2] < box_b->min[2])
+    return -1;
+  return box_a->min[2] > box_b->min[2];
+}
+
+
+char ahh5_init_sgroup_index(ahh5_sgroup_index_t *index, const AH5_sgroup_t *group)
+{
+  hsize_t row;
+
+  index->nb_boxes = 0;
+  index->boxes = NULL;
+  index->kmax_prefix = NULL;
+
+  if (group->dims[0] && group->dims[1] != 3 && group->dims[1] != 6)
+  {
+    AH5_log_error("Structured group index: unexpected elements shape.");
+    return AH5_FALSE;
+  }
+
+  index->boxes = (ahh5_sbox_t *) malloc((size_t) (group->dims[0] + 1) * sizeof(ahh5_sbox_t));
+  index->kmax_prefix = (hsize_t *) malloc((size_t) (group->dims[0] + 1) * sizeof(hsize_t));
+  if (index->boxes == NULL || index->kmax_prefix == NULL)
+  {
+    ahh5_free_sgroup_index(index);
+    return AH5_FALSE;
+  }
+
+  // The invalid boxes are dropped.
+  for (row = 0; row < group->dims[0]; ++row)
+    if (ahh5_sgroup_box(group, row, index->boxes + index->nb_boxes))
+      ++index->nb_boxes;
+
+  qsort(index->boxes, (size_t) index->nb_boxes, sizeof(ahh5_sbox_t), ahh5_compare_sbox);
+  for (row = 0; row < index->nb_boxes; ++row)
+  {
+    index->kmax_prefix[row] = index->boxes[row].max[2];
+    if (row > 0 && index->kmax_prefix[row - 1] > index->kmax_prefix[row])
+      index->kmax_prefix[row] = index->kmax_prefix[row - 1];
+  }
+
+  return AH5_TRUE;
+}
+
+
+void ahh5_free_sgroup_index(ahh5_sgroup_index_t *index)
+{
+  free(index->boxes);
+  free(index->kmax_prefix);
+  index->nb_boxes = 0;
+  index->boxes = NULL;
+  index->kmax_prefix = NULL;
+}
+
+
+char ahh5_sgroup_contains(const ahh5_sgroup_index_t *index, int axis, const hsize_t ijk[3])
+{
+  hsize_t low = 0, high = index->nb_boxes, mid;
+
+  // First box with kmin > k, the candidates are before.
+  while (low < high)
+  {
+    mid = low + (high - low) / 2;
+    if (index->boxes[mid].min[2] <= ijk[2])
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  // The prefix max stops the scan at the boxes ending below k.
+  while (low > 0 && index->kmax_prefix[low - 1] >= ijk[2])
+  {
+    --low;
+    if (ahh5_sbox_contains(index->boxes + low, axis, ijk))
+      return AH5_TRUE;
+  }
+
+  return AH5_FALSE;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file   ahh5_smesh_query.h
+ *
+ * @brief  Structured mesh queries on implicit indices: (i, j, k) to linear
+ * id, point location and group boxes iteration and membership.
+ *
+ * The group elements of a structured mesh are boxes of node indices (imin,
+ * jmin, kmin, imax, jmax, kmax, bounds included, or i, j, k for a node). The
+ * queries turn them into boxes of the group entities and never expand them
+ * into explicit lists.
+ *
+ * An entity is given by its indices (i, j, k): the node (i, j, k), the cell
+ * between the nodes i and i + 1, j and j + 1, k and k + 1, the face of
+ * normal x at the node plane i between the nodes j and j + 1, k and k + 1
+ * (the same for y and z), the edge along x between the nodes i and i + 1 at
+ * the node lines j and k (the same for y and z).
+ *
+ */
+
+#ifndef _AHH5_SMESH_QUERY_H_
+#define _AHH5_SMESH_QUERY_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An axis of a structured mesh.
+ *
+ * When the nodes are evenly spaced (uniform), a point is located in O(1),
+ * otherwise by a binary search.
+ */
+typedef struct _ahh5_saxis_query_t
+{
+  hsize_t         nb_nodes;
+  const float     *nodes;       // the nodes of the mesh axis (not copied)
+  char            uniform;
+  double          origin;
+  double          step;
+} ahh5_saxis_query_t;
+
+/**
+ * The axes of a structured mesh, it refers to the mesh nodes.
+ */
+typedef struct _ahh5_smesh_query_t
+{
+  ahh5_saxis_query_t axes[3];
+  hsize_t         nb_cells[3];
+} ahh5_smesh_query_t;
+
+/**
+ * A box of entity indices, bounds included.
+ *
+ * The axis is the normal of the faces or the direction of the edges (0, 1
+ * or 2 for x, y or z), -1 for the nodes and the cells.
+ */
+typedef struct _ahh5_sbox_t
+{
+  hsize_t         min[3];
+  hsize_t         max[3];
+  int             axis;
+} ahh5_sbox_t;
+
+/**
+ * Index of the boxes of a structured group for the membership tests.
+ *
+ * The boxes are sorted by kmin, kmax_prefix[b] is the largest kmax of the
+ * boxes up to b.
+ */
+typedef struct _ahh5_sgroup_index_t
+{
+  hsize_t         nb_boxes;
+  ahh5_sbox_t     *boxes;
+  hsize_t         *kmax_prefix;
+} ahh5_sgroup_index_t;
+
+/**
+ * Callback called by ahh5_sbox_iterate for each run of indices.
+ *
+ * @param[in] ijk the first indices of the run
+ * @param[in] count the number of indices of the run (along i)
+ * @param[in] axis the axis of the faces or edges of the run (-1 otherwise)
+ * @param[in] user_data the user data
+ *
+ * @return AH5_TRUE to continue, AH5_FALSE to stop the iteration.
+ */
+typedef char (*ahh5_sbox_run_func_t)(const hsize_t ijk[3], hsize_t count, int axis,
+                                     void *user_data);
+
+
+/**
+ * Initialize the queries of a structured mesh.
+ *
+ * The uniform spacing of each axis is detected.
+ *
+ * @param[out] query the queries
+ * @param[in] smesh the structured mesh (must outlive query)
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if an axis has less than two nodes
+ * or is not increasing).
+ */
+AHH5_PUBLIC char ahh5_init_smesh_query(ahh5_smesh_query_t *query, const AH5_smesh_t *smesh);
+
+/**
+ * Linear ids of the cells (i + nx * (j + ny * k), nx, ny the numbers of
+ * cells) and of the nodes (same with the numbers of nodes).
+ */
+AHH5_PUBLIC hsize_t ahh5_scell_id(const ahh5_smesh_query_t *query,
+                                  hsize_t i, hsize_t j, hsize_t k);
+AHH5_PUBLIC hsize_t ahh5_snode_id(const ahh5_smesh_query_t *query,
+                                  hsize_t i, hsize_t j, hsize_t k);
+AHH5_PUBLIC void ahh5_scell_ijk(const ahh5_smesh_query_t *query, hsize_t id, hsize_t ijk[3]);
+
+/**
+ * Locate a coordinate on an axis.
+ *
+ * The cell c holds [nodes[c], nodes[c + 1]), the last node is in the last
+ * cell.
+ *
+ * @return AH5_TRUE if the coordinate is on the axis.
+ */
+AHH5_PUBLIC char ahh5_saxis_locate(const ahh5_saxis_query_t *axis, float x, hsize_t *cell);
+
+/**
+ * Locate the cell holding a point.
+ *
+ * @return AH5_TRUE if the point is in the mesh.
+ */
+AHH5_PUBLIC char ahh5_smesh_locate(const ahh5_smesh_query_t *query, const float point[3],
+                                   hsize_t ijk[3]);
+
+/**
+ * Get the box of entities of an element of a structured group.
+ *
+ * The node bounds are turned into the entities of the group type: the cells
+ * of a volume box between its bounds, the faces of a box flat on one axis,
+ * the edges of a box flat on two axes. The other groups are nodes.
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if row is out of range or the box
+ * does not have the shape of the group type).
+ */
+AHH5_PUBLIC char ahh5_sgroup_box(const AH5_sgroup_t *group, hsize_t row, ahh5_sbox_t *box);
+
+/**
+ * Number of indices of a box.
+ */
+AHH5_PUBLIC hsize_t ahh5_sbox_size(const ahh5_sbox_t *box);
+
+/**
+ * Test if a box holds an entity (axis as in ahh5_sbox_t).
+ */
+AHH5_PUBLIC char ahh5_sbox_contains(const ahh5_sbox_t *box, int axis, const hsize_t ijk[3]);
+
+/**
+ * Iterate on the indices of a box, k then j major, by runs along i.
+ *
+ * @return AH5_TRUE if the whole box has been iterated.
+ */
+AHH5_PUBLIC char ahh5_sbox_iterate(const ahh5_sbox_t *box, ahh5_sbox_run_func_t func,
+                                   void *user_data);
+
+/**
+ * Iterate on the boxes of a structured group (see ahh5_sbox_iterate), an
+ * index of overlapping boxes is given several times.
+ */
+AHH5_PUBLIC char ahh5_sgroup_iterate(const AH5_sgroup_t *group, ahh5_sbox_run_func_t func,
+                                     void *user_data);
+
+/**
+ * Build the membership index of a structured group.
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_init_sgroup_index(ahh5_sgroup_index_t *index, const AH5_sgroup_t *group);
+AHH5_PUBLIC void ahh5_free_sgroup_index(ahh5_sgroup_index_t *index);
+
+/**
+ * Test if a group holds an entity (axis as in ahh5_sbox_t).
+ */
+AHH5_PUBLIC char ahh5_sgroup_contains(const ahh5_sgroup_index_t *index, int axis,
+                                      const hsize_t ijk[3]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_SMESH_QUERY_H_ */
@@ -0,0 +1,426 @@
+/**
+ * @file   ahh5_umesh_bvh.c
+ *
+ * @brief  Bounding volume hierarchy over unstructured mesh elements.
+ *
+ * The median splits give a balanced tree whose subtree sizes only depend on
+ * their number of elements, so the nodes are laid out depth first up front
+ * and the subtrees are built in parallel (OpenMP tasks).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_umesh_bvh.h"
+#include "ahh5_umesh_topo.h"
+
+
+#define AHH5_UBVH_LEAF_SIZE 4
+#define AHH5_UBVH_TASK_SIZE 4096
+#define AHH5_UBVH_STACK_SIZE 64
+#define AHH5_UBVH_TOLERANCE 1e-6
+
+
+// Build state shared by the subtrees.
+typedef struct _ahh5_ubvh_build_t
+{
+  const float     *boxes;
+  float           *centers;
+  int             *elements;
+  ahh5_ubvh_node_t *nodes;
+} ahh5_ubvh_build_t;
+
+
+// Compute the bounding box of an element, return AH5_FALSE if a node is out
+// of range.
+static char ahh5_element_box(const AH5_umesh_t *umesh, const int *nodes, int size, float *box)
+{
+  double xyz[3];
+  int j, d;
+
+  for (d = 0; d < 3; ++d)
+  {
+    box[d] = 0;
+    box[d + 3] = 0;
+  }
+  for (j = 0; j < size; ++j)
+  {
+    if (nodes[j] < 0 || (hsize_t) nodes[j] >= umesh->nb_nodes[AH5_UMESH_NODES_SIZE])
+      return AH5_FALSE;
+    ahh5_unode_coordinates(umesh, nodes[j], xyz);
+    for (d = 0; d < 3; ++d)
+    {
+      if (j == 0 || xyz[d] < box[d])
+        box[d] = (float) xyz[d];
+      if (j == 0 || xyz[d] > box[d + 3])
+        box[d + 3] = (float) xyz[d];
+    }
+  }
+  return AH5_TRUE;
+}
+
+
+// Number of nodes of the subtrees of n and n + 1 elements.
+static void ahh5_ubvh_sizes(hsize_t n, hsize_t *size_n, hsize_t *size_n1)
+{
+  hsize_t half, half1;
+
+  if (n + 1 <= AHH5_UBVH_LEAF_SIZE)
+  {
+    *size_n = 1;
+    *size_n1 = 1;
+    return;
+  }
+
+  // The left subtree holds n / 2 elements.
+  ahh5_ubvh_sizes(n / 2, &half, &half1);
+  if (n % 2 == 0)
+  {
+    *size_n = n <= AHH5_UBVH_LEAF_SIZE ? 1 : 1 + 2 * half;
+    *size_n1 = 1 + half + half1;
+  }
+  else
+  {
+    *size_n = n <= AHH5_UBVH_LEAF_SIZE ? 1 : 1 + half + half1;
+    *size_n1 = 1 + 2 * half1;
+  }
+}
+
+
+static hsize_t ahh5_ubvh_size(hsize_t n)
+{
+  hsize_t size_n, size_n1;
+
+  ahh5_ubvh_sizes(n, &size_n, &size_n1);
+  return size_n;
+}
+
+
+// Build the subtree of the elements [first, first + count) at node.
+static void ahh5_build_ubvh_node(const ahh5_ubvh_build_t *build, hsize_t node,
+                                 hsize_t first, hsize_t count)
+{
+  ahh5_ubvh_node_t *current = build->nodes + node, *left, *right;
+  float low[3], high[3], extent = -1;
+  const float *box, *center;
+  hsize_t i, half;
+  int d, axis = 0;
+
+  if (count <= AHH5_UBVH_LEAF_SIZE)
+  {
+    for (i = 0; i < count; ++i)
+    {
+      box = build->boxes + 6 * build->elements[first + i];
+      for (d = 0; d < 3; ++d)
+      {
+        if (i == 0 || box[d] < current->min[d])
+          current->min[d] = box[d];
+        if (i == 0 || box[d + 3] > current->max[d])
+          current->max[d] = box[d + 3];
+      }
+    }
+    current->first = first;
+    current->count = count;
+    return;
+  }
+
+  // Split along the largest extent of the centers.
+  for (i = 0; i < count; ++i)
+  {
+    center = build->centers + 3 * build->elements[first + i];
+    for (d = 0; d < 3; ++d)
+    {
+      if (i == 0 || center[d] < low[d])
+        low[d] = center[d];
+      if (i == 0 || center[d] > high[d])
+        high[d] = center[d];
+    }
+  }
+  for (d = 0; d < 3; ++d)
+    if (high[d] - low[d] > extent)
+    {
+      extent = high[d] - low[d];
+      axis = d;
+    }
+
+  half = count / 2;
+  ahh5_select_element(build->elements + first, count, half, build->centers, axis);
+  current->first = node + 1 + ahh5_ubvh_size(half);
+  current->count = 0;
+
+#ifdef _OPENMP
+#pragma omp task if(count > AHH5_UBVH_TASK_SIZE)
+#endif
+  ahh5_build_ubvh_node(build, node + 1, first, half);
+  ahh5_build_ubvh_node(build, current->first, first + half, count - half);
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+
+  left = build->nodes + node + 1;
+  right = build->nodes + current->first;
+  for (d = 0; d < 3; ++d)
+  {
+    current->min[d] = left->min[d] < right->min[d] ? left->min[d] : right->min[d];
+    current->max[d] = left->max[d] > right->max[d] ? left->max[d] : right->max[d];
+  }
+}
+
+
+char ahh5_build_ubvh(
+    ahh5_ubvh_t *bvh, const AH5_umesh_t *umesh, const AH5_uelement_index_t *index)
+{
+  ahh5_ubvh_build_t build;
+  hsize_t i, nb_elements = index->nb_elements;
+  char invalid = 0;
+  int d;
+
+  bvh->umesh = umesh;
+  bvh->index = index;
+  bvh->nb_elements = 0;
+  bvh->boxes = NULL;
+  bvh->elements = NULL;
+  bvh->nb_nodes = 0;
+  bvh->nodes = NULL;
+
+  if (nb_elements == 0)
+    return AH5_TRUE;
+
+  bvh->boxes = (float *) malloc((size_t) (6 * nb_elements) * sizeof(float));
+  bvh->elements = (int *) malloc((size_t) nb_elements * sizeof(int));
+  bvh->nb_nodes = ahh5_ubvh_size(nb_elements);
+  bvh->nodes = (ahh5_ubvh_node_t *) malloc((size_t) bvh->nb_nodes * sizeof(ahh5_ubvh_node_t));
+  build.centers = (float *) malloc((size_t) (3 * nb_elements) * sizeof(float));
+  if (!bvh->boxes || !bvh->elements || !bvh->nodes || !build.centers)
+  {
+    free(build.centers);
+    ahh5_free_ubvh(bvh);
+    return AH5_FALSE;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for private(d) reduction(|:invalid)
+#endif
+  for (i = 0; i < nb_elements; ++i)
+  {
+    invalid |= !ahh5_element_box(umesh, umesh->elementnodes + index->offsets[i],
+                                 (int) AH5_UELEMENT_SIZE(index, i), bvh->boxes + 6 * i);
+    for (d = 0; d < 3; ++d)
+      build.centers[3 * i + d] = (bvh->boxes[6 * i + d] + bvh->boxes[6 * i + d + 3]) / 2;
+    bvh->elements[i] = (int) i;
+  }
+  if (invalid)
+  {
+    AH5_log_error("Bounding volume hierarchy: a node is out of range.");
+    free(build.centers);
+    ahh5_free_ubvh(bvh);
+    return AH5_FALSE;
+  }
+
+  build.boxes = bvh->boxes;
+  build.elements = bvh->elements;
+  build.nodes = bvh->nodes;
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+  ahh5_build_ubvh_node(&build, 0, 0, nb_elements);
+
+  free(build.centers);
+  bvh->nb_elements = nb_elements;
+  return AH5_TRUE;
+}
+
+
+void ahh5_free_ubvh(ahh5_ubvh_t *bvh)
+{
+  if (bvh)
+  {
+    free(bvh->boxes);
+    free(bvh->elements);
+    free(bvh->nodes);
+    bvh->boxes = NULL;
+    bvh->elements = NULL;
+    bvh->nodes = NULL;
+    bvh->nb_elements = 0;
+    bvh->nb_nodes = 0;
+  }
+}
+
+
+static char ahh5_box_contains(const float *min, const float *max, const float point[3])
+{
+  return (min[0] <= point[0]) & (point[0] <= max[0])
+         & (min[1] <= point[1]) & (point[1] <= max[1])
+         & (min[2] <= point[2]) & (point[2] <= max[2]);
+}
+
+
+static char ahh5_box_overlaps(const float *min1, const float *max1,
+                              const float *min2, const float *max2)
+{
+  return (min1[0] <= max2[0]) & (min2[0] <= max1[0])
+         & (min1[1] <= max2[1]) & (min2[1] <= max1[1])
+         & (min1[2] <= max2[2]) & (min2[2] <= max1[2]);
+}
+
+
+// Determinant of the rows u, v and w.
+static double ahh5_det3(const double u[3], const double v[3], const double w[3])
+{
+  return u[0] * (v[1] * w[2] - v[2] * w[1])
+         - u[1] * (v[0] * w[2] - v[2] * w[0])
+         + u[2] * (v[0] * w[1] - v[1] * w[0]);
+}
+
+
+// Test if a point is in a tetrahedron with the barycentric coordinates.
+static char ahh5_tetra_contains(const double corners[4][3], const double point[3])
+{
+  double edges[3][3], to_point[3], lambda[3], volume, face[3][3];
+  int i, d;
+
+  for (i = 0; i < 3; ++i)
+    for (d = 0; d < 3; ++d)
+      edges[i][d] = corners[i + 1][d] - corners[0][d];
+  for (d = 0; d < 3; ++d)
+    to_point[d] = point[d] - corners[0][d];
+
+  volume = ahh5_det3(edges[0], edges[1], edges[2]);
+  if (volume == 0)
+    return AH5_FALSE;
+
+  for (i = 0; i < 3; ++i)
+  {
+    memcpy(face, edges, sizeof(edges));
+    memcpy(face[i], to_point, sizeof(to_point));
+    lambda[i] = ahh5_det3(face[0], face[1], face[2]) / volume;
+  }
+
+  return lambda[0] >= -AHH5_UBVH_TOLERANCE && lambda[1] >= -AHH5_UBVH_TOLERANCE
+         && lambda[2] >= -AHH5_UBVH_TOLERANCE
+         && 1 - lambda[0] - lambda[1] - lambda[2] >= -AHH5_UBVH_TOLERANCE;
+}
+
+
+// Test if a volume element holds a point.
+static char ahh5_element_contains(const ahh5_ubvh_t *bvh, int element, const float point[3])
+{
+  const int (*tetras)[4];
+  const int *nodes;
+  double corners[4][3], xyz[3];
+  int t, nb_tetras, c, d;
+
+  nb_tetras = ahh5_uelement_tetras(bvh->umesh->elementtypes[element], &tetras);
+  nodes = bvh->umesh->elementnodes + bvh->index->offsets[element];
+  for (d = 0; d < 3; ++d)
+    xyz[d] = point[d];
+
+  for (t = 0; t < nb_tetras; ++t)
+  {
+    for (c = 0; c < 4; ++c)
+      ahh5_unode_coordinates(bvh->umesh, nodes[tetras[t][c]], corners[c]);
+    if (ahh5_tetra_contains((const double (*)[3]) corners, xyz))
+      return AH5_TRUE;
+  }
+  return AH5_FALSE;
+}
+
+
+int ahh5_ubvh_locate(const ahh5_ubvh_t *bvh, const float point[3])
+{
+  hsize_t stack[AHH5_UBVH_STACK_SIZE], top = 0, node = 0, i;
+  const ahh5_ubvh_node_t *current;
+  const float *box;
+  int element;
+
+  if (bvh->nb_nodes == 0)
+    return -1;
+
+  for (;;)
+  {
+    current = bvh->nodes + node;
+    if (ahh5_box_contains(current->min, current->max, point))
+    {
+      if (current->count == 0)
+      {
+        stack[top++] = current->first;
+        ++node;
+        continue;
+      }
+
+      for (i = current->first; i < current->first + current->count; ++i)
+      {
+        element = bvh->elements[i];
+        box = bvh->boxes + 6 * element;
+        if (ahh5_box_contains(box, box + 3, point)
+            && ahh5_element_contains(bvh, element, point))
+          return element;
+      }
+    }
+
+    if (top == 0)
+      return -1;
+    node = stack[--top];
+  }
+}
+
+
+hsize_t ahh5_ubvh_locate_points(
+    const ahh5_ubvh_t *bvh, hsize_t nb_points, const float *points, int *elements)
+{
+  hsize_t i, nb_located = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256) reduction(+:nb_located)
+#endif
+  for (i = 0; i < nb_points; ++i)
+  {
+    elements[i] = ahh5_ubvh_locate(bvh, points + 3 * i);
+    if (elements[i] >= 0)
+      ++nb_located;
+  }
+
+  return nb_located;
+}
+
+
+char ahh5_ubvh_intersect(
+    const ahh5_ubvh_t *bvh, const float min[3], const float max[3],
+    ahh5_ubvh_func_t func, void *user_data)
+{
+  hsize_t stack[AHH5_UBVH_STACK_SIZE], top = 0, node = 0, i;
+  const ahh5_ubvh_node_t *current;
+  const float *box;
+
+  if (bvh->nb_nodes == 0)
+    return AH5_TRUE;
+
+  for (;;)
+  {
+    current = bvh->nodes + node;
+    if (ahh5_box_overlaps(current->min, current->max, min, max))
+    {
+      if (current->count == 0)
+      {
+        stack[top++] = current->first;
+        ++node;
+        continue;
+      }
+
+      for (i = current->first; i < current->first + current->count; ++i)
+      {
+        box = bvh->boxes + 6 * bvh->elements[i];
+        if (ahh5_box_overlaps(box, box + 3, min, max) && !func(bvh->elements[i], user_data))
+          return AH5_FALSE;
+      }
+    }
+
+    if (top == 0)
+      return AH5_TRUE;
+    node = stack[--top];
+  }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file   ahh5_umesh_bvh.h
+ *
+ * @brief  Bounding volume hierarchy over the elements of an unstructured
+ * mesh: point location and box queries.
+ *
+ * The hierarchy is built on the element bounding boxes by median splits
+ * along the largest extent of the element centers. A point is located in the
+ * volume elements only (tetra, pyra, penta and hexa, the quadratic elements
+ * through their corner nodes) by splitting them into tetrahedra, so warped
+ * faces are taken as two triangles. When built with OpenMP the build and the
+ * batch location are multithreaded.
+ *
+ */
+
+#ifndef _AHH5_UMESH_BVH_H_
+#define _AHH5_UMESH_BVH_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A node of the hierarchy.
+ *
+ * The left child of an inner node follows it, first is its right child. A
+ * leaf holds elements[first] up to elements[first + count - 1].
+ */
+typedef struct _ahh5_ubvh_node_t
+{
+  float           min[3];
+  float           max[3];
+  hsize_t         first;
+  hsize_t         count;         // 0 for an inner node
+} ahh5_ubvh_node_t;
+
+/**
+ * Bounding volume hierarchy of an unstructured mesh.
+ *
+ * boxes holds the bounding box of each element (min then max, in the
+ * element order), elements the elements in the leaves order.
+ */
+typedef struct _ahh5_ubvh_t
+{
+  const AH5_umesh_t *umesh;      // the mesh (not copied)
+  const AH5_uelement_index_t *index;
+  hsize_t         nb_elements;
+  float           *boxes;
+  int             *elements;
+  hsize_t         nb_nodes;
+  ahh5_ubvh_node_t *nodes;
+} ahh5_ubvh_t;
+
+/**
+ * Callback called by ahh5_ubvh_intersect for each element.
+ *
+ * @param[in] element the element
+ * @param[in] user_data the user data
+ *
+ * @return AH5_TRUE to continue, AH5_FALSE to stop the query.
+ */
+typedef char (*ahh5_ubvh_func_t)(int element, void *user_data);
+
+
+/**
+ * Build the hierarchy of an unstructured mesh.
+ *
+ * @param[out] bvh the hierarchy
+ * @param[in] umesh the unstructured mesh (must outlive bvh)
+ * @param[in] index the umesh element index (must outlive bvh)
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_build_ubvh(
+    ahh5_ubvh_t *bvh, const AH5_umesh_t *umesh, const AH5_uelement_index_t *index);
+AHH5_PUBLIC void ahh5_free_ubvh(ahh5_ubvh_t *bvh);
+
+/**
+ * Locate the volume element holding a point.
+ *
+ * A point on a shared face is given one of the elements.
+ *
+ * @param[in] bvh the hierarchy
+ * @param[in] point the point
+ *
+ * @return the element or -1 if the point is out of the volume elements.
+ */
+AHH5_PUBLIC int ahh5_ubvh_locate(const ahh5_ubvh_t *bvh, const float point[3]);
+
+/**
+ * Locate many points (see ahh5_ubvh_locate).
+ *
+ * @param[in] bvh the hierarchy
+ * @param[in] nb_points the number of points
+ * @param[in] points the points (x, y, z of each point)
+ * @param[out] elements the element of each point (-1 if not located)
+ *
+ * @return the number of located points.
+ */
+AHH5_PUBLIC hsize_t ahh5_ubvh_locate_points(
+    const ahh5_ubvh_t *bvh, hsize_t nb_points, const float *points, int *elements);
+
+/**
+ * Call func on the elements whose bounding box intersects a box.
+ *
+ * @param[in] bvh the hierarchy
+ * @param[in] min the lower corner of the box
+ * @param[in] max the upper corner of the box
+ * @param[in] func the callback
+ * @param[in] user_data the user data given to func
+ *
+ * @return AH5_TRUE if the query has not been stopped by func.
+ */
+AHH5_PUBLIC char ahh5_ubvh_intersect(
+    const ahh5_ubvh_t *bvh, const float min[3], const float max[3],
+    ahh5_ubvh_func_t func, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_UMESH_BVH_H_ */
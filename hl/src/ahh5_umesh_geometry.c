@@ -0,0 +1,476 @@
+/**
+ * @file   ahh5_umesh_geometry.c
+ *
+ * @brief  Geometry of the elements of an unstructured mesh.
+ *
+ * The elements are sorted by shape and processed by batches of one shape:
+ * the corner coordinates of a batch are gathered into one array per axis and
+ * corner, so the shape kernels run the same straight line code along the
+ * batch (vectorizable loops). The batches are shared among the threads
+ * (OpenMP).
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_umesh_geometry.h"
+#include "ahh5_umesh_topo.h"
+
+
+#define AHH5_UGEOMETRY_BATCH 64
+#define AHH5_MAX_CORNERS 8
+#define AHH5_SQRT2 1.4142135623730951
+#define AHH5_2_SQRT3 1.1547005383792515  // 2 / sqrt(3)
+
+
+// Shapes of the elements.
+typedef enum _ahh5_shape_t
+{
+  AHH5_SHAPE_NODE         = 0,
+  AHH5_SHAPE_BAR          = 1,
+  AHH5_SHAPE_TRI          = 2,
+  AHH5_SHAPE_QUAD         = 3,
+  AHH5_SHAPE_TETRA        = 4,
+  AHH5_SHAPE_PYRA         = 5,
+  AHH5_SHAPE_PENTA        = 6,
+  AHH5_SHAPE_HEXA         = 7,
+  AHH5_NB_SHAPES          = 8
+} ahh5_shape_t;
+
+static const int ahh5_shape_corners[AHH5_NB_SHAPES] = {1, 2, 3, 4, 4, 5, 6, 8};
+
+
+// Corners of the volume shapes and their three neighbours (right handed).
+// The apex of a pyra has four neighbours, only its base corners are taken.
+static const int ahh5_tetra_corners[4][4] = {
+  {0, 1, 2, 3}, {1, 2, 0, 3}, {2, 0, 1, 3}, {3, 0, 2, 1}};
+static const int ahh5_pyra_corners[4][4] = {
+  {0, 1, 3, 4}, {1, 2, 0, 4}, {2, 3, 1, 4}, {3, 0, 2, 4}};
+static const int ahh5_penta_corners[6][4] = {
+  {0, 1, 2, 3}, {1, 2, 0, 4}, {2, 0, 1, 5}, {3, 5, 4, 0}, {4, 3, 5, 1}, {5, 4, 3, 2}};
+static const int ahh5_hexa_corners[8][4] = {
+  {0, 1, 3, 4}, {1, 2, 0, 5}, {2, 3, 1, 6}, {3, 0, 2, 7},
+  {4, 7, 5, 0}, {5, 4, 6, 1}, {6, 5, 7, 2}, {7, 6, 4, 3}};
+
+
+// A batch of elements of one shape.
+typedef struct _ahh5_ubatch_t
+{
+  hsize_t         count;
+  double          xyz[3][AHH5_MAX_CORNERS][AHH5_UGEOMETRY_BATCH];
+  double          measure[AHH5_UGEOMETRY_BATCH];
+  double          normal[3][AHH5_UGEOMETRY_BATCH];
+  double          quality[AHH5_UGEOMETRY_BATCH];
+} ahh5_ubatch_t;
+
+
+// Return the shape of an element type (-1 if invalid).
+static int ahh5_element_shape(char type)
+{
+  switch (type)
+  {
+    case AH5_UELE_NODE:
+      return AHH5_SHAPE_NODE;
+    case AH5_UELE_BAR2:
+    case AH5_UELE_BAR3:
+      return AHH5_SHAPE_BAR;
+    case AH5_UELE_TRI3:
+    case AH5_UELE_TRI6:
+      return AHH5_SHAPE_TRI;
+    case AH5_UELE_QUAD4:
+    case AH5_UELE_QUAD8:
+    case AH5_UELE_QUAD9:
+      return AHH5_SHAPE_QUAD;
+    case AH5_UELE_TETRA4:
+    case AH5_UELE_TETRA10:
+      return AHH5_SHAPE_TETRA;
+    case AH5_UELE_PYRA5:
+      return AHH5_SHAPE_PYRA;
+    case AH5_UELE_PENTA6:
+      return AHH5_SHAPE_PENTA;
+    case AH5_UELE_HEXA8:
+    case AH5_UELE_HEXA20:
+      return AHH5_SHAPE_HEXA;
+    default:
+      return -1;
+  }
+}
+
+
+static double ahh5_dot(const double u[3], const double v[3])
+{
+  return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+}
+
+
+static void ahh5_cross(const double u[3], const double v[3], double w[3])
+{
+  w[0] = u[1] * v[2] - u[2] * v[1];
+  w[1] = u[2] * v[0] - u[0] * v[2];
+  w[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+
+// Edge from the corner a to the corner c of the element b of a batch.
+static void ahh5_batch_edge(const ahh5_ubatch_t *batch, hsize_t b, int a, int c, double edge[3])
+{
+  edge[0] = batch->xyz[0][c][b] - batch->xyz[0][a][b];
+  edge[1] = batch->xyz[1][c][b] - batch->xyz[1][a][b];
+  edge[2] = batch->xyz[2][c][b] - batch->xyz[2][a][b];
+}
+
+
+// Set the unit normal of the element b from a normal of given length.
+static void ahh5_batch_normal(ahh5_ubatch_t *batch, hsize_t b, const double normal[3],
+                              double length)
+{
+  int d;
+
+  for (d = 0; d < 3; ++d)
+    batch->normal[d][b] = length > 0 ? normal[d] / length : 0;
+}
+
+
+static void ahh5_bar_geometry(ahh5_ubatch_t *batch)
+{
+  double edge[3];
+  hsize_t b;
+
+  for (b = 0; b < batch->count; ++b)
+  {
+    ahh5_batch_edge(batch, b, 0, 1, edge);
+    batch->measure[b] = sqrt(ahh5_dot(edge, edge));
+    batch->quality[b] = batch->measure[b] > 0;
+  }
+}
+
+
+static void ahh5_tri_geometry(ahh5_ubatch_t *batch)
+{
+  double edges[3][3], sides[3], normal[3], length, largest, product;
+  hsize_t b;
+  int c;
+
+  for (b = 0; b < batch->count; ++b)
+  {
+    for (c = 0; c < 3; ++c)
+    {
+      ahh5_batch_edge(batch, b, c, (c + 1) % 3, edges[c]);
+      sides[c] = sqrt(ahh5_dot(edges[c], edges[c]));
+    }
+    ahh5_cross(edges[0], edges[1], normal);
+    length = sqrt(ahh5_dot(normal, normal));
+    batch->measure[b] = length / 2;
+    ahh5_batch_normal(batch, b, normal, length);
+
+    // The Jacobian is the same at each corner, the corner sides change.
+    largest = 0;
+    for (c = 0; c < 3; ++c)
+    {
+      product = sides[c] * sides[(c + 2) % 3];
+      if (product > largest)
+        largest = product;
+    }
+    batch->quality[b] = largest > 0 ? AHH5_2_SQRT3 * length / largest : 0;
+  }
+}
+
+
+static void ahh5_quad_geometry(ahh5_ubatch_t *batch)
+{
+  double diagonal1[3], diagonal2[3], normal[3], edge1[3], edge2[3], corner[3];
+  double length, lengths, jacobian;
+  hsize_t b;
+  int c;
+
+  for (b = 0; b < batch->count; ++b)
+  {
+    // The vector area is half the cross product of the diagonals.
+    ahh5_batch_edge(batch, b, 0, 2, diagonal1);
+    ahh5_batch_edge(batch, b, 1, 3, diagonal2);
+    ahh5_cross(diagonal1, diagonal2, normal);
+    length = sqrt(ahh5_dot(normal, normal));
+    batch->measure[b] = length / 2;
+    ahh5_batch_normal(batch, b, normal, length);
+
+    // The corners Jacobian along the element normal.
+    batch->quality[b] = 1;
+    for (c = 0; c < 4; ++c)
+    {
+      ahh5_batch_edge(batch, b, c, (c + 1) % 4, edge1);
+      ahh5_batch_edge(batch, b, c, (c + 3) % 4, edge2);
+      ahh5_cross(edge1, edge2, corner);
+      lengths = length * sqrt(ahh5_dot(edge1, edge1) * ahh5_dot(edge2, edge2));
+      jacobian = lengths > 0 ? ahh5_dot(corner, normal) / lengths : 0;
+      if (jacobian < batch->quality[b])
+        batch->quality[b] = jacobian;
+    }
+  }
+}
+
+
+// Measure a volume shape from its tetrahedra and rate its corners, the
+// loops along the batch are the inner ones.
+static void ahh5_volume_geometry(ahh5_ubatch_t *batch, const int (*tetras)[4], int nb_tetras,
+                                 const int (*corners)[4], int nb_corners, double scale)
+{
+  double edges[3][3], normal[3], lengths, jacobian;
+  hsize_t b;
+  int t, c, i;
+
+  for (t = 0; t < nb_tetras; ++t)
+    for (b = 0; b < batch->count; ++b)
+    {
+      for (i = 0; i < 3; ++i)
+        ahh5_batch_edge(batch, b, tetras[t][0], tetras[t][i + 1], edges[i]);
+      ahh5_cross(edges[1], edges[2], normal);
+      batch->measure[b] += ahh5_dot(edges[0], normal) / 6;
+    }
+
+  for (c = 0; c < nb_corners; ++c)
+    for (b = 0; b < batch->count; ++b)
+    {
+      lengths = 1;
+      for (i = 0; i < 3; ++i)
+      {
+        ahh5_batch_edge(batch, b, corners[c][0], corners[c][i + 1], edges[i]);
+        lengths *= ahh5_dot(edges[i], edges[i]);
+      }
+      lengths = sqrt(lengths);
+      ahh5_cross(edges[1], edges[2], normal);
+      jacobian = lengths > 0 ? scale * ahh5_dot(edges[0], normal) / lengths : 0;
+      if (jacobian < batch->quality[b])
+        batch->quality[b] = jacobian;
+    }
+}
+
+
+// Gather the corners of the elements of a batch, return AH5_FALSE if a node
+// is out of range.
+static char ahh5_gather_batch(ahh5_ubatch_t *batch, const AH5_umesh_t *umesh,
+                              const AH5_uelement_index_t *index, const int *elements,
+                              int nb_corners)
+{
+  const int *nodes;
+  double xyz[3];
+  hsize_t b;
+  int c, d;
+
+  for (b = 0; b < batch->count; ++b)
+  {
+    nodes = umesh->elementnodes + index->offsets[elements[b]];
+    for (c = 0; c < nb_corners; ++c)
+    {
+      if (nodes[c] < 0 || (hsize_t) nodes[c] >= umesh->nb_nodes[AH5_UMESH_NODES_SIZE])
+        return AH5_FALSE;
+      ahh5_unode_coordinates(umesh, nodes[c], xyz);
+      for (d = 0; d < 3; ++d)
+        batch->xyz[d][c][b] = xyz[d];
+    }
+
+    batch->measure[b] = 0;
+    batch->quality[b] = 1;
+    for (d = 0; d < 3; ++d)
+      batch->normal[d][b] = 0;
+  }
+  return AH5_TRUE;
+}
+
+
+// Compute and store the geometry of a batch of one shape.
+static char ahh5_batch_geometry(ahh5_ubatch_t *batch, const AH5_umesh_t *umesh,
+                                const AH5_uelement_index_t *index, const int *elements,
+                                int shape, ahh5_ugeometry_t *geometry)
+{
+  int nb_corners = ahh5_shape_corners[shape], nb_tetras, c, d;
+  const int (*tetras)[4];
+  double center;
+  hsize_t b;
+
+  if (!ahh5_gather_batch(batch, umesh, index, elements, nb_corners))
+    return AH5_FALSE;
+
+  switch (shape)
+  {
+    case AHH5_SHAPE_BAR:
+      ahh5_bar_geometry(batch);
+      break;
+    case AHH5_SHAPE_TRI:
+      ahh5_tri_geometry(batch);
+      break;
+    case AHH5_SHAPE_QUAD:
+      ahh5_quad_geometry(batch);
+      break;
+    case AHH5_SHAPE_TETRA:
+      nb_tetras = ahh5_uelement_tetras(AH5_UELE_TETRA4, &tetras);
+      ahh5_volume_geometry(batch, tetras, nb_tetras, ahh5_tetra_corners, 4, AHH5_SQRT2);
+      break;
+    case AHH5_SHAPE_PYRA:
+      nb_tetras = ahh5_uelement_tetras(AH5_UELE_PYRA5, &tetras);
+      ahh5_volume_geometry(batch, tetras, nb_tetras, ahh5_pyra_corners, 4, AHH5_SQRT2);
+      break;
+    case AHH5_SHAPE_PENTA:
+      nb_tetras = ahh5_uelement_tetras(AH5_UELE_PENTA6, &tetras);
+      ahh5_volume_geometry(batch, tetras, nb_tetras, ahh5_penta_corners, 6, AHH5_2_SQRT3);
+      break;
+    case AHH5_SHAPE_HEXA:
+      nb_tetras = ahh5_uelement_tetras(AH5_UELE_HEXA8, &tetras);
+      ahh5_volume_geometry(batch, tetras, nb_tetras, ahh5_hexa_corners, 8, 1);
+      break;
+    default:
+      break;
+  }
+
+  for (b = 0; b < batch->count; ++b)
+  {
+    for (d = 0; d < 3; ++d)
+    {
+      center = 0;
+      for (c = 0; c < nb_corners; ++c)
+        center += batch->xyz[d][c][b];
+      geometry->centroids[3 * elements[b] + d] = (float) (center / nb_corners);
+      geometry->normals[3 * elements[b] + d] = (float) batch->normal[d][b];
+    }
+    geometry->measures[elements[b]] = (float) batch->measure[b];
+    if (batch->quality[b] > 1)
+      batch->quality[b] = 1;
+    else if (batch->quality[b] < -1)
+      batch->quality[b] = -1;
+    geometry->qualities[elements[b]] = (float) batch->quality[b];
+  }
+  return AH5_TRUE;
+}
+
+
+char ahh5_build_ugeometry(
+    ahh5_ugeometry_t *geometry, const AH5_umesh_t *umesh, const AH5_uelement_index_t *index)
+{
+  hsize_t nb_elements = index->nb_elements, starts[AHH5_NB_SHAPES + 1], i, k, nb_batches = 0;
+  hsize_t *batches;
+  int *elements, *shapes, shape;
+  char invalid = 0;
+
+  geometry->nb_elements = 0;
+  geometry->centroids = NULL;
+  geometry->measures = NULL;
+  geometry->normals = NULL;
+  geometry->qualities = NULL;
+
+  if (nb_elements == 0)
+    return AH5_TRUE;
+
+  for (shape = 0; shape <= AHH5_NB_SHAPES; ++shape)
+    starts[shape] = 0;
+  shapes = (int *) malloc((size_t) nb_elements * sizeof(int));
+  if (!shapes)
+    return AH5_FALSE;
+  for (i = 0; i < nb_elements; ++i)
+  {
+    shapes[i] = ahh5_element_shape(umesh->elementtypes[i]);
+    if (shapes[i] < 0)
+    {
+      AH5_log_error("Element geometry: invalid element type %d.", umesh->elementtypes[i]);
+      free(shapes);
+      return AH5_FALSE;
+    }
+    starts[shapes[i] + 1]++;
+  }
+
+  // Sort the elements by shape and cut batches of one shape.
+  for (shape = 0; shape < AHH5_NB_SHAPES; ++shape)
+  {
+    nb_batches += (starts[shape + 1] + AHH5_UGEOMETRY_BATCH - 1) / AHH5_UGEOMETRY_BATCH;
+    starts[shape + 1] += starts[shape];
+  }
+
+  geometry->centroids = (float *) malloc((size_t) (3 * nb_elements) * sizeof(float));
+  geometry->measures = (float *) malloc((size_t) nb_elements * sizeof(float));
+  geometry->normals = (float *) malloc((size_t) (3 * nb_elements) * sizeof(float));
+  geometry->qualities = (float *) malloc((size_t) nb_elements * sizeof(float));
+  elements = (int *) malloc((size_t) nb_elements * sizeof(int));
+  batches = (hsize_t *) malloc((size_t) (nb_batches + 1) * sizeof(hsize_t));
+  if (!geometry->centroids || !geometry->measures || !geometry->normals
+      || !geometry->qualities || !elements || !batches)
+  {
+    free(shapes);
+    free(elements);
+    free(batches);
+    ahh5_free_ugeometry(geometry);
+    return AH5_FALSE;
+  }
+
+  nb_batches = 0;
+  for (shape = 0; shape < AHH5_NB_SHAPES; ++shape)
+    for (i = starts[shape]; i < starts[shape + 1]; i += AHH5_UGEOMETRY_BATCH)
+      batches[nb_batches++] = i;
+  batches[nb_batches] = nb_elements;
+  for (i = 0; i < nb_elements; ++i)
+    elements[starts[shapes[i]]++] = (int) i;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(|:invalid)
+#endif
+  {
+    ahh5_ubatch_t batch;
+    const int *first;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (k = 0; k < nb_batches; ++k)
+    {
+      first = elements + batches[k];
+      batch.count = batches[k + 1] - batches[k];
+      invalid |= !ahh5_batch_geometry(&batch, umesh, index, first, shapes[*first], geometry);
+    }
+  }
+
+  free(shapes);
+  free(elements);
+  free(batches);
+  if (invalid)
+  {
+    AH5_log_error("Element geometry: a node is out of range.");
+    ahh5_free_ugeometry(geometry);
+    return AH5_FALSE;
+  }
+  geometry->nb_elements = nb_elements;
+  return AH5_TRUE;
+}
+
+
+void ahh5_free_ugeometry(ahh5_ugeometry_t *geometry)
+{
+  if (geometry)
+  {
+    free(geometry->centroids);
+    free(geometry->measures);
+    free(geometry->normals);
+    free(geometry->qualities);
+    geometry->centroids = NULL;
+    geometry->measures = NULL;
+    geometry->normals = NULL;
+    geometry->qualities = NULL;
+    geometry->nb_elements = 0;
+  }
+}
+
+
+hsize_t ahh5_ugeometry_below(
+    const ahh5_ugeometry_t *geometry, float threshold, int *elements)
+{
+  hsize_t nb_below = 0, i;
+
+  for (i = 0; i < geometry->nb_elements; ++i)
+    if (geometry->qualities[i] < threshold)
+    {
+      if (elements)
+        elements[nb_below] = (int) i;
+      ++nb_below;
+    }
+  return nb_below;
+}
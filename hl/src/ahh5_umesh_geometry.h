@@ -0,0 +1,79 @@
+/**
+ * @file   ahh5_umesh_geometry.h
+ *
+ * @brief  Geometry of the elements of an unstructured mesh: centroids,
+ * measures, normals and Jacobian quality.
+ *
+ * The elements are taken through their corner nodes, so the quadratic
+ * elements (bar3, tri6, quad8, quad9, tetra10 and hexa20) are measured as
+ * their straight sided linear elements. When built with OpenMP the elements
+ * are processed in parallel.
+ *
+ */
+
+#ifndef _AHH5_UMESH_GEOMETRY_H_
+#define _AHH5_UMESH_GEOMETRY_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Geometry of the elements of an unstructured mesh (in the element order).
+ *
+ * The centroid is the mean of the corner nodes. The measure is 0 for a
+ * node, the length of a bar, the area of a surface element and the signed
+ * volume of a volume element (negative if inverted). The normal is the unit
+ * normal of a surface element following its node order (0 otherwise).
+ *
+ * The quality is the smallest scaled Jacobian of the corners: the
+ * determinant of the corner edges over the product of their lengths,
+ * scaled to 1 for the regular shapes (equilateral triangles, squares and
+ * right angles), bounded to [-1, 1]. It is negative for an inverted volume
+ * element or a non convex quad, and 0 for a degenerate element. The quality
+ * of a node or a valid bar is 1.
+ */
+typedef struct _ahh5_ugeometry_t
+{
+  hsize_t         nb_elements;
+  float           *centroids;    // x, y, z of each element
+  float           *measures;
+  float           *normals;      // x, y, z of each element
+  float           *qualities;
+} ahh5_ugeometry_t;
+
+
+/**
+ * Compute the geometry of all the elements of an unstructured mesh.
+ *
+ * @param[out] geometry the geometry, free it with ahh5_free_ugeometry
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_build_ugeometry(
+    ahh5_ugeometry_t *geometry, const AH5_umesh_t *umesh, const AH5_uelement_index_t *index);
+AHH5_PUBLIC void ahh5_free_ugeometry(ahh5_ugeometry_t *geometry);
+
+/**
+ * Find the elements of quality lower than a threshold.
+ *
+ * @param[in] geometry the geometry
+ * @param[in] threshold the threshold
+ * @param[out] elements the elements in increasing order (can be NULL)
+ *
+ * @return the number of elements.
+ */
+AHH5_PUBLIC hsize_t ahh5_ugeometry_below(
+    const ahh5_ugeometry_t *geometry, float threshold, int *elements);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_UMESH_GEOMETRY_H_ */
@@ -0,0 +1,414 @@
+/**
+ * @file   ahh5_umesh_partition.c
+ *
+ * @brief  Partition of an unstructured mesh into sub-meshes with ghosts.
+ *
+ * The ghosts are found through the node to element adjacency. Each thread
+ * extracts whole parts with its own marks on the global elements and nodes,
+ * the marks are cleared from the part lists so they are reset in the part
+ * size.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_umesh_partition.h"
+#include "ahh5_umesh_topo.h"
+
+
+#define AHH5_RCB_TASK_SIZE 4096
+
+
+// Bisect the elements among the parts [first_part, first_part + nb_parts).
+static void ahh5_bisect(const float *centers, int *elements, hsize_t count,
+                        int first_part, int nb_parts, int *parts)
+{
+  float low[3], high[3], extent = -1;
+  const float *center;
+  hsize_t i, nb_left;
+  int d, axis = 0, left_parts;
+
+  if (nb_parts == 1 || count == 0)
+  {
+    for (i = 0; i < count; ++i)
+      parts[elements[i]] = first_part;
+    return;
+  }
+
+  for (i = 0; i < count; ++i)
+  {
+    center = centers + 3 * elements[i];
+    for (d = 0; d < 3; ++d)
+    {
+      if (i == 0 || center[d] < low[d])
+        low[d] = center[d];
+      if (i == 0 || center[d] > high[d])
+        high[d] = center[d];
+    }
+  }
+  for (d = 0; d < 3; ++d)
+    if (high[d] - low[d] > extent)
+    {
+      extent = high[d] - low[d];
+      axis = d;
+    }
+
+  // The sides get elements in proportion of their parts.
+  left_parts = nb_parts / 2;
+  nb_left = count * (hsize_t) left_parts / (hsize_t) nb_parts;
+  if (nb_left > 0 && nb_left < count)
+    ahh5_select_element(elements, count, nb_left, centers, axis);
+
+#ifdef _OPENMP
+#pragma omp task if(count > AHH5_RCB_TASK_SIZE)
+#endif
+  ahh5_bisect(centers, elements, nb_left, first_part, left_parts, parts);
+  ahh5_bisect(centers, elements + nb_left, count - nb_left, first_part + left_parts,
+              nb_parts - left_parts, parts);
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+}
+
+
+char ahh5_umesh_rcb_partition(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int nb_parts, int *parts)
+{
+  hsize_t i;
+  float *centers;
+  int *elements, d;
+  double center[3];
+  char invalid = 0;
+
+  if (nb_parts < 1)
+    return AH5_FALSE;
+
+  centers = (float *) malloc((size_t) (3 * index->nb_elements + 1) * sizeof(float));
+  elements = (int *) malloc((size_t) (index->nb_elements + 1) * sizeof(int));
+  if (!centers || !elements)
+  {
+    free(centers);
+    free(elements);
+    return AH5_FALSE;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for private(d, center) reduction(|:invalid)
+#endif
+  for (i = 0; i < index->nb_elements; ++i)
+  {
+    if (!ahh5_uelement_center(umesh, index, i, center))
+      invalid = 1;
+    for (d = 0; d < 3; ++d)
+      centers[3 * i + d] = (float) center[d];
+    elements[i] = (int) i;
+  }
+
+  if (invalid)
+    AH5_log_error("Recursive coordinate bisection: a node is out of range.");
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+    ahh5_bisect(centers, elements, index->nb_elements, 0, nb_parts, parts);
+  }
+
+  free(centers);
+  free(elements);
+  return !invalid;
+}
+
+
+static int ahh5_compare_ints(const void *a, const void *b)
+{
+  return (*(const int *) a > *(const int *) b) - (*(const int *) a < *(const int *) b);
+}
+
+
+// Position of value in sorted, -1 if absent.
+static int ahh5_find_int(const int *sorted, hsize_t size, int value)
+{
+  hsize_t low = 0, high = size, mid;
+
+  while (low < high)
+  {
+    mid = low + (high - low) / 2;
+    if (sorted[mid] < value)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low < size && sorted[low] == value ? (int) low : -1;
+}
+
+
+// Walk the elements sharing a node with the owned ones, the ones of other
+// parts with the mark from are given the mark to, return their number.
+static hsize_t ahh5_mark_ghosts(const AH5_umesh_t *umesh, const AH5_uelement_index_t *index,
+                                const ahh5_node_elements_t *adjacency, const int *parts,
+                                int part, const int *owned, hsize_t nb_owned,
+                                char *marks, char from, char to, int *ghosts)
+{
+  hsize_t i, j, k, nb_ghosts = 0;
+  int element;
+
+  for (i = 0; i < nb_owned; ++i)
+    for (j = index->offsets[owned[i]]; j < index->offsets[owned[i] + 1]; ++j)
+      for (k = adjacency->offsets[umesh->elementnodes[j]];
+           k < adjacency->offsets[umesh->elementnodes[j] + 1]; ++k)
+      {
+        element = adjacency->elements[k];
+        if (parts[element] != part && marks[element] == from)
+        {
+          marks[element] = to;
+          if (ghosts)
+            ghosts[nb_ghosts] = element;
+          ++nb_ghosts;
+        }
+      }
+  return nb_ghosts;
+}
+
+
+// Build one part, marks and nodes are zero on entry and on exit.
+static char ahh5_extract_part(const AH5_umesh_t *umesh, const AH5_uelement_index_t *index,
+                              const ahh5_node_elements_t *adjacency, const int *parts,
+                              int part, const int *owned, hsize_t nb_owned,
+                              char *marks, int *nodes, ahh5_umesh_part_t *sub)
+{
+  hsize_t nb_ghosts, nb_local, nb_elementnodes = 0, nb_local_nodes = 0, i, j, g, size;
+  hsize_t nb_groups = 0;
+  const AH5_ugroup_t *group;
+  AH5_ugroup_t *sub_group;
+  double xyz[3];
+  int *local, item;
+  char success = AH5_TRUE;
+
+  // Ghosts in two passes: count then collect.
+  nb_ghosts = ahh5_mark_ghosts(umesh, index, adjacency, parts, part, owned, nb_owned,
+                               marks, 0, 1, NULL);
+  nb_local = nb_owned + nb_ghosts;
+  sub->global_elements = (int *) malloc((size_t) (nb_local + 1) * sizeof(int));
+  sub->ghost_owners = (int *) malloc((size_t) (nb_ghosts + 1) * sizeof(int));
+  if (!sub->global_elements || !sub->ghost_owners)
+  {
+    ahh5_mark_ghosts(umesh, index, adjacency, parts, part, owned, nb_owned, marks, 1, 0, NULL);
+    return AH5_FALSE;
+  }
+  memcpy(sub->global_elements, owned, (size_t) nb_owned * sizeof(int));
+  ahh5_mark_ghosts(umesh, index, adjacency, parts, part, owned, nb_owned, marks, 1, 0,
+                   sub->global_elements + nb_owned);
+  qsort(sub->global_elements + nb_owned, (size_t) nb_ghosts, sizeof(int), ahh5_compare_ints);
+  for (i = 0; i < nb_ghosts; ++i)
+    sub->ghost_owners[i] = parts[sub->global_elements[nb_owned + i]];
+  sub->nb_owned = nb_owned;
+  sub->nb_ghosts = nb_ghosts;
+
+  // The nodes of the local elements in increasing order.
+  for (i = 0; i < nb_local; ++i)
+    for (j = index->offsets[sub->global_elements[i]];
+         j < index->offsets[sub->global_elements[i] + 1]; ++j)
+    {
+      ++nb_elementnodes;
+      if (nodes[umesh->elementnodes[j]] == 0)
+      {
+        nodes[umesh->elementnodes[j]] = -1;
+        ++nb_local_nodes;
+      }
+    }
+  sub->global_nodes = (int *) malloc((size_t) (nb_local_nodes + 1) * sizeof(int));
+  for (i = 0, size = 0; i < nb_local; ++i)
+    for (j = index->offsets[sub->global_elements[i]];
+         j < index->offsets[sub->global_elements[i] + 1]; ++j)
+      if (nodes[umesh->elementnodes[j]] == -1)
+      {
+        nodes[umesh->elementnodes[j]] = 0;
+        if (sub->global_nodes)
+          sub->global_nodes[size++] = umesh->elementnodes[j];
+      }
+  if (!sub->global_nodes)
+    return AH5_FALSE;
+  qsort(sub->global_nodes, (size_t) nb_local_nodes, sizeof(int), ahh5_compare_ints);
+  for (i = 0; i < nb_local_nodes; ++i)
+    nodes[sub->global_nodes[i]] = (int) i + 1;
+
+  if (!AH5_init_umesh(&sub->umesh, nb_elementnodes, nb_local, nb_local_nodes,
+                      nb_local ? umesh->nb_groups : 0, 0, 0))
+    success = AH5_FALSE;
+
+  if (success && nb_local)
+  {
+    for (i = 0; i < nb_local_nodes; ++i)
+    {
+      ahh5_unode_coordinates(umesh, sub->global_nodes[i], xyz);
+      for (j = 0; j < 3; ++j)
+        sub->umesh.nodes[3 * i + j] = (float) xyz[j];
+    }
+
+    for (i = 0, size = 0; i < nb_local; ++i)
+    {
+      sub->umesh.elementtypes[i] = umesh->elementtypes[sub->global_elements[i]];
+      for (j = index->offsets[sub->global_elements[i]];
+           j < index->offsets[sub->global_elements[i] + 1]; ++j)
+        sub->umesh.elementnodes[size++] = nodes[umesh->elementnodes[j]] - 1;
+    }
+
+    // The node groups on the part nodes, the other ones on the owned elements.
+    for (g = 0; g < umesh->nb_groups && success; ++g)
+    {
+      group = umesh->groups + g;
+      local = (int *) malloc((size_t) (group->nb_groupelts + 1) * sizeof(int));
+      if (!local)
+      {
+        success = AH5_FALSE;
+        break;
+      }
+      for (i = 0, size = 0; i < group->nb_groupelts; ++i)
+      {
+        item = group->groupelts[i];
+        if (group->entitytype == AH5_GROUP_NODE)
+          item = item >= 0 && (hsize_t) item < umesh->nb_nodes[AH5_UMESH_NODES_SIZE] ?
+                 nodes[item] - 1 : -1;
+        else
+          item = ahh5_find_int(owned, nb_owned, item);
+        if (item >= 0)
+          local[size++] = item;
+      }
+
+      // The empty groups are dropped (they can not be written).
+      sub_group = sub->umesh.groups + nb_groups;
+      if (size && AH5_init_ugroup(sub_group, group->path, size, group->entitytype))
+      {
+        memcpy(sub_group->groupelts, local, (size_t) size * sizeof(int));
+        ++nb_groups;
+      }
+      else if (size)
+        success = AH5_FALSE;
+      free(local);
+    }
+    sub->umesh.nb_groups = nb_groups;
+  }
+
+  for (i = 0; i < nb_local_nodes; ++i)
+    nodes[sub->global_nodes[i]] = 0;
+  return success;
+}
+
+
+char ahh5_umesh_split(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, const int *parts,
+    int nb_parts, ahh5_umesh_part_t *subs)
+{
+  ahh5_node_elements_t adjacency;
+  hsize_t i, *offsets, *fill;
+  int *owned, p;
+  char success = AH5_TRUE;
+
+  for (p = 0; p < nb_parts; ++p)
+  {
+    memset(subs + p, 0, sizeof(ahh5_umesh_part_t));
+    AH5_init_umesh(&subs[p].umesh, 0, 0, 0, 0, 0, 0);
+  }
+
+  for (i = 0; i < index->nb_elements; ++i)
+    if (parts[i] < 0 || parts[i] >= nb_parts)
+    {
+      AH5_log_error("Unstructured mesh split: an element part is out of range.");
+      return AH5_FALSE;
+    }
+
+  if (!ahh5_build_node_elements(umesh, index, &adjacency))
+    return AH5_FALSE;
+
+  // The owned elements of each part in increasing order.
+  offsets = (hsize_t *) calloc((size_t) nb_parts + 1, sizeof(hsize_t));
+  fill = (hsize_t *) malloc(((size_t) nb_parts + 1) * sizeof(hsize_t));
+  owned = (int *) malloc((size_t) (index->nb_elements + 1) * sizeof(int));
+  if (!offsets || !fill || !owned)
+  {
+    free(offsets);
+    free(fill);
+    free(owned);
+    ahh5_free_node_elements(&adjacency);
+    return AH5_FALSE;
+  }
+  for (i = 0; i < index->nb_elements; ++i)
+    offsets[parts[i] + 1]++;
+  for (p = 0; p < nb_parts; ++p)
+    offsets[p + 1] += offsets[p];
+  memcpy(fill, offsets, (size_t) nb_parts * sizeof(hsize_t));
+  for (i = 0; i < index->nb_elements; ++i)
+    owned[fill[parts[i]]++] = (int) i;
+  free(fill);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    char *marks = (char *) calloc((size_t) (index->nb_elements + 1), sizeof(char));
+    int *nodes = (int *) calloc((size_t) (adjacency.nb_nodes + 1), sizeof(int));
+    int q;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic) reduction(&:success)
+#endif
+    for (q = 0; q < nb_parts; ++q)
+      success &= marks && nodes
+                 && ahh5_extract_part(umesh, index, &adjacency, parts, q, owned + offsets[q],
+                                      offsets[q + 1] - offsets[q], marks, nodes, subs + q);
+
+    free(marks);
+    free(nodes);
+  }
+
+  free(offsets);
+  free(owned);
+  ahh5_free_node_elements(&adjacency);
+
+  if (!success)
+    for (p = 0; p < nb_parts; ++p)
+      ahh5_free_umesh_part(subs + p);
+  return success;
+}
+
+
+void ahh5_free_umesh_part(ahh5_umesh_part_t *sub)
+{
+  if (sub)
+  {
+    AH5_free_umesh(&sub->umesh);
+    free(sub->global_elements);
+    free(sub->ghost_owners);
+    free(sub->global_nodes);
+    sub->global_elements = NULL;
+    sub->ghost_owners = NULL;
+    sub->global_nodes = NULL;
+    sub->nb_owned = 0;
+    sub->nb_ghosts = 0;
+  }
+}
+
+
+int ahh5_part_local_element(const ahh5_umesh_part_t *sub, int element)
+{
+  int local = ahh5_find_int(sub->global_elements, sub->nb_owned, element);
+
+  if (local < 0)
+  {
+    local = ahh5_find_int(sub->global_elements + sub->nb_owned, sub->nb_ghosts, element);
+    if (local >= 0)
+      local += (int) sub->nb_owned;
+  }
+  return local;
+}
+
+
+int ahh5_part_local_node(const ahh5_umesh_part_t *sub, int node)
+{
+  return ahh5_find_int(sub->global_nodes, sub->umesh.nb_nodes[AH5_UMESH_NODES_SIZE], node);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file   ahh5_umesh_partition.h
+ *
+ * @brief  Partition of an unstructured mesh into sub-meshes with one layer of
+ * ghost elements.
+ *
+ * The elements are partitioned by recursive coordinate bisection (RCB) of
+ * their centers. Each part is an AH5_umesh_t ready to be written with its
+ * owned elements first then its ghost elements (the elements of the other
+ * parts sharing a node with an owned element), and the maps from its local
+ * numbers to the global ones. When built with OpenMP the bisections and the
+ * parts extraction are multithreaded.
+ *
+ */
+
+#ifndef _AHH5_UMESH_PARTITION_H_
+#define _AHH5_UMESH_PARTITION_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A part of an unstructured mesh.
+ *
+ * The local element i is the global element global_elements[i], the owned
+ * elements come first (nb_owned) in increasing global order, then the ghosts
+ * (nb_ghosts) in increasing global order, the ghost i belongs to the part
+ * ghost_owners[i]. The local node i is the global node global_nodes[i] in
+ * increasing global order.
+ *
+ * The groups are restricted to the owned elements (element groups) or to the
+ * nodes of the part (node groups) and keep their paths, the empty ones are
+ * dropped. The groups of groups and the selector on mesh tables are not
+ * carried.
+ */
+typedef struct _ahh5_umesh_part_t
+{
+  AH5_umesh_t     umesh;
+  hsize_t         nb_owned;
+  hsize_t         nb_ghosts;
+  int             *global_elements;
+  int             *ghost_owners;
+  int             *global_nodes;
+} ahh5_umesh_part_t;
+
+
+/**
+ * Partition the elements by recursive coordinate bisection.
+ *
+ * The element sets are split at the median of their centers along their
+ * largest extent, with sizes following the number of parts on each side.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[in] nb_parts the number of parts
+ * @param[out] parts the part of each element
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_umesh_rcb_partition(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int nb_parts, int *parts);
+
+/**
+ * Build the parts of a partitioned mesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[in] parts the part of each element (from 0 to nb_parts - 1)
+ * @param[in] nb_parts the number of parts
+ * @param[out] subs the nb_parts parts, free them with ahh5_free_umesh_part
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_umesh_split(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, const int *parts,
+    int nb_parts, ahh5_umesh_part_t *subs);
+AHH5_PUBLIC void ahh5_free_umesh_part(ahh5_umesh_part_t *sub);
+
+/**
+ * Local number of a global element or node in a part.
+ *
+ * @return the local number or -1 if not in the part.
+ */
+AHH5_PUBLIC int ahh5_part_local_element(const ahh5_umesh_part_t *sub, int element);
+AHH5_PUBLIC int ahh5_part_local_node(const ahh5_umesh_part_t *sub, int node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_UMESH_PARTITION_H_ */
@@ -0,0 +1,520 @@
+/**
+ * @file   ahh5_umesh_reorder.c
+ *
+ * @brief  Locality renumbering of unstructured meshes.
+ *
+ * The Morton keys interleave 21 bits per axis of the coordinates scaled to
+ * the bounding box. The reverse Cuthill-McKee ordering runs on the node to
+ * element adjacency and sorts the neighbours by their number of elements.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_umesh_reorder.h"
+#include "ahh5_umesh_topo.h"
+
+
+#define AHH5_MORTON_BITS 21
+
+
+// A sort key of an item (node or element), ties broken by the item.
+typedef struct _ahh5_sort_key_t
+{
+  hsize_t         key;
+  int             item;
+} ahh5_sort_key_t;
+
+
+static int ahh5_compare_sort_keys(const void *a, const void *b)
+{
+  const ahh5_sort_key_t *key_a = (const ahh5_sort_key_t *) a;
+  const ahh5_sort_key_t *key_b = (const ahh5_sort_key_t *) b;
+
+  if (key_a->key != key_b->key)
+    return key_a->key < key_b->key ? -1 : 1;
+  return (key_a->item > key_b->item) - (key_a->item < key_b->item);
+}
+
+
+// Sort the keys and write the new number of each item.
+static void ahh5_sort_permutation(ahh5_sort_key_t *keys, hsize_t nb_keys, int *perm)
+{
+  hsize_t i;
+
+  qsort(keys, (size_t) nb_keys, sizeof(ahh5_sort_key_t), ahh5_compare_sort_keys);
+  for (i = 0; i < nb_keys; ++i)
+    perm[keys[i].item] = (int) i;
+}
+
+
+// Get the lower corner and the scale to the Morton grid of the nodes.
+static void ahh5_morton_frame(const AH5_umesh_t *umesh, double low[3], double scale[3])
+{
+  double high[3], xyz[3];
+  hsize_t i;
+  int d;
+
+  for (i = 0; i < umesh->nb_nodes[AH5_UMESH_NODES_SIZE]; ++i)
+  {
+    ahh5_unode_coordinates(umesh, (int) i, xyz);
+    for (d = 0; d < 3; ++d)
+    {
+      if (i == 0 || xyz[d] < low[d])
+        low[d] = xyz[d];
+      if (i == 0 || xyz[d] > high[d])
+        high[d] = xyz[d];
+    }
+  }
+
+  for (d = 0; d < 3; ++d)
+  {
+    if (umesh->nb_nodes[AH5_UMESH_NODES_SIZE] == 0)
+      low[d] = high[d] = 0;
+    scale[d] = high[d] > low[d] ? ((1 << AHH5_MORTON_BITS) - 1) / (high[d] - low[d]) : 0;
+  }
+}
+
+
+static hsize_t ahh5_morton_key(const double xyz[3], const double low[3], const double scale[3])
+{
+  hsize_t key = 0, cell;
+  double scaled;
+  int d, b;
+
+  for (d = 0; d < 3; ++d)
+  {
+    scaled = (xyz[d] - low[d]) * scale[d];
+    cell = scaled <= 0 ? 0 : (hsize_t) scaled;
+    if (cell >= (hsize_t) 1 << AHH5_MORTON_BITS)
+      cell = ((hsize_t) 1 << AHH5_MORTON_BITS) - 1;
+    for (b = 0; b < AHH5_MORTON_BITS; ++b)
+      key |= ((cell >> b) & 1) << (3 * b + d);
+  }
+  return key;
+}
+
+
+char ahh5_umesh_morton_nodes(const AH5_umesh_t *umesh, int *node_perm)
+{
+  ahh5_sort_key_t *keys;
+  double low[3], scale[3], xyz[3];
+  hsize_t i, nb_nodes = umesh->nb_nodes[AH5_UMESH_NODES_SIZE];
+
+  keys = (ahh5_sort_key_t *) malloc((size_t) (nb_nodes + 1) * sizeof(ahh5_sort_key_t));
+  if (!keys)
+    return AH5_FALSE;
+
+  ahh5_morton_frame(umesh, low, scale);
+#ifdef _OPENMP
+#pragma omp parallel for private(xyz)
+#endif
+  for (i = 0; i < nb_nodes; ++i)
+  {
+    ahh5_unode_coordinates(umesh, (int) i, xyz);
+    keys[i].key = ahh5_morton_key(xyz, low, scale);
+    keys[i].item = (int) i;
+  }
+
+  ahh5_sort_permutation(keys, nb_nodes, node_perm);
+  free(keys);
+  return AH5_TRUE;
+}
+
+
+char ahh5_umesh_morton_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int *element_perm)
+{
+  ahh5_sort_key_t *keys;
+  double low[3], scale[3], center[3];
+  hsize_t i;
+  char invalid = 0;
+
+  keys = (ahh5_sort_key_t *) malloc((size_t) (index->nb_elements + 1) * sizeof(ahh5_sort_key_t));
+  if (!keys)
+    return AH5_FALSE;
+
+  ahh5_morton_frame(umesh, low, scale);
+#ifdef _OPENMP
+#pragma omp parallel for private(center) reduction(|:invalid)
+#endif
+  for (i = 0; i < index->nb_elements; ++i)
+  {
+    if (!ahh5_uelement_center(umesh, index, i, center))
+      invalid = 1;
+    keys[i].key = ahh5_morton_key(center, low, scale);
+    keys[i].item = (int) i;
+  }
+
+  if (invalid)
+  {
+    AH5_log_error("Morton elements ordering: a node is out of range.");
+    free(keys);
+    return AH5_FALSE;
+  }
+
+  ahh5_sort_permutation(keys, index->nb_elements, element_perm);
+  free(keys);
+  return AH5_TRUE;
+}
+
+
+// Insertion sort of a few nodes by number of elements, then by node.
+static void ahh5_sort_by_degree(int *nodes, hsize_t nb_nodes, const hsize_t *offsets)
+{
+  hsize_t i, j, degree;
+  int node;
+
+  for (i = 1; i < nb_nodes; ++i)
+  {
+    node = nodes[i];
+    degree = offsets[node + 1] - offsets[node];
+    for (j = i; j > 0; --j)
+    {
+      if (offsets[nodes[j - 1] + 1] - offsets[nodes[j - 1]] < degree
+          || (offsets[nodes[j - 1] + 1] - offsets[nodes[j - 1]] == degree && nodes[j - 1] < node))
+        break;
+      nodes[j] = nodes[j - 1];
+    }
+    nodes[j] = node;
+  }
+}
+
+
+char ahh5_umesh_rcm_nodes(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int *node_perm)
+{
+  ahh5_node_elements_t adjacency;
+  ahh5_sort_key_t *starts;
+  hsize_t nb_nodes, head = 0, tail = 0, next_start = 0, i, j, first;
+  int *order, node, element;
+  char *visited;
+
+  if (!ahh5_build_node_elements(umesh, index, &adjacency))
+    return AH5_FALSE;
+
+  nb_nodes = adjacency.nb_nodes;
+  order = (int *) malloc((size_t) (nb_nodes + 1) * sizeof(int));
+  visited = (char *) calloc((size_t) (nb_nodes + 1), sizeof(char));
+  starts = (ahh5_sort_key_t *) malloc((size_t) (nb_nodes + 1) * sizeof(ahh5_sort_key_t));
+  if (!order || !visited || !starts)
+  {
+    free(order);
+    free(visited);
+    free(starts);
+    ahh5_free_node_elements(&adjacency);
+    return AH5_FALSE;
+  }
+
+  // The starts of the connected parts, fewest elements first.
+  for (i = 0; i < nb_nodes; ++i)
+  {
+    starts[i].key = adjacency.offsets[i + 1] - adjacency.offsets[i];
+    starts[i].item = (int) i;
+  }
+  qsort(starts, (size_t) nb_nodes, sizeof(ahh5_sort_key_t), ahh5_compare_sort_keys);
+
+  while (tail < nb_nodes)
+  {
+    if (head == tail)
+    {
+      while (visited[starts[next_start].item])
+        ++next_start;
+      visited[starts[next_start].item] = 1;
+      order[tail++] = starts[next_start].item;
+    }
+
+    // Breadth first, the new neighbours by increasing number of elements.
+    node = order[head++];
+    first = tail;
+    for (i = adjacency.offsets[node]; i < adjacency.offsets[node + 1]; ++i)
+    {
+      element = adjacency.elements[i];
+      for (j = index->offsets[element]; j < index->offsets[element + 1]; ++j)
+        if (!visited[umesh->elementnodes[j]])
+        {
+          visited[umesh->elementnodes[j]] = 1;
+          order[tail++] = umesh->elementnodes[j];
+        }
+    }
+    ahh5_sort_by_degree(order + first, tail - first, adjacency.offsets);
+  }
+
+  for (i = 0; i < nb_nodes; ++i)
+    node_perm[order[i]] = (int) (nb_nodes - 1 - i);
+
+  free(order);
+  free(visited);
+  free(starts);
+  ahh5_free_node_elements(&adjacency);
+  return AH5_TRUE;
+}
+
+
+char ahh5_umesh_sort_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, const int *node_perm,
+    int *element_perm)
+{
+  ahh5_sort_key_t *keys;
+  hsize_t i, j, node;
+
+  keys = (ahh5_sort_key_t *) malloc((size_t) (index->nb_elements + 1) * sizeof(ahh5_sort_key_t));
+  if (!keys)
+    return AH5_FALSE;
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j, node)
+#endif
+  for (i = 0; i < index->nb_elements; ++i)
+  {
+    keys[i].key = (hsize_t) -1;
+    keys[i].item = (int) i;
+    for (j = index->offsets[i]; j < index->offsets[i + 1]; ++j)
+    {
+      node = (hsize_t) (node_perm ? node_perm[umesh->elementnodes[j]] : umesh->elementnodes[j]);
+      if (node < keys[i].key)
+        keys[i].key = node;
+    }
+  }
+
+  ahh5_sort_permutation(keys, index->nb_elements, element_perm);
+  free(keys);
+  return AH5_TRUE;
+}
+
+
+// Test if perm is a permutation of [0, size).
+static char ahh5_valid_permutation(const int *perm, hsize_t size)
+{
+  char *seen, valid = AH5_TRUE;
+  hsize_t i;
+
+  if (!perm)
+    return AH5_TRUE;
+
+  seen = (char *) calloc((size_t) (size + 1), sizeof(char));
+  if (!seen)
+    return AH5_FALSE;
+  for (i = 0; i < size && valid; ++i)
+  {
+    if (perm[i] < 0 || (hsize_t) perm[i] >= size || seen[perm[i]])
+      valid = AH5_FALSE;
+    else
+      seen[perm[i]] = 1;
+  }
+  free(seen);
+  return valid;
+}
+
+
+// Renumber a list of items, the out of range items are kept.
+static void ahh5_renumber_items(int *items, hsize_t nb_items, hsize_t stride,
+                                const int *perm, hsize_t size)
+{
+  hsize_t i;
+
+  if (!perm)
+    return;
+  for (i = 0; i < nb_items; ++i)
+    if (items[i * stride] >= 0 && (hsize_t) items[i * stride] < size)
+      items[i * stride] = perm[items[i * stride]];
+}
+
+
+char ahh5_umesh_renumber(
+    AH5_umesh_t *umesh, const int *node_perm, const int *element_perm)
+{
+  AH5_uelement_index_t index;
+  hsize_t nb_nodes = umesh->nb_nodes[AH5_UMESH_NODES_SIZE], dim = umesh->nb_nodes[1];
+  hsize_t i, j, *offsets;
+  float *nodes = NULL;
+  int *elementnodes = NULL;
+  const int *group_perm;
+  char *elementtypes = NULL;
+  AH5_usom_table_t *som;
+
+  if (!AH5_init_uelement_index(&index, umesh))
+    return AH5_FALSE;
+  if (!ahh5_valid_permutation(node_perm, nb_nodes)
+      || !ahh5_valid_permutation(element_perm, index.nb_elements))
+  {
+    AH5_log_error("Unstructured mesh renumbering: invalid permutation.");
+    AH5_free_uelement_index(&index);
+    return AH5_FALSE;
+  }
+
+  // The new arrays first so that a failure leaves umesh unchanged.
+  offsets = (hsize_t *) malloc((size_t) (index.nb_elements + 1) * sizeof(hsize_t));
+  elementnodes = (int *) AH5_alloc((size_t) (umesh->nb_elementnodes + 1) * sizeof(int));
+  elementtypes = (char *) AH5_alloc((size_t) (umesh->nb_elementtypes + 1) * sizeof(char));
+  if (node_perm)
+    nodes = (float *) AH5_alloc((size_t) (nb_nodes * dim + 1) * sizeof(float));
+  if (!offsets || !elementnodes || !elementtypes || (node_perm && !nodes))
+  {
+    free(offsets);
+    AH5_release(elementnodes);
+    AH5_release(elementtypes);
+    AH5_release(nodes);
+    AH5_free_uelement_index(&index);
+    return AH5_FALSE;
+  }
+
+  if (node_perm)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (i = 0; i < nb_nodes; ++i)
+      memcpy(nodes + node_perm[i] * dim, umesh->nodes + i * dim, (size_t) dim * sizeof(float));
+    AH5_release(umesh->nodes);
+    umesh->nodes = nodes;
+  }
+
+  // The new element offsets from the sizes at their new place.
+  offsets[0] = 0;
+  for (i = 0; i < index.nb_elements; ++i)
+    offsets[(element_perm ? element_perm[i] : (int) i) + 1] = AH5_UELEMENT_SIZE(&index, i);
+  for (i = 0; i < index.nb_elements; ++i)
+    offsets[i + 1] += offsets[i];
+
+#ifdef _OPENMP
+#pragma omp parallel for private(j)
+#endif
+  for (i = 0; i < index.nb_elements; ++i)
+  {
+    hsize_t to = offsets[element_perm ? element_perm[i] : (int) i];
+
+    elementtypes[element_perm ? element_perm[i] : (int) i] = umesh->elementtypes[i];
+    for (j = index.offsets[i]; j < index.offsets[i + 1]; ++j)
+      elementnodes[to++] = node_perm ? node_perm[umesh->elementnodes[j]] : umesh->elementnodes[j];
+  }
+  AH5_release(umesh->elementnodes);
+  AH5_release(umesh->elementtypes);
+  umesh->elementnodes = elementnodes;
+  umesh->elementtypes = elementtypes;
+
+  // The node groups follow the nodes, the other ones the elements.
+  for (i = 0; i < umesh->nb_groups; ++i)
+  {
+    group_perm = umesh->groups[i].entitytype == AH5_GROUP_NODE ? node_perm : element_perm;
+    ahh5_renumber_items(umesh->groups[i].groupelts, umesh->groups[i].nb_groupelts, 1, group_perm,
+                        umesh->groups[i].entitytype == AH5_GROUP_NODE ? nb_nodes : index.nb_elements);
+  }
+
+  for (i = 0; i < umesh->nb_som_tables; ++i)
+  {
+    som = umesh->som_tables + i;
+    if (som->type == SOM_POINT_IN_ELEMENT)
+      ahh5_renumber_items(som->data.pie.indices, som->data.pie.nb_points, 1, element_perm,
+                          index.nb_elements);
+    else if (som->type == SOM_EDGE || som->type == SOM_FACE)
+      ahh5_renumber_items(som->data.ef.items, som->data.ef.dims[0], 2, element_perm,
+                          index.nb_elements);
+  }
+
+  free(offsets);
+  AH5_free_uelement_index(&index);
+  return AH5_TRUE;
+}
+
+
+void ahh5_renumber_mlk_instance(
+    AH5_mlk_instance_t *mlk_instance, const char *mesh_path, const int *node_perm,
+    hsize_t nb_nodes, const int *element_perm, hsize_t nb_elements)
+{
+  const char *meshes[2];
+  const int *perm;
+  hsize_t nb_pairs, stride, step, side;
+
+  perm = mlk_instance->type == MSHLNK_NODE ? node_perm : element_perm;
+  if (!perm || !mlk_instance->data || !mesh_path)
+    return;
+
+  // One side per row (2 x n) or one pair per row (n x 2).
+  if (mlk_instance->dims[0] == 2 && mlk_instance->dims[1] != 2)
+  {
+    nb_pairs = mlk_instance->dims[1];
+    stride = 1;
+    step = nb_pairs;
+  }
+  else if (mlk_instance->dims[1] == 2)
+  {
+    nb_pairs = mlk_instance->dims[0];
+    stride = 2;
+    step = 1;
+  }
+  else
+    return;
+
+  meshes[0] = mlk_instance->mesh1;
+  meshes[1] = mlk_instance->mesh2;
+  for (side = 0; side < 2; ++side)
+    if (meshes[side] && strcmp(meshes[side], mesh_path) == 0)
+      ahh5_renumber_items(mlk_instance->data + side * step, nb_pairs, stride, perm,
+                          mlk_instance->type == MSHLNK_NODE ? nb_nodes : nb_elements);
+}
+
+
+// Compute the permutations of an unstructured mesh.
+static char ahh5_umesh_ordering(const AH5_umesh_t *umesh, ahh5_reorder_t ordering,
+                                int *node_perm, int *element_perm)
+{
+  AH5_uelement_index_t index;
+  char success;
+
+  if (!AH5_init_uelement_index(&index, umesh))
+    return AH5_FALSE;
+
+  if (ordering == AHH5_REORDER_MORTON)
+    success = ahh5_umesh_morton_nodes(umesh, node_perm)
+              && ahh5_umesh_morton_elements(umesh, &index, element_perm);
+  else if (ordering == AHH5_REORDER_RCM)
+    success = ahh5_umesh_rcm_nodes(umesh, &index, node_perm)
+              && ahh5_umesh_sort_elements(umesh, &index, node_perm, element_perm);
+  else
+    success = AH5_FALSE;
+
+  AH5_free_uelement_index(&index);
+  return success;
+}
+
+
+char ahh5_reorder_mesh(AH5_mesh_t *mesh, ahh5_reorder_t ordering)
+{
+  AH5_msh_instance_t *instance;
+  AH5_umesh_t *umesh;
+  int *node_perm, *element_perm;
+  hsize_t g, m, l, k;
+  char success = AH5_TRUE;
+
+  for (g = 0; g < mesh->nb_groups && success; ++g)
+    for (m = 0; m < mesh->groups[g].nb_msh_instances && success; ++m)
+    {
+      instance = mesh->groups[g].msh_instances + m;
+      if (instance->type != MSH_UNSTRUCTURED)
+        continue;
+
+      umesh = &instance->data.unstructured;
+      node_perm = (int *) malloc((size_t) (umesh->nb_nodes[AH5_UMESH_NODES_SIZE] + 1) * sizeof(int));
+      element_perm = (int *) malloc((size_t) (umesh->nb_elementtypes + 1) * sizeof(int));
+      success = node_perm && element_perm
+                && ahh5_umesh_ordering(umesh, ordering, node_perm, element_perm)
+                && ahh5_umesh_renumber(umesh, node_perm, element_perm);
+
+      // The links may be in any group.
+      if (success)
+        for (l = 0; l < mesh->nb_groups; ++l)
+          for (k = 0; k < mesh->groups[l].nb_mlk_instances; ++k)
+            ahh5_renumber_mlk_instance(mesh->groups[l].mlk_instances + k, instance->path,
+                                       node_perm, umesh->nb_nodes[AH5_UMESH_NODES_SIZE],
+                                       element_perm, umesh->nb_elementtypes);
+
+      free(node_perm);
+      free(element_perm);
+    }
+
+  return success;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file   ahh5_umesh_reorder.h
+ *
+ * @brief  Locality renumbering of the nodes and the elements of unstructured
+ * meshes (Morton curve or reverse Cuthill-McKee).
+ *
+ * A permutation gives the new number of each old node (or element):
+ * new = perm[old]. The renumbering applies it to the nodes, the element
+ * nodes and types, the groups, the selector on mesh tables and the mesh
+ * links. A renumbered mesh is saved with the usual writers, for instance
+ * AH5_write_mesh into a new file.
+ *
+ */
+
+#ifndef _AHH5_UMESH_REORDER_H_
+#define _AHH5_UMESH_REORDER_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Orderings of ahh5_reorder_mesh.
+ */
+typedef enum _ahh5_reorder_t
+{
+  AHH5_REORDER_MORTON     = 1,  // nodes and elements along a Morton curve
+  AHH5_REORDER_RCM        = 2   // nodes by reverse Cuthill-McKee, elements by nodes
+} ahh5_reorder_t;
+
+
+/**
+ * Order the nodes along a Morton (Z-order) curve of their bounding box.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[out] node_perm the new number of each node (nb_nodes[0] values)
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_umesh_morton_nodes(const AH5_umesh_t *umesh, int *node_perm);
+
+/**
+ * Order the elements along a Morton curve of their centers.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[out] element_perm the new number of each element
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_umesh_morton_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int *element_perm);
+
+/**
+ * Order the nodes by reverse Cuthill-McKee on the graph of the nodes sharing
+ * an element, each connected part starting from a node of fewest elements.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[out] node_perm the new number of each node
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_umesh_rcm_nodes(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, int *node_perm);
+
+/**
+ * Order the elements by their smallest (new) node.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[in] node_perm the new number of each node (NULL for the current)
+ * @param[out] element_perm the new number of each element
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_umesh_sort_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, const int *node_perm,
+    int *element_perm);
+
+/**
+ * Renumber the nodes and the elements of an unstructured mesh, the groups
+ * and the selector on mesh tables follow.
+ *
+ * The element index of umesh must be rebuilt after the renumbering.
+ *
+ * @param[in,out] umesh the unstructured mesh
+ * @param[in] node_perm the new number of each node (NULL to keep them)
+ * @param[in] element_perm the new number of each element (NULL to keep them)
+ *
+ * @return AH5_TRUE on success, AH5_FALSE (umesh unchanged) if a permutation
+ * is invalid.
+ */
+AHH5_PUBLIC char ahh5_umesh_renumber(
+    AH5_umesh_t *umesh, const int *node_perm, const int *element_perm);
+
+/**
+ * Renumber the side(s) of a mesh link on a renumbered mesh.
+ *
+ * The link holds one pair per row (n x 2) or one side per row (2 x n), the
+ * out of range items are kept.
+ *
+ * @param[in,out] mlk_instance the mesh link
+ * @param[in] mesh_path the path of the renumbered mesh
+ * @param[in] node_perm the new number of each node (NULL to keep them)
+ * @param[in] nb_nodes the number of nodes of the mesh
+ * @param[in] element_perm the new number of each element (NULL to keep them)
+ * @param[in] nb_elements the number of elements of the mesh
+ */
+AHH5_PUBLIC void ahh5_renumber_mlk_instance(
+    AH5_mlk_instance_t *mlk_instance, const char *mesh_path, const int *node_perm,
+    hsize_t nb_nodes, const int *element_perm, hsize_t nb_elements);
+
+/**
+ * Renumber all the unstructured meshes of a mesh category and their links.
+ *
+ * @param[in,out] mesh the mesh category
+ * @param[in] ordering the ordering
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_reorder_mesh(AH5_mesh_t *mesh, ahh5_reorder_t ordering);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_UMESH_REORDER_H_ */
@@ -0,0 +1,826 @@
+/**
+ * @file   ahh5_umesh_topo.c
+ *
+ * @brief  Unstructured mesh topology builders.
+ *
+ * The edges and faces are numbered by hashing their canonical key (the
+ * sorted corner nodes), the numbering follows the first occurrence order.
+ * The keys are split by hash into buckets that are numbered in parallel, one
+ * prefix pass over the first occurrences then gives the final numbers.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <ah5_log.h>
+
+#include "ahh5_umesh_topo.h"
+
+
+#define AHH5_KEY_WIDTH 4
+#define AHH5_NO_KEY ((hsize_t) -1)
+#define AHH5_KEY_BUCKETS 64
+
+
+// Local edges (pair of corners) of the elements shapes.
+static const int ahh5_bar_edges[1][2] = {{0, 1}};
+static const int ahh5_tri_edges[3][2] = {{0, 1}, {1, 2}, {2, 0}};
+static const int ahh5_quad_edges[4][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 0}};
+static const int ahh5_tetra_edges[6][2] = {{0, 1}, {1, 2}, {2, 0}, {0, 3}, {1, 3}, {2, 3}};
+static const int ahh5_pyra_edges[8][2] = {
+  {0, 1}, {1, 2}, {2, 3}, {3, 0}, {0, 4}, {1, 4}, {2, 4}, {3, 4}};
+static const int ahh5_penta_edges[9][2] = {
+  {0, 1}, {1, 2}, {2, 0}, {3, 4}, {4, 5}, {5, 3}, {0, 3}, {1, 4}, {2, 5}};
+static const int ahh5_hexa_edges[12][2] = {
+  {0, 1}, {1, 2}, {2, 3}, {3, 0}, {4, 5}, {5, 6}, {6, 7}, {7, 4},
+  {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+
+// Local faces ({size, corners...}) of the elements shapes, outward oriented.
+static const int ahh5_tri_faces[1][5] = {{3, 0, 1, 2, -1}};
+static const int ahh5_quad_faces[1][5] = {{4, 0, 1, 2, 3}};
+static const int ahh5_tetra_faces[4][5] = {
+  {3, 0, 2, 1, -1}, {3, 0, 1, 3, -1}, {3, 1, 2, 3, -1}, {3, 2, 0, 3, -1}};
+static const int ahh5_pyra_faces[5][5] = {
+  {4, 0, 3, 2, 1}, {3, 0, 1, 4, -1}, {3, 1, 2, 4, -1}, {3, 2, 3, 4, -1}, {3, 3, 0, 4, -1}};
+static const int ahh5_penta_faces[5][5] = {
+  {3, 0, 2, 1, -1}, {3, 3, 4, 5, -1}, {4, 0, 1, 4, 3}, {4, 1, 2, 5, 4}, {4, 2, 0, 3, 5}};
+static const int ahh5_hexa_faces[6][5] = {
+  {4, 0, 3, 2, 1}, {4, 4, 5, 6, 7}, {4, 0, 1, 5, 4}, {4, 1, 2, 6, 5}, {4, 2, 3, 7, 6},
+  {4, 3, 0, 4, 7}};
+
+
+// Tetrahedra of the volume elements shapes (positive for the reference
+// elements).
+static const int ahh5_tetra_tetras[1][4] = {{0, 1, 2, 3}};
+static const int ahh5_pyra_tetras[2][4] = {{0, 1, 2, 4}, {0, 2, 3, 4}};
+static const int ahh5_penta_tetras[3][4] = {{0, 1, 2, 3}, {1, 5, 2, 3}, {1, 4, 5, 3}};
+static const int ahh5_hexa_tetras[6][4] = {
+  {0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6}, {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+
+
+// Return the local edges of an element type.
+static int ahh5_element_edges(char type, const int (**edges)[2])
+{
+  switch (type)
+  {
+    case AH5_UELE_BAR2:
+    case AH5_UELE_BAR3:
+      *edges = ahh5_bar_edges;
+      return 1;
+    case AH5_UELE_TRI3:
+    case AH5_UELE_TRI6:
+      *edges = ahh5_tri_edges;
+      return 3;
+    case AH5_UELE_QUAD4:
+    case AH5_UELE_QUAD8:
+    case AH5_UELE_QUAD9:
+      *edges = ahh5_quad_edges;
+      return 4;
+    case AH5_UELE_TETRA4:
+    case AH5_UELE_TETRA10:
+      *edges = ahh5_tetra_edges;
+      return 6;
+    case AH5_UELE_PYRA5:
+      *edges = ahh5_pyra_edges;
+      return 8;
+    case AH5_UELE_PENTA6:
+      *edges = ahh5_penta_edges;
+      return 9;
+    case AH5_UELE_HEXA8:
+    case AH5_UELE_HEXA20:
+      *edges = ahh5_hexa_edges;
+      return 12;
+    default:
+      *edges = NULL;
+      return 0;
+  }
+}
+
+
+// Return the local faces of an element type.
+static int ahh5_element_faces(char type, const int (**faces)[5])
+{
+  switch (type)
+  {
+    case AH5_UELE_TRI3:
+    case AH5_UELE_TRI6:
+      *faces = ahh5_tri_faces;
+      return 1;
+    case AH5_UELE_QUAD4:
+    case AH5_UELE_QUAD8:
+    case AH5_UELE_QUAD9:
+      *faces = ahh5_quad_faces;
+      return 1;
+    case AH5_UELE_TETRA4:
+    case AH5_UELE_TETRA10:
+      *faces = ahh5_tetra_faces;
+      return 4;
+    case AH5_UELE_PYRA5:
+      *faces = ahh5_pyra_faces;
+      return 5;
+    case AH5_UELE_PENTA6:
+      *faces = ahh5_penta_faces;
+      return 5;
+    case AH5_UELE_HEXA8:
+    case AH5_UELE_HEXA20:
+      *faces = ahh5_hexa_faces;
+      return 6;
+    default:
+      *faces = NULL;
+      return 0;
+  }
+}
+
+
+// Write the canonical key (sorted nodes padded with -1) of a local entity.
+static void ahh5_make_key(const int *nodes, const int *corners, int size, int *key)
+{
+  int i, j, value;
+
+  for (i = 0; i < size; ++i)
+  {
+    value = nodes[corners[i]];
+    for (j = i; j > 0 && key[j - 1] > value; --j)
+      key[j] = key[j - 1];
+    key[j] = value;
+  }
+  for (i = size; i < AHH5_KEY_WIDTH; ++i)
+    key[i] = -1;
+}
+
+
+static unsigned long ahh5_hash_key(const int *key)
+{
+  unsigned long hash = 2166136261UL;
+  int i;
+
+  for (i = 0; i < AHH5_KEY_WIDTH; ++i)
+    hash = (hash ^ (unsigned long) key[i]) * 16777619UL;
+  return hash ^ (hash >> 15);
+}
+
+
+static char ahh5_equal_keys(const int *key1, const int *key2)
+{
+  return key1[0] == key2[0] && key1[1] == key2[1] && key1[2] == key2[2] && key1[3] == key2[3];
+}
+
+
+// Number the keys of a bucket (in key order): owners[k] is the first
+// occurrence of the key k, seconds[owner] its second one (if not NULL).
+static void ahh5_number_bucket(const int *keys, const unsigned long *hashes,
+                               const hsize_t *bucket, hsize_t count, hsize_t *table,
+                               hsize_t size, hsize_t *owners, hsize_t *seconds)
+{
+  hsize_t mask = size - 1, h, i, k;
+
+  for (h = 0; h < size; ++h)
+    table[h] = AHH5_NO_KEY;
+
+  for (i = 0; i < count; ++i)
+  {
+    k = bucket[i];
+    h = hashes[k] & mask;
+    while (table[h] != AHH5_NO_KEY
+           && !ahh5_equal_keys(keys + AHH5_KEY_WIDTH * table[h], keys + AHH5_KEY_WIDTH * k))
+      h = (h + 1) & mask;
+
+    if (table[h] == AHH5_NO_KEY)
+    {
+      table[h] = k;
+      owners[k] = k;
+      if (seconds)
+        seconds[k] = AHH5_NO_KEY;
+    }
+    else
+    {
+      owners[k] = table[h];
+      if (seconds && seconds[table[h]] == AHH5_NO_KEY)
+        seconds[table[h]] = k;
+    }
+  }
+}
+
+
+// Number the unique keys in first occurrence order, return the number of
+// unique keys or AHH5_NO_KEY on memory failure. firsts[id] is the first
+// occurrence of the key id and seconds[id] (if not NULL) its second one or
+// AHH5_NO_KEY.
+static hsize_t ahh5_number_keys(const int *keys, hsize_t nb_keys, int *ids, hsize_t *firsts,
+                                hsize_t *seconds)
+{
+  hsize_t counts[AHH5_KEY_BUCKETS][AHH5_KEY_BUCKETS], starts[AHH5_KEY_BUCKETS + 1];
+  hsize_t sizes[AHH5_KEY_BUCKETS + 1], nb_firsts[AHH5_KEY_BUCKETS + 1];
+  hsize_t *order, *owners, *table, *all_seconds = NULL, k, pos, id;
+  unsigned long *hashes;
+  int c, b;
+
+  hashes = (unsigned long *) malloc((size_t) (nb_keys + 1) * sizeof(unsigned long));
+  order = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+  owners = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+  if (seconds)
+    all_seconds = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+  if (!hashes || !order || !owners || (seconds && !all_seconds))
+  {
+    free(hashes);
+    free(order);
+    free(owners);
+    free(all_seconds);
+    return AHH5_NO_KEY;
+  }
+
+  // Split the keys by hash into buckets, each chunk of keys keeps its order.
+#ifdef _OPENMP
+#pragma omp parallel for private(k, b)
+#endif
+  for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+  {
+    for (b = 0; b < AHH5_KEY_BUCKETS; ++b)
+      counts[c][b] = 0;
+    for (k = nb_keys * c / AHH5_KEY_BUCKETS; k < nb_keys * (c + 1) / AHH5_KEY_BUCKETS; ++k)
+    {
+      hashes[k] = ahh5_hash_key(keys + AHH5_KEY_WIDTH * k);
+      counts[c][(hashes[k] >> 16) % AHH5_KEY_BUCKETS]++;
+    }
+  }
+
+  pos = 0;
+  sizes[0] = 0;
+  for (b = 0; b < AHH5_KEY_BUCKETS; ++b)
+  {
+    starts[b] = pos;
+    for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+    {
+      k = counts[c][b];
+      counts[c][b] = pos;
+      pos += k;
+    }
+    for (k = 16; k < 2 * (pos - starts[b]); k *= 2)
+      ;
+    sizes[b + 1] = sizes[b] + k;
+  }
+  starts[AHH5_KEY_BUCKETS] = pos;
+
+  table = (hsize_t *) malloc((size_t) sizes[AHH5_KEY_BUCKETS] * sizeof(hsize_t));
+  if (!table)
+  {
+    free(hashes);
+    free(order);
+    free(owners);
+    free(all_seconds);
+    return AHH5_NO_KEY;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k)
+#endif
+  for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+    for (k = nb_keys * c / AHH5_KEY_BUCKETS; k < nb_keys * (c + 1) / AHH5_KEY_BUCKETS; ++k)
+      order[counts[c][(hashes[k] >> 16) % AHH5_KEY_BUCKETS]++] = k;
+
+  // Number each bucket, the keys of a bucket are in increasing order.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (b = 0; b < AHH5_KEY_BUCKETS; ++b)
+    ahh5_number_bucket(keys, hashes, order + starts[b], starts[b + 1] - starts[b],
+                       table + sizes[b], sizes[b + 1] - sizes[b], owners, all_seconds);
+  free(table);
+  free(order);
+  free(hashes);
+
+  // Prefix pass over the first occurrences, then the others take the id of
+  // their first occurrence.
+#ifdef _OPENMP
+#pragma omp parallel for private(k)
+#endif
+  for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+  {
+    nb_firsts[c + 1] = 0;
+    for (k = nb_keys * c / AHH5_KEY_BUCKETS; k < nb_keys * (c + 1) / AHH5_KEY_BUCKETS; ++k)
+      if (owners[k] == k)
+        nb_firsts[c + 1]++;
+  }
+  nb_firsts[0] = 0;
+  for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+    nb_firsts[c + 1] += nb_firsts[c];
+
+#ifdef _OPENMP
+#pragma omp parallel for private(k, id)
+#endif
+  for (c = 0; c < AHH5_KEY_BUCKETS; ++c)
+  {
+    id = nb_firsts[c];
+    for (k = nb_keys * c / AHH5_KEY_BUCKETS; k < nb_keys * (c + 1) / AHH5_KEY_BUCKETS; ++k)
+      if (owners[k] == k)
+      {
+        firsts[id] = k;
+        if (seconds)
+          seconds[id] = all_seconds[k];
+        ids[k] = (int) id++;
+      }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (k = 0; k < nb_keys; ++k)
+    if (owners[k] != k)
+      ids[k] = ids[owners[k]];
+
+  free(owners);
+  free(all_seconds);
+  return nb_firsts[AHH5_KEY_BUCKETS];
+}
+
+
+// Build the element to local entities offsets.
+static hsize_t *ahh5_entity_offsets(const AH5_umesh_t *umesh, hsize_t nb_elements, char faces)
+{
+  const int (*edges)[2];
+  const int (*shapes)[5];
+  hsize_t *offsets, i;
+
+  offsets = (hsize_t *) malloc((size_t) (nb_elements + 1) * sizeof(hsize_t));
+  if (offsets)
+  {
+    offsets[0] = 0;
+    for (i = 0; i < nb_elements; ++i)
+      offsets[i + 1] = offsets[i] + (faces ?
+                                     ahh5_element_faces(umesh->elementtypes[i], &shapes) :
+                                     ahh5_element_edges(umesh->elementtypes[i], &edges));
+  }
+  return offsets;
+}
+
+
+// Write the keys of the edges of an element.
+static void ahh5_edge_keys(const int *nodes, char type, int *keys)
+{
+  const int (*edges)[2];
+  int e, nb_edges;
+
+  nb_edges = ahh5_element_edges(type, &edges);
+  for (e = 0; e < nb_edges; ++e)
+    ahh5_make_key(nodes, edges[e], 2, keys + AHH5_KEY_WIDTH * e);
+}
+
+
+// Write the keys of the faces of an element.
+static void ahh5_face_keys(const int *nodes, char type, int *keys)
+{
+  const int (*faces)[5];
+  int f, nb_faces;
+
+  nb_faces = ahh5_element_faces(type, &faces);
+  for (f = 0; f < nb_faces; ++f)
+    ahh5_make_key(nodes, faces[f] + 1, faces[f][0], keys + AHH5_KEY_WIDTH * f);
+}
+
+
+// Count the elements of each node, return AH5_FALSE if a node is out of range.
+static char ahh5_count_node_elements(const int *nodes, int size, hsize_t nb_nodes,
+                                     hsize_t *counts)
+{
+  int j;
+
+  for (j = 0; j < size; ++j)
+  {
+    if (nodes[j] < 0 || (hsize_t) nodes[j] >= nb_nodes)
+      return AH5_FALSE;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    counts[nodes[j] + 1]++;
+  }
+  return AH5_TRUE;
+}
+
+
+// Insertion sort of the few elements of a node.
+static void ahh5_sort_elements(int *elements, hsize_t count)
+{
+  hsize_t i, j;
+  int element;
+
+  for (i = 1; i < count; ++i)
+  {
+    element = elements[i];
+    for (j = i; j > 0 && elements[j - 1] > element; --j)
+      elements[j] = elements[j - 1];
+    elements[j] = element;
+  }
+}
+
+
+char ahh5_build_node_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index,
+    ahh5_node_elements_t *adjacency)
+{
+  hsize_t i, j, pos, nb_nodes, *offsets, *fill;
+  int *elements;
+  char invalid = 0;
+
+  adjacency->nb_nodes = 0;
+  adjacency->offsets = NULL;
+  adjacency->elements = NULL;
+
+  nb_nodes = umesh->nb_nodes[AH5_UMESH_NODES_SIZE];
+  offsets = (hsize_t *) calloc((size_t) (nb_nodes + 1), sizeof(hsize_t));
+  if (!offsets)
+    return AH5_FALSE;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(|:invalid)
+#endif
+  for (i = 0; i < index->nb_elements; ++i)
+    invalid |= !ahh5_count_node_elements(umesh->elementnodes + index->offsets[i],
+                                         (int) AH5_UELEMENT_SIZE(index, i), nb_nodes, offsets);
+  if (invalid)
+  {
+    AH5_log_error("Node to element adjacency: a node is out of range.");
+    free(offsets);
+    return AH5_FALSE;
+  }
+
+  for (i = 0; i < nb_nodes; ++i)
+    offsets[i + 1] += offsets[i];
+
+  elements = (int *) malloc((size_t) offsets[nb_nodes] * sizeof(int));
+  fill = (hsize_t *) malloc((size_t) (nb_nodes + 1) * sizeof(hsize_t));
+  if (!elements || !fill)
+  {
+    free(elements);
+    free(fill);
+    free(offsets);
+    return AH5_FALSE;
+  }
+  memcpy(fill, offsets, (size_t) nb_nodes * sizeof(hsize_t));
+
+  // Filled in any order, then the elements of each node are sorted.
+#ifdef _OPENMP
+#pragma omp parallel for private(j, pos)
+#endif
+  for (i = 0; i < index->nb_elements; ++i)
+    for (j = index->offsets[i]; j < index->offsets[i + 1]; ++j)
+    {
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+      pos = fill[umesh->elementnodes[j]]++;
+      elements[pos] = (int) i;
+    }
+  free(fill);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for (i = 0; i < nb_nodes; ++i)
+    ahh5_sort_elements(elements + offsets[i], offsets[i + 1] - offsets[i]);
+
+  adjacency->nb_nodes = nb_nodes;
+  adjacency->offsets = offsets;
+  adjacency->elements = elements;
+  return AH5_TRUE;
+}
+
+
+void ahh5_free_node_elements(ahh5_node_elements_t *adjacency)
+{
+  if (adjacency)
+  {
+    free(adjacency->offsets);
+    free(adjacency->elements);
+    adjacency->offsets = NULL;
+    adjacency->elements = NULL;
+    adjacency->nb_nodes = 0;
+  }
+}
+
+
+char ahh5_build_uedges(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, ahh5_uedges_t *edges)
+{
+  hsize_t i, nb_keys, nb_edges = AHH5_NO_KEY, *offsets, *firsts;
+  int *keys, *element_edges, *nodes = NULL;
+
+  edges->nb_edges = 0;
+  edges->nodes = NULL;
+  edges->nb_elements = 0;
+  edges->offsets = NULL;
+  edges->element_edges = NULL;
+
+  offsets = ahh5_entity_offsets(umesh, index->nb_elements, AH5_FALSE);
+  if (!offsets)
+    return AH5_FALSE;
+  nb_keys = offsets[index->nb_elements];
+
+  keys = (int *) malloc((size_t) (AHH5_KEY_WIDTH * nb_keys + 1) * sizeof(int));
+  element_edges = (int *) malloc((size_t) (nb_keys + 1) * sizeof(int));
+  firsts = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+
+  if (keys && element_edges && firsts)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (i = 0; i < index->nb_elements; ++i)
+      ahh5_edge_keys(umesh->elementnodes + index->offsets[i], umesh->elementtypes[i],
+                     keys + AHH5_KEY_WIDTH * offsets[i]);
+
+    nb_edges = ahh5_number_keys(keys, nb_keys, element_edges, firsts, NULL);
+    if (nb_edges != AHH5_NO_KEY)
+      nodes = (int *) malloc((size_t) (2 * nb_edges + 1) * sizeof(int));
+    if (nodes)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (i = 0; i < nb_edges; ++i)
+      {
+        nodes[2 * i] = keys[AHH5_KEY_WIDTH * firsts[i]];
+        nodes[2 * i + 1] = keys[AHH5_KEY_WIDTH * firsts[i] + 1];
+      }
+    }
+  }
+  free(keys);
+  free(firsts);
+
+  if (!nodes)
+  {
+    free(element_edges);
+    free(offsets);
+    return AH5_FALSE;
+  }
+
+  edges->nb_edges = nb_edges;
+  edges->nodes = nodes;
+  edges->nb_elements = index->nb_elements;
+  edges->offsets = offsets;
+  edges->element_edges = element_edges;
+  return AH5_TRUE;
+}
+
+
+void ahh5_free_uedges(ahh5_uedges_t *edges)
+{
+  if (edges)
+  {
+    free(edges->nodes);
+    free(edges->offsets);
+    free(edges->element_edges);
+    edges->nodes = NULL;
+    edges->offsets = NULL;
+    edges->element_edges = NULL;
+    edges->nb_edges = 0;
+    edges->nb_elements = 0;
+  }
+}
+
+
+// Return the element owning the local entity k (binary search).
+static hsize_t ahh5_key_element(const hsize_t *offsets, hsize_t nb_elements, hsize_t k)
+{
+  hsize_t low = 0, high = nb_elements, mid;
+
+  // Last element starting at or before k, the empty ones are skipped.
+  while (high - low > 1)
+  {
+    mid = low + (high - low) / 2;
+    if (offsets[mid] <= k)
+      low = mid;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+
+// Fill the faces nodes and elements from the first and second occurrences
+// of the numbered keys.
+static char ahh5_fill_ufaces(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, const hsize_t *offsets,
+    const hsize_t *firsts, const hsize_t *seconds, ahh5_ufaces_t *faces)
+{
+  const int (*shapes)[5];
+  const int *nodes;
+  hsize_t k, f, element;
+  int j, size, *wide_nodes;
+
+  faces->face_offsets = (hsize_t *) malloc((size_t) (faces->nb_faces + 1) * sizeof(hsize_t));
+  faces->face_elements = (int *) malloc((size_t) (2 * faces->nb_faces + 1) * sizeof(int));
+  wide_nodes = (int *) malloc((size_t) (AHH5_KEY_WIDTH * faces->nb_faces + 1) * sizeof(int));
+  if (!faces->face_offsets || !faces->face_elements || !wide_nodes)
+  {
+    free(wide_nodes);
+    return AH5_FALSE;
+  }
+
+  // The face takes the orientation of its first element.
+#ifdef _OPENMP
+#pragma omp parallel for private(k, element, shapes, nodes, size, j)
+#endif
+  for (f = 0; f < faces->nb_faces; ++f)
+  {
+    k = firsts[f];
+    element = ahh5_key_element(offsets, index->nb_elements, k);
+    ahh5_element_faces(umesh->elementtypes[element], &shapes);
+    nodes = umesh->elementnodes + index->offsets[element];
+    size = shapes[k - offsets[element]][0];
+    faces->face_elements[2 * f] = (int) element;
+    faces->face_elements[2 * f + 1] = seconds[f] == AHH5_NO_KEY ? -1 :
+        (int) ahh5_key_element(offsets, index->nb_elements, seconds[f]);
+    faces->face_offsets[f + 1] = size;
+    for (j = 0; j < size; ++j)
+      wide_nodes[AHH5_KEY_WIDTH * f + j] = nodes[shapes[k - offsets[element]][j + 1]];
+  }
+
+  faces->face_offsets[0] = 0;
+  for (f = 0; f < faces->nb_faces; ++f)
+    faces->face_offsets[f + 1] += faces->face_offsets[f];
+
+  faces->face_nodes = (int *) malloc((size_t) (faces->face_offsets[faces->nb_faces] + 1)
+                                     * sizeof(int));
+  if (faces->face_nodes)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for private(k)
+#endif
+    for (f = 0; f < faces->nb_faces; ++f)
+      for (k = faces->face_offsets[f]; k < faces->face_offsets[f + 1]; ++k)
+        faces->face_nodes[k] = wide_nodes[AHH5_KEY_WIDTH * f + k - faces->face_offsets[f]];
+  }
+  free(wide_nodes);
+  return faces->face_nodes != NULL;
+}
+
+
+char ahh5_build_ufaces(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, ahh5_ufaces_t *faces)
+{
+  char success = AH5_FALSE;
+  hsize_t i, nb_keys, *offsets, *firsts, *seconds;
+  int *keys;
+
+  faces->nb_faces = 0;
+  faces->face_offsets = NULL;
+  faces->face_nodes = NULL;
+  faces->face_elements = NULL;
+  faces->nb_elements = 0;
+  faces->offsets = NULL;
+  faces->element_faces = NULL;
+
+  offsets = ahh5_entity_offsets(umesh, index->nb_elements, AH5_TRUE);
+  if (!offsets)
+    return AH5_FALSE;
+  nb_keys = offsets[index->nb_elements];
+
+  keys = (int *) malloc((size_t) (AHH5_KEY_WIDTH * nb_keys + 1) * sizeof(int));
+  faces->element_faces = (int *) malloc((size_t) (nb_keys + 1) * sizeof(int));
+  firsts = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+  seconds = (hsize_t *) malloc((size_t) (nb_keys + 1) * sizeof(hsize_t));
+  faces->nb_elements = index->nb_elements;
+  faces->offsets = offsets;
+
+  if (keys && faces->element_faces && firsts && seconds)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (i = 0; i < index->nb_elements; ++i)
+      ahh5_face_keys(umesh->elementnodes + index->offsets[i], umesh->elementtypes[i],
+                     keys + AHH5_KEY_WIDTH * offsets[i]);
+
+    faces->nb_faces = ahh5_number_keys(keys, nb_keys, faces->element_faces, firsts, seconds);
+    if (faces->nb_faces != AHH5_NO_KEY)
+      success = ahh5_fill_ufaces(umesh, index, offsets, firsts, seconds, faces);
+  }
+  free(keys);
+  free(firsts);
+  free(seconds);
+
+  if (!success)
+    ahh5_free_ufaces(faces);
+  return success;
+}
+
+
+void ahh5_free_ufaces(ahh5_ufaces_t *faces)
+{
+  if (faces)
+  {
+    free(faces->face_offsets);
+    free(faces->face_nodes);
+    free(faces->face_elements);
+    free(faces->offsets);
+    free(faces->element_faces);
+    faces->face_offsets = NULL;
+    faces->face_nodes = NULL;
+    faces->face_elements = NULL;
+    faces->offsets = NULL;
+    faces->element_faces = NULL;
+    faces->nb_faces = 0;
+    faces->nb_elements = 0;
+  }
+}
+
+
+void ahh5_unode_coordinates(const AH5_umesh_t *umesh, int node, double xyz[3])
+{
+  hsize_t dim = umesh->nb_nodes[1], d;
+
+  for (d = 0; d < 3; ++d)
+    xyz[d] = d < dim ? umesh->nodes[node * dim + d] : 0;
+}
+
+
+int ahh5_uelement_tetras(char type, const int (**tetras)[4])
+{
+  switch (type)
+  {
+    case AH5_UELE_TETRA4:
+    case AH5_UELE_TETRA10:
+      *tetras = ahh5_tetra_tetras;
+      return 1;
+    case AH5_UELE_PYRA5:
+      *tetras = ahh5_pyra_tetras;
+      return 2;
+    case AH5_UELE_PENTA6:
+      *tetras = ahh5_penta_tetras;
+      return 3;
+    case AH5_UELE_HEXA8:
+    case AH5_UELE_HEXA20:
+      *tetras = ahh5_hexa_tetras;
+      return 6;
+    default:
+      *tetras = NULL;
+      return 0;
+  }
+}
+
+
+char ahh5_uelement_center(const AH5_umesh_t *umesh, const AH5_uelement_index_t *index,
+                          hsize_t element, double center[3])
+{
+  hsize_t j, nb_nodes = umesh->nb_nodes[AH5_UMESH_NODES_SIZE];
+  double xyz[3];
+  int d, node;
+
+  center[0] = center[1] = center[2] = 0;
+  for (j = index->offsets[element]; j < index->offsets[element + 1]; ++j)
+  {
+    node = umesh->elementnodes[j];
+    if (node < 0 || (hsize_t) node >= nb_nodes)
+      return AH5_FALSE;
+    ahh5_unode_coordinates(umesh, node, xyz);
+    for (d = 0; d < 3; ++d)
+      center[d] += xyz[d];
+  }
+  for (d = 0; d < 3 && AH5_UELEMENT_SIZE(index, element) > 0; ++d)
+    center[d] /= (double) AH5_UELEMENT_SIZE(index, element);
+  return AH5_TRUE;
+}
+
+
+// Three way quick select.
+void ahh5_select_element(int *elements, hsize_t count, hsize_t nth,
+                         const float *centers, int axis)
+{
+  hsize_t left = 0, end = count, lower, upper, i;
+  float pivot, key;
+  int tmp;
+
+  while (end - left > 1)
+  {
+    pivot = centers[3 * elements[left + (end - left) / 2] + axis];
+    lower = left;
+    upper = end;
+    i = left;
+    while (i < upper)
+    {
+      key = centers[3 * elements[i] + axis];
+      if (key < pivot)
+      {
+        tmp = elements[lower];
+        elements[lower++] = elements[i];
+        elements[i++] = tmp;
+      }
+      else if (key > pivot)
+      {
+        tmp = elements[--upper];
+        elements[upper] = elements[i];
+        elements[i] = tmp;
+      }
+      else
+        ++i;
+    }
+
+    if (nth < lower)
+      end = lower;
+    else if (nth >= upper)
+      left = upper;
+    else
+      return;
+  }
+}
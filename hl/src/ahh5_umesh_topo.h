@@ -0,0 +1,173 @@
+/**
+ * @file   ahh5_umesh_topo.h
+ *
+ * @brief  Unstructured mesh topology: node to element adjacency, unique
+ * edges, unique faces, node coordinates, element centers and volume element
+ * tetrahedra.
+ *
+ * All the builders take the element offsets index of the mesh (see
+ * AH5_init_uelement_index). The quadratic elements are handled through their
+ * corner nodes. When built with OpenMP the per element work is multithreaded.
+ *
+ */
+
+#ifndef _AHH5_UMESH_TOPO_H_
+#define _AHH5_UMESH_TOPO_H_
+
+#include <ah5_c_mesh.h>
+
+#include "ahh5_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Node to element adjacency (CSR).
+ *
+ * The elements of the node i are elements[offsets[i]] up to
+ * elements[offsets[i + 1] - 1], in increasing order.
+ */
+typedef struct _ahh5_node_elements_t
+{
+  hsize_t         nb_nodes;
+  hsize_t         *offsets;
+  int             *elements;
+} ahh5_node_elements_t;
+
+/**
+ * Unique edges of an unstructured mesh.
+ *
+ * The edge e goes from nodes[2*e] to nodes[2*e + 1] (the smallest node
+ * first). The edges of the element i are element_edges[offsets[i]] up to
+ * element_edges[offsets[i + 1] - 1] in the element local edge order.
+ */
+typedef struct _ahh5_uedges_t
+{
+  hsize_t         nb_edges;
+  int             *nodes;
+  hsize_t         nb_elements;
+  hsize_t         *offsets;
+  int             *element_edges;
+} ahh5_uedges_t;
+
+/**
+ * Unique faces of an unstructured mesh.
+ *
+ * The corner nodes of the face f are face_nodes[face_offsets[f]] up to
+ * face_nodes[face_offsets[f + 1] - 1], oriented as in the first element
+ * owning the face. The face f is shared by face_elements[2*f] and
+ * face_elements[2*f + 1], the latter being -1 for a boundary face.
+ * The faces of the element i are element_faces[offsets[i]] up to
+ * element_faces[offsets[i + 1] - 1] in the element local face order.
+ *
+ * A surface element (tri or quad) is its own face so surface elements are
+ * matched with the faces of the volume elements.
+ */
+typedef struct _ahh5_ufaces_t
+{
+  hsize_t         nb_faces;
+  hsize_t         *face_offsets;
+  int             *face_nodes;
+  int             *face_elements;
+  hsize_t         nb_elements;
+  hsize_t         *offsets;
+  int             *element_faces;
+} ahh5_ufaces_t;
+
+
+/**
+ * Build the node to element adjacency of an unstructured mesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[out] adjacency the node to element adjacency
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_build_node_elements(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index,
+    ahh5_node_elements_t *adjacency);
+AHH5_PUBLIC void ahh5_free_node_elements(ahh5_node_elements_t *adjacency);
+
+/**
+ * Build the unique edges of an unstructured mesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[out] edges the unique edges and the element to edge map
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_build_uedges(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, ahh5_uedges_t *edges);
+AHH5_PUBLIC void ahh5_free_uedges(ahh5_uedges_t *edges);
+
+/**
+ * Build the unique faces of an unstructured mesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[out] faces the unique faces and the element to face map
+ *
+ * @return AH5_TRUE on success.
+ */
+AHH5_PUBLIC char ahh5_build_ufaces(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, ahh5_ufaces_t *faces);
+AHH5_PUBLIC void ahh5_free_ufaces(ahh5_ufaces_t *faces);
+
+/**
+ * Get the coordinates of a node of an unstructured mesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] node the node (not checked)
+ * @param[out] xyz the coordinates, the missing ones are 0
+ */
+AHH5_PUBLIC void ahh5_unode_coordinates(const AH5_umesh_t *umesh, int node, double xyz[3]);
+
+/**
+ * Get the center (mean of the nodes) of an unstructured mesh element.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[in] element the element (not checked)
+ * @param[out] center the center coordinates
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if a node is out of range).
+ */
+AHH5_PUBLIC char ahh5_uelement_center(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, hsize_t element,
+    double center[3]);
+
+/**
+ * Get the tetrahedra splitting a volume element type.
+ *
+ * The tetrahedra are positively oriented for the reference elements, the
+ * quadratic elements are split through their corner nodes.
+ *
+ * @param[in] type the element type
+ * @param[out] tetras the local corners of the tetrahedra (NULL for the other
+ * types)
+ *
+ * @return the number of tetrahedra, 0 if type is not a volume type.
+ */
+AHH5_PUBLIC int ahh5_uelement_tetras(char type, const int (**tetras)[4]);
+
+/**
+ * Move the nth element (by center along axis) at its sorted place, the
+ * smaller ones before and the larger ones after.
+ *
+ * @param[in,out] elements the elements to select from
+ * @param[in] count the number of elements
+ * @param[in] nth the place to fill
+ * @param[in] centers the element centers (3 per element)
+ * @param[in] axis the axis (0, 1 or 2)
+ */
+AHH5_PUBLIC void ahh5_select_element(int *elements, hsize_t count, hsize_t nth,
+                                     const float *centers, int axis);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _AHH5_UMESH_TOPO_H_ */
@@ -0,0 +1,273 @@
+/**
+ * @file   smesh_query.c
+ *
+ * @brief  Test ahh5_smesh_query.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include <ahh5_smesh_query.h>
+
+int tests_run = 0;
+
+
+// A 4 x 3 x 2 cells mesh, x and z uniform, y graded.
+static void build_smesh(AH5_smesh_t *smesh)
+{
+  float y[4] = {0., 1., 3., 7.};
+  hsize_t i;
+
+  AH5_init_smesh(smesh, 0, 0, 0);
+  AH5_init_axis(&smesh->x, 5);
+  AH5_init_axis(&smesh->y, 4);
+  AH5_init_axis(&smesh->z, 3);
+  for (i = 0; i < 5; ++i)
+    smesh->x.nodes[i] = -1.f + 0.1f * (float) i;
+  memcpy(smesh->y.nodes, y, sizeof(y));
+  for (i = 0; i < 3; ++i)
+    smesh->z.nodes[i] = 2.f * (float) i;
+}
+
+
+// Count the indices given by an iteration, stop at user limit.
+typedef struct _count_runs_t
+{
+  hsize_t nb_runs;
+  hsize_t nb_indices;
+  hsize_t limit;
+} count_runs_t;
+
+static char count_runs(const hsize_t ijk[3], hsize_t count, int axis, void *user_data)
+{
+  count_runs_t *counter = (count_runs_t *) user_data;
+
+  (void) ijk;
+  (void) axis;
+  ++counter->nb_runs;
+  counter->nb_indices += count;
+  return counter->nb_runs != counter->limit;
+}
+
+
+static char *test_smesh_ids()
+{
+  AH5_smesh_t smesh;
+  ahh5_smesh_query_t query;
+  hsize_t ijk[3];
+
+  build_smesh(&smesh);
+  mu_assert("init query", ahh5_init_smesh_query(&query, &smesh));
+  mu_assert_eq("nb cells", query.nb_cells[0], 4);
+  mu_assert_eq("nb cells", query.nb_cells[1], 3);
+  mu_assert_eq("nb cells", query.nb_cells[2], 2);
+  mu_assert_true("uniform x", query.axes[0].uniform);
+  mu_assert_false("graded y", query.axes[1].uniform);
+  mu_assert_true("uniform z", query.axes[2].uniform);
+
+  mu_assert_eq("cell id", ahh5_scell_id(&query, 3, 2, 1), 3 + 4 * (2 + 3 * 1));
+  mu_assert_eq("node id", ahh5_snode_id(&query, 3, 2, 1), 3 + 5 * (2 + 4 * 1));
+  ahh5_scell_ijk(&query, 23, ijk);
+  mu_assert_eq("cell ijk", ijk[0], 3);
+  mu_assert_eq("cell ijk", ijk[1], 2);
+  mu_assert_eq("cell ijk", ijk[2], 1);
+
+  // Too small axis.
+  smesh.z.nb_nodes = 1;
+  mu_assert("one node axis", !ahh5_init_smesh_query(&query, &smesh));
+  smesh.z.nb_nodes = 3;
+
+  AH5_free_smesh(&smesh);
+  return NULL;
+}
+
+
+static char *test_smesh_locate()
+{
+  AH5_smesh_t smesh;
+  ahh5_smesh_query_t query;
+  float point[3];
+  hsize_t ijk[3], cell, i;
+
+  build_smesh(&smesh);
+  ahh5_init_smesh_query(&query, &smesh);
+
+  point[0] = -0.75f;
+  point[1] = 5.f;
+  point[2] = 1.f;
+  mu_assert("locate", ahh5_smesh_locate(&query, point, ijk));
+  mu_assert_eq("locate i", ijk[0], 2);
+  mu_assert_eq("locate j", ijk[1], 2);
+  mu_assert_eq("locate k", ijk[2], 0);
+
+  // The nodes are on the upper cell, the last node in the last cell.
+  for (i = 0; i < 4; ++i)
+  {
+    mu_assert("node", ahh5_saxis_locate(query.axes + 0, smesh.x.nodes[i], &cell));
+    mu_assert_eq("node", cell, i);
+    mu_assert("node", ahh5_saxis_locate(query.axes + 1, smesh.y.nodes[i], &cell));
+    mu_assert_eq("node", cell, i - (i == 3));
+  }
+  mu_assert("last node", ahh5_saxis_locate(query.axes + 0, smesh.x.nodes[4], &cell));
+  mu_assert_eq("last node", cell, 3);
+
+  // Out of mesh.
+  point[1] = 7.5f;
+  mu_assert("out of mesh", !ahh5_smesh_locate(&query, point, ijk));
+  mu_assert("out of axis", !ahh5_saxis_locate(query.axes + 0, -1.01f, &cell));
+
+  AH5_free_smesh(&smesh);
+  return NULL;
+}
+
+
+// The groups of the single cell mesh of the mesh tests, in node bounds.
+static char *test_sgroup_cell()
+{
+  AH5_sgroup_t volume, surface;
+  ahh5_sgroup_index_t index;
+  ahh5_sbox_t box;
+  count_runs_t counter;
+  hsize_t ijk[3] = {0, 0, 0};
+  int cell[6] = {0, 0, 0, 1, 1, 1};
+  int faces[36] = {0, 0, 0, 0, 1, 1,   // x-
+                   0, 0, 0, 1, 0, 1,   // y-
+                   0, 0, 0, 1, 1, 0,   // z-
+                   1, 0, 0, 1, 1, 1,   // x+
+                   0, 1, 0, 1, 1, 1,   // y+
+                   0, 0, 1, 1, 1, 1};  // z+
+  int d;
+
+  AH5_init_sgroup(&volume, NULL, 1, AH5_GROUP_VOLUME);
+  memcpy(volume.elements, cell, sizeof(cell));
+  AH5_init_sgroup(&surface, NULL, 6, AH5_GROUP_FACE);
+  memcpy(surface.elements, faces, sizeof(faces));
+
+  // One cell.
+  mu_assert("cell box", ahh5_sgroup_box(&volume, 0, &box));
+  mu_assert_eq("one cell", ahh5_sbox_size(&box), 1);
+  mu_assert_eq("cell axis", box.axis, -1);
+  memset(&counter, 0, sizeof(counter));
+  mu_assert("iterate", ahh5_sgroup_iterate(&volume, count_runs, &counter));
+  mu_assert_eq("cell runs", counter.nb_runs, 1);
+  mu_assert_eq("cell indices", counter.nb_indices, 1);
+  mu_assert("index", ahh5_init_sgroup_index(&index, &volume));
+  mu_assert_true("the cell", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = ijk[1] = ijk[2] = 1;
+  mu_assert_false("out of the cells", ahh5_sgroup_contains(&index, -1, ijk));
+  ahh5_free_sgroup_index(&index);
+
+  // Its six faces, one per box.
+  memset(&counter, 0, sizeof(counter));
+  mu_assert("iterate", ahh5_sgroup_iterate(&surface, count_runs, &counter));
+  mu_assert_eq("faces", counter.nb_indices, 6);
+  for (d = 0; d < 6; ++d)
+  {
+    mu_assert("face box", ahh5_sgroup_box(&surface, d, &box));
+    mu_assert_eq("face axis", box.axis, d % 3);
+    mu_assert_eq("face plane", box.min[d % 3], d / 3);
+    mu_assert_eq("one face", ahh5_sbox_size(&box), 1);
+  }
+  mu_assert("index", ahh5_init_sgroup_index(&index, &surface));
+  ijk[0] = 1; ijk[1] = 0; ijk[2] = 0;
+  mu_assert_true("x+", ahh5_sgroup_contains(&index, 0, ijk));
+  mu_assert_false("no y face", ahh5_sgroup_contains(&index, 1, ijk));
+  mu_assert_false("no cell", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = 0; ijk[1] = 0; ijk[2] = 1;
+  mu_assert_true("z+", ahh5_sgroup_contains(&index, 2, ijk));
+  ahh5_free_sgroup_index(&index);
+
+  // A face box is not a volume.
+  memcpy(volume.elements, faces, sizeof(cell));
+  mu_assert("flat volume", !ahh5_sgroup_box(&volume, 0, &box));
+
+  AH5_free_sgroup(&surface);
+  AH5_free_sgroup(&volume);
+  return NULL;
+}
+
+
+static char *test_sgroup_boxes()
+{
+  AH5_sgroup_t group, edges, nodes;
+  ahh5_sgroup_index_t index;
+  ahh5_sbox_t box;
+  count_runs_t counter;
+  hsize_t ijk[3];
+  int elements[18] = {0, 0, 0, 2, 3, 1,
+                      2, 1, 1, 4, 2, 2,
+                      0, 0, 2, 1, 1, 2};
+  int edge_elements[12] = {0, 0, 0, 2, 0, 0,
+                           0, 0, 0, 1, 1, 0};
+  int node_elements[6] = {1, 2, 3,
+                          4, 4, 4};
+
+  AH5_init_sgroup(&group, NULL, 3, AH5_GROUP_VOLUME);
+  memcpy(group.elements, elements, sizeof(elements));
+  AH5_init_sgroup(&edges, NULL, 2, AH5_GROUP_EDGE);
+  memcpy(edges.elements, edge_elements, sizeof(edge_elements));
+  AH5_init_sgroup(&nodes, NULL, 2, AH5_GROUP_NODE);
+  memcpy(nodes.elements, node_elements, sizeof(node_elements));
+
+  mu_assert("box", ahh5_sgroup_box(&group, 0, &box));
+  mu_assert_eq("box size", ahh5_sbox_size(&box), 2 * 3 * 1);
+  mu_assert_eq("box cells", box.max[0], 1);
+  mu_assert("box", ahh5_sgroup_box(&group, 1, &box));
+  mu_assert_eq("box size", ahh5_sbox_size(&box), 2 * 1 * 1);
+  mu_assert("flat box", !ahh5_sgroup_box(&group, 2, &box));
+  mu_assert("out of range box", !ahh5_sgroup_box(&group, 3, &box));
+  mu_assert("edge box", ahh5_sgroup_box(&edges, 0, &box));
+  mu_assert_eq("edge box size", ahh5_sbox_size(&box), 2);
+  mu_assert_eq("edge axis", box.axis, 0);
+  mu_assert("face box edge", !ahh5_sgroup_box(&edges, 1, &box));
+  mu_assert("node box", ahh5_sgroup_box(&nodes, 1, &box));
+  mu_assert_eq("node box size", ahh5_sbox_size(&box), 1);
+  mu_assert_eq("node box", box.max[2], 4);
+
+  // Runs along i, the flat box is skipped.
+  memset(&counter, 0, sizeof(counter));
+  mu_assert("iterate", ahh5_sgroup_iterate(&group, count_runs, &counter));
+  mu_assert_eq("runs", counter.nb_runs, 3 + 1);
+  mu_assert_eq("indices", counter.nb_indices, 6 + 2);
+  memset(&counter, 0, sizeof(counter));
+  counter.limit = 2;
+  mu_assert("stop iterate", !ahh5_sgroup_iterate(&group, count_runs, &counter));
+  mu_assert_eq("stopped runs", counter.nb_runs, 2);
+
+  mu_assert("index", ahh5_init_sgroup_index(&index, &group));
+  mu_assert_eq("index boxes", index.nb_boxes, 2);
+  ijk[0] = 3; ijk[1] = 1; ijk[2] = 1;
+  mu_assert_true("in second box", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = 1; ijk[1] = 2; ijk[2] = 0;
+  mu_assert_true("in first box", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = 2; ijk[1] = 2; ijk[2] = 0;
+  mu_assert_false("on the upper nodes", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = 1; ijk[1] = 2; ijk[2] = 1;
+  mu_assert_false("out of boxes", ahh5_sgroup_contains(&index, -1, ijk));
+  ijk[0] = 3; ijk[1] = 1; ijk[2] = 2;
+  mu_assert_false("above boxes", ahh5_sgroup_contains(&index, -1, ijk));
+  ahh5_free_sgroup_index(&index);
+
+  AH5_free_sgroup(&nodes);
+  AH5_free_sgroup(&edges);
+  AH5_free_sgroup(&group);
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_smesh_ids);
+  mu_run_test(test_smesh_locate);
+  mu_run_test(test_sgroup_cell);
+  mu_run_test(test_sgroup_boxes);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,192 @@
+/**
+ * @file   umesh_bvh.c
+ *
+ * @brief  Test ahh5_umesh_bvh.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include "umesh_fixture.h"
+#include <ahh5_umesh_bvh.h>
+
+int tests_run = 0;
+
+
+#define N 6
+
+
+// N x N x N hexa of unit size and a tri on the z = 0 face.
+static void build_hexa_block(AH5_umesh_t *umesh, AH5_uelement_index_t *index)
+{
+  int *nodes;
+
+  init_hexa_block(umesh, N, 3, 1, 0);
+  nodes = umesh->elementnodes + 8 * N * N * N;
+  nodes[0] = 0;
+  nodes[1] = 1;
+  nodes[2] = N + 1;
+  umesh->elementtypes[N * N * N] = AH5_UELE_TRI3;
+  AH5_init_uelement_index(index, umesh);
+}
+
+
+// Count the elements given by a query, stop at user limit.
+typedef struct _count_elements_t
+{
+  hsize_t nb_elements;
+  hsize_t limit;
+} count_elements_t;
+
+static char count_elements(int element, void *user_data)
+{
+  count_elements_t *counter = (count_elements_t *) user_data;
+
+  (void) element;
+  ++counter->nb_elements;
+  return counter->nb_elements != counter->limit;
+}
+
+
+static char *test_build_ubvh()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ubvh_t bvh;
+  char *seen;
+  hsize_t i, nb_leaf_elements = 0;
+
+  build_hexa_block(&umesh, &index);
+  mu_assert("build", ahh5_build_ubvh(&bvh, &umesh, &index));
+  mu_assert_eq("nb elements", bvh.nb_elements, N * N * N + 1);
+  mu_assert_close("root box", bvh.nodes[0].min[0], 0., 1e-6);
+  mu_assert_close("root box", bvh.nodes[0].max[2], (float) N, 1e-6);
+
+  // Each element is in one leaf.
+  seen = (char *) calloc((size_t) bvh.nb_elements, sizeof(char));
+  for (i = 0; i < bvh.nb_nodes; ++i)
+    nb_leaf_elements += bvh.nodes[i].count;
+  mu_assert_eq("leaves", nb_leaf_elements, bvh.nb_elements);
+  for (i = 0; i < bvh.nb_elements; ++i)
+    seen[bvh.elements[i]]++;
+  for (i = 0; i < bvh.nb_elements; ++i)
+    mu_assert_eq("permutation", seen[i], 1);
+  free(seen);
+  ahh5_free_ubvh(&bvh);
+
+  // Out of range node.
+  umesh.elementnodes[5] = (N + 1) * (N + 1) * (N + 1);
+  mu_assert("out of range node", !ahh5_build_ubvh(&bvh, &umesh, &index));
+  mu_assert("out of range node", bvh.nodes == NULL);
+
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_ubvh_locate()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ubvh_t bvh;
+  float point[3], *points;
+  int *elements;
+  hsize_t i, j, k, nb_points = N * N * N + 2;
+
+  build_hexa_block(&umesh, &index);
+  ahh5_build_ubvh(&bvh, &umesh, &index);
+
+  points = (float *) malloc((size_t) (3 * nb_points) * sizeof(float));
+  elements = (int *) malloc((size_t) nb_points * sizeof(int));
+  for (k = 0; k < N; ++k)
+    for (j = 0; j < N; ++j)
+      for (i = 0; i < N; ++i)
+      {
+        point[0] = (float) i + 0.25f;
+        point[1] = (float) j + 0.5f;
+        point[2] = (float) k + 0.75f;
+        mu_assert_eq("locate", ahh5_ubvh_locate(&bvh, point), (int) (i + N * (j + N * k)));
+        memcpy(points + 3 * (i + N * (j + N * k)), point, sizeof(point));
+      }
+
+  // Out of the mesh, the tri is not a volume.
+  point[0] = -0.5f;
+  mu_assert_eq("out of mesh", ahh5_ubvh_locate(&bvh, point), -1);
+  memcpy(points + 3 * (nb_points - 2), point, sizeof(point));
+  point[0] = 0.1f;
+  point[1] = 0.1f;
+  point[2] = -0.01f;
+  mu_assert_eq("under the tri", ahh5_ubvh_locate(&bvh, point), -1);
+  memcpy(points + 3 * (nb_points - 1), point, sizeof(point));
+
+  // On a shared face.
+  point[0] = 2.f;
+  point[1] = 3.5f;
+  point[2] = 0.5f;
+  i = (hsize_t) ahh5_ubvh_locate(&bvh, point);
+  mu_assert("shared face", i == 1 + N * 3 || i == 2 + N * 3);
+
+  mu_assert_eq("batch", ahh5_ubvh_locate_points(&bvh, nb_points, points, elements),
+               N * N * N);
+  mu_assert_eq("batch", elements[7], 7);
+  mu_assert_eq("batch", elements[nb_points - 1], -1);
+
+  free(points);
+  free(elements);
+  ahh5_free_ubvh(&bvh);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_ubvh_intersect()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ubvh_t bvh;
+  count_elements_t counter;
+  float min[3] = {0.5f, 0.5f, -1.f}, max[3] = {1.5f, 1.5f, 0.5f};
+
+  build_hexa_block(&umesh, &index);
+  ahh5_build_ubvh(&bvh, &umesh, &index);
+
+  // 2 x 2 hexa and the tri.
+  memset(&counter, 0, sizeof(counter));
+  mu_assert("intersect", ahh5_ubvh_intersect(&bvh, min, max, count_elements, &counter));
+  mu_assert_eq("intersect", counter.nb_elements, 5);
+
+  memset(&counter, 0, sizeof(counter));
+  counter.limit = 2;
+  mu_assert("stop", !ahh5_ubvh_intersect(&bvh, min, max, count_elements, &counter));
+  mu_assert_eq("stop", counter.nb_elements, 2);
+
+  min[0] = N + 1.f;
+  max[0] = N + 2.f;
+  memset(&counter, 0, sizeof(counter));
+  mu_assert("no intersection", ahh5_ubvh_intersect(&bvh, min, max, count_elements, &counter));
+  mu_assert_eq("no intersection", counter.nb_elements, 0);
+
+  ahh5_free_ubvh(&bvh);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_build_ubvh);
+  mu_run_test(test_ubvh_locate);
+  mu_run_test(test_ubvh_intersect);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,47 @@
+/**
+ * @file   umesh_fixture.h
+ *
+ * @brief  Unstructured mesh fixture shared by the hl tests.
+ *
+ *
+ */
+
+#ifndef UMESH_FIXTURE_H
+#define UMESH_FIXTURE_H
+
+#include <ah5_c_mesh.h>
+
+
+// Init a n x n x n block of unit hexa (i + n * (j + n * k)) with room for
+// extra element nodes, extra elements (after the hexa) and groups.
+static void init_hexa_block(AH5_umesh_t *umesh, int n, hsize_t nb_extra_elementnodes,
+                            hsize_t nb_extra_elements, hsize_t nb_groups)
+{
+  static const int corners[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+  int i, j, k, c, e;
+
+  AH5_init_umesh(umesh, 8 * (hsize_t) (n * n * n) + nb_extra_elementnodes,
+                 (hsize_t) (n * n * n) + nb_extra_elements,
+                 (hsize_t) ((n + 1) * (n + 1) * (n + 1)), nb_groups, 0, 0);
+  for (k = 0; k <= n; ++k)
+    for (j = 0; j <= n; ++j)
+      for (i = 0; i <= n; ++i)
+      {
+        e = i + (n + 1) * (j + (n + 1) * k);
+        umesh->nodes[3 * e] = (float) i;
+        umesh->nodes[3 * e + 1] = (float) j;
+        umesh->nodes[3 * e + 2] = (float) k;
+      }
+
+  for (e = 0; e < n * n * n; ++e)
+  {
+    umesh->elementtypes[e] = AH5_UELE_HEXA8;
+    for (c = 0; c < 8; ++c)
+      umesh->elementnodes[8 * e + c] = (e % n + corners[c][0])
+                                       + (n + 1) * ((e / n % n + corners[c][1])
+                                                    + (n + 1) * (e / n / n + corners[c][2]));
+  }
+}
+
+#endif /* UMESH_FIXTURE_H */
@@ -0,0 +1,196 @@
+/**
+ * @file   umesh_geometry.c
+ *
+ * @brief  Test ahh5_umesh_geometry.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include <ahh5_umesh_geometry.h>
+
+int tests_run = 0;
+
+
+#define NB_ROW 150
+
+
+// The unit cube nodes, an apex and a far node, one element of each shape and
+// an inverted tetra.
+static void build_shapes(AH5_umesh_t *umesh, AH5_uelement_index_t *index)
+{
+  static const float nodes[10][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1},
+    {0.5, 0.5, 1}, {2, 0, 0}};
+  static const char types[10] = {
+    AH5_UELE_HEXA8, AH5_UELE_TETRA4, AH5_UELE_PYRA5, AH5_UELE_PENTA6, AH5_UELE_QUAD4,
+    AH5_UELE_TRI3, AH5_UELE_TRI6, AH5_UELE_BAR2, AH5_UELE_TETRA4, AH5_UELE_NODE};
+  static const int elementnodes[43] = {
+    0, 1, 2, 3, 4, 5, 6, 7,
+    0, 1, 3, 4,
+    0, 1, 2, 3, 8,
+    0, 1, 3, 4, 5, 7,
+    0, 1, 2, 3,
+    0, 1, 3,
+    0, 1, 3, 6, 6, 6,
+    0, 9,
+    0, 3, 1, 4,
+    8};
+
+  AH5_init_umesh(umesh, 43, 10, 10, 0, 0, 0);
+  memcpy(umesh->nodes, nodes, sizeof(nodes));
+  memcpy(umesh->elementtypes, types, sizeof(types));
+  memcpy(umesh->elementnodes, elementnodes, sizeof(elementnodes));
+  AH5_init_uelement_index(index, umesh);
+}
+
+
+static char *test_build_ugeometry()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ugeometry_t geometry;
+  int d;
+
+  build_shapes(&umesh, &index);
+  mu_assert("build", ahh5_build_ugeometry(&geometry, &umesh, &index));
+  mu_assert_eq("elements", geometry.nb_elements, 10);
+
+  // Volumes.
+  for (d = 0; d < 3; ++d)
+    mu_assert_close("hexa centroid", geometry.centroids[d], 0.5, 1e-6);
+  mu_assert_close("hexa volume", geometry.measures[0], 1., 1e-6);
+  mu_assert_close("hexa quality", geometry.qualities[0], 1., 1e-6);
+  mu_assert_close("tetra centroid", geometry.centroids[3], 0.25, 1e-6);
+  mu_assert_close("tetra volume", geometry.measures[1], 1. / 6, 1e-6);
+  mu_assert_close("tetra quality", geometry.qualities[1], 0.70710678, 1e-6);
+  mu_assert_close("pyra volume", geometry.measures[2], 1. / 3, 1e-6);
+  mu_assert_close("pyra quality", geometry.qualities[2], 1., 1e-6);
+  mu_assert_close("penta volume", geometry.measures[3], 0.5, 1e-6);
+  mu_assert_close("penta quality", geometry.qualities[3], 0.81649658, 1e-6);
+  for (d = 0; d < 3; ++d)
+    mu_assert_close("no normal", geometry.normals[3 * 3 + d], 0., 1e-6);
+
+  // Surfaces, the quadratic tri through its corners.
+  mu_assert_close("quad area", geometry.measures[4], 1., 1e-6);
+  mu_assert_close("quad normal", geometry.normals[3 * 4 + 2], 1., 1e-6);
+  mu_assert_close("quad quality", geometry.qualities[4], 1., 1e-6);
+  mu_assert_close("tri area", geometry.measures[5], 0.5, 1e-6);
+  mu_assert_close("tri normal", geometry.normals[3 * 5 + 2], 1., 1e-6);
+  mu_assert_close("tri quality", geometry.qualities[5], 0.81649658, 1e-6);
+  mu_assert_close("tri6 area", geometry.measures[6], geometry.measures[5], 1e-6);
+  mu_assert_close("tri6 quality", geometry.qualities[6], geometry.qualities[5], 1e-6);
+  mu_assert_close("tri6 centroid", geometry.centroids[3 * 6 + 1], 1. / 3, 1e-6);
+
+  // Bar, inverted tetra and node.
+  mu_assert_close("bar length", geometry.measures[7], 2., 1e-6);
+  mu_assert_close("bar centroid", geometry.centroids[3 * 7], 1., 1e-6);
+  mu_assert_close("bar quality", geometry.qualities[7], 1., 1e-6);
+  mu_assert_close("inverted volume", geometry.measures[8], -1. / 6, 1e-6);
+  mu_assert_close("inverted quality", geometry.qualities[8], -1., 1e-6);
+  mu_assert_close("node centroid", geometry.centroids[3 * 9 + 2], 1., 1e-6);
+  mu_assert_close("node measure", geometry.measures[9], 0., 1e-6);
+  mu_assert_close("node quality", geometry.qualities[9], 1., 1e-6);
+
+  ahh5_free_ugeometry(&geometry);
+
+  // A node out of range.
+  umesh.elementnodes[42] = 10;
+  mu_assert("invalid node", !ahh5_build_ugeometry(&geometry, &umesh, &index));
+
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_ugeometry_below()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ugeometry_t geometry;
+  int elements[10];
+
+  build_shapes(&umesh, &index);
+  // Flatten the pyra.
+  umesh.nodes[3 * 8 + 2] = 0.01f;
+  ahh5_build_ugeometry(&geometry, &umesh, &index);
+
+  mu_assert_eq("below", ahh5_ugeometry_below(&geometry, 0.5, elements), 2);
+  mu_assert_eq("flat pyra", elements[0], 2);
+  mu_assert_eq("inverted tetra", elements[1], 8);
+  mu_assert_eq("count only", ahh5_ugeometry_below(&geometry, 0.9, NULL), 6);
+
+  ahh5_free_ugeometry(&geometry);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// A row of NB_ROW hexa (more than a batch) stretched along x, with a quad
+// between each two.
+static char *test_batches()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ugeometry_t geometry;
+  int i, c, *nodes;
+
+  AH5_init_umesh(&umesh, 12 * NB_ROW, 2 * NB_ROW, 4 * (NB_ROW + 1), 0, 0, 0);
+  for (i = 0; i < 4 * (NB_ROW + 1); ++i)
+  {
+    umesh.nodes[3 * i] = (float) (2 * (i / 4));
+    umesh.nodes[3 * i + 1] = (float) (i % 2);
+    umesh.nodes[3 * i + 2] = (float) ((i / 2) % 2);
+  }
+  nodes = umesh.elementnodes;
+  for (i = 0; i < NB_ROW; ++i)
+  {
+    // Nodes 4 i + y + 2 z of the slice i.
+    static const int corners[8][2] = {
+      {0, 0}, {4, 0}, {4, 1}, {0, 1}, {0, 2}, {4, 2}, {4, 3}, {0, 3}};
+
+    umesh.elementtypes[2 * i] = AH5_UELE_HEXA8;
+    for (c = 0; c < 8; ++c)
+      *nodes++ = 4 * i + corners[c][0] + corners[c][1];
+    umesh.elementtypes[2 * i + 1] = AH5_UELE_QUAD4;
+    *nodes++ = 4 * i + 4;
+    *nodes++ = 4 * i + 5;
+    *nodes++ = 4 * i + 7;
+    *nodes++ = 4 * i + 6;
+  }
+  AH5_init_uelement_index(&index, &umesh);
+
+  mu_assert("build", ahh5_build_ugeometry(&geometry, &umesh, &index));
+  for (i = 0; i < NB_ROW; ++i)
+  {
+    mu_assert_close("volume", geometry.measures[2 * i], 2., 1e-5);
+    mu_assert_close("centroid", geometry.centroids[6 * i], 2 * i + 1., 1e-4);
+    mu_assert_close("quality", geometry.qualities[2 * i], 1., 1e-6);
+    mu_assert_close("area", geometry.measures[2 * i + 1], 1., 1e-6);
+    mu_assert_close("normal", geometry.normals[3 * (2 * i + 1)], 1., 1e-6);
+  }
+
+  ahh5_free_ugeometry(&geometry);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_build_ugeometry);
+  mu_run_test(test_ugeometry_below);
+  mu_run_test(test_batches);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,203 @@
+/**
+ * @file   umesh_partition.c
+ *
+ * @brief  Test ahh5_umesh_partition.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include "umesh_fixture.h"
+#include <ahh5_umesh_partition.h>
+
+int tests_run = 0;
+
+
+#define N 4
+#define NB_PARTS 3
+
+
+// N x N x N unit hexa, a group of all the elements and a group of the nodes
+// at x = 0.
+static void build_hexa_block(AH5_umesh_t *umesh, AH5_uelement_index_t *index)
+{
+  int e;
+
+  init_hexa_block(umesh, N, 0, 0, 2);
+  AH5_init_ugroup(umesh->groups, "/mesh/g/m/group/all", N * N * N, AH5_GROUP_VOLUME);
+  for (e = 0; e < N * N * N; ++e)
+    umesh->groups[0].groupelts[e] = e;
+  AH5_init_ugroup(umesh->groups + 1, "/mesh/g/m/group/x0", (N + 1) * (N + 1), AH5_GROUP_NODE);
+  for (e = 0; e < (N + 1) * (N + 1); ++e)
+    umesh->groups[1].groupelts[e] = (N + 1) * e;
+
+  AH5_init_uelement_index(index, umesh);
+}
+
+
+// Test if two elements share a node.
+static char share_node(const AH5_umesh_t *umesh, int element1, int element2)
+{
+  int c1, c2;
+
+  for (c1 = 0; c1 < 8; ++c1)
+    for (c2 = 0; c2 < 8; ++c2)
+      if (umesh->elementnodes[8 * element1 + c1] == umesh->elementnodes[8 * element2 + c2])
+        return AH5_TRUE;
+  return AH5_FALSE;
+}
+
+
+static char *test_rcb_partition()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  int parts[N * N * N], sizes[NB_PARTS] = {0, 0, 0}, e, p;
+
+  build_hexa_block(&umesh, &index);
+  mu_assert("rcb", ahh5_umesh_rcb_partition(&umesh, &index, NB_PARTS, parts));
+  for (e = 0; e < N * N * N; ++e)
+  {
+    mu_assert("part range", parts[e] >= 0 && parts[e] < NB_PARTS);
+    sizes[parts[e]]++;
+  }
+  for (p = 0; p < NB_PARTS; ++p)
+    mu_assert("balanced", sizes[p] == N * N * N / NB_PARTS || sizes[p] == N * N * N / NB_PARTS + 1);
+
+  mu_assert("no part", !ahh5_umesh_rcb_partition(&umesh, &index, 0, parts));
+
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_split()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_umesh_part_t subs[NB_PARTS];
+  int parts[N * N * N], nb_owned = 0, nb_grouped = 0, e, p, c, global, local;
+  hsize_t i;
+
+  build_hexa_block(&umesh, &index);
+  ahh5_umesh_rcb_partition(&umesh, &index, NB_PARTS, parts);
+  mu_assert("split", ahh5_umesh_split(&umesh, &index, parts, NB_PARTS, subs));
+
+  for (p = 0; p < NB_PARTS; ++p)
+  {
+    nb_owned += (int) subs[p].nb_owned;
+    nb_grouped += (int) subs[p].umesh.groups[0].nb_groupelts;
+    mu_assert("ghosts", subs[p].nb_ghosts > 0);
+    mu_assert_eq("elements", (int) subs[p].umesh.nb_elementtypes,
+                 (int) (subs[p].nb_owned + subs[p].nb_ghosts));
+    mu_assert_str_equal("group path", subs[p].umesh.groups[0].path, umesh.groups[0].path);
+
+    for (i = 0; i < subs[p].nb_owned + subs[p].nb_ghosts; ++i)
+    {
+      global = subs[p].global_elements[i];
+      if (i < subs[p].nb_owned)
+        mu_assert_eq("owned", parts[global], p);
+      else
+      {
+        mu_assert("ghost", parts[global] != p);
+        mu_assert_eq("ghost owner", subs[p].ghost_owners[i - subs[p].nb_owned], parts[global]);
+      }
+      mu_assert_eq("local element", ahh5_part_local_element(subs + p, global), (int) i);
+
+      // The local nodes are the global ones.
+      for (c = 0; c < 8; ++c)
+      {
+        local = subs[p].umesh.elementnodes[8 * i + c];
+        mu_assert_eq("node map", subs[p].global_nodes[local], umesh.elementnodes[8 * global + c]);
+        mu_assert_eq("local node", ahh5_part_local_node(subs + p, subs[p].global_nodes[local]),
+                     local);
+        mu_assert_close("coordinates", subs[p].umesh.nodes[3 * local + 2],
+                        umesh.nodes[3 * subs[p].global_nodes[local] + 2], 1e-6);
+      }
+    }
+
+    // One layer: each ghost touches an owned element, each neighbour of an
+    // owned element is local.
+    for (e = 0; e < N * N * N; ++e)
+    {
+      local = ahh5_part_local_element(subs + p, e);
+      if (parts[e] == p)
+        continue;
+      for (i = 0; i < subs[p].nb_owned; ++i)
+        if (share_node(&umesh, e, subs[p].global_elements[i]))
+          break;
+      mu_assert("one layer", (i < subs[p].nb_owned) == (local >= 0));
+    }
+
+    // The x = 0 nodes of the part, the group is dropped when empty.
+    for (i = 0; i < subs[p].umesh.nb_groups; ++i)
+      mu_assert("non empty group", subs[p].umesh.groups[i].nb_groupelts > 0);
+    if (subs[p].umesh.nb_groups == 2)
+      for (i = 0; i < subs[p].umesh.groups[1].nb_groupelts; ++i)
+        mu_assert_close("node group", subs[p].umesh.nodes[3 * subs[p].umesh.groups[1].groupelts[i]],
+                        0., 1e-6);
+  }
+  mu_assert_eq("owned", nb_owned, N * N * N);
+  mu_assert_eq("group", nb_grouped, N * N * N);
+  mu_assert_eq("absent", ahh5_part_local_element(subs, -1), -1);
+
+  for (p = 0; p < NB_PARTS; ++p)
+    ahh5_free_umesh_part(subs + p);
+
+  parts[0] = NB_PARTS;
+  mu_assert("part out of range", !ahh5_umesh_split(&umesh, &index, parts, NB_PARTS, subs));
+
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_write_part()
+{
+  AH5_umesh_t umesh, rumesh;
+  AH5_uelement_index_t index;
+  ahh5_umesh_part_t subs[2];
+  int parts[N * N * N];
+  hid_t file_id, mesh_id;
+
+  build_hexa_block(&umesh, &index);
+  ahh5_umesh_rcb_partition(&umesh, &index, 2, parts);
+  ahh5_umesh_split(&umesh, &index, parts, 2, subs);
+
+  file_id = AH5_auto_test_file();
+  mesh_id = H5Gcreate(file_id, "part", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  mu_assert("write part", AH5_write_umesh(mesh_id, &subs[1].umesh));
+  H5Gclose(mesh_id);
+
+  mu_assert("read part", AH5_read_umesh(file_id, "/part", &rumesh));
+  mu_assert_eq("elements", (int) rumesh.nb_elementtypes, (int) (subs[1].nb_owned + subs[1].nb_ghosts));
+  mu_assert_eq("nodes", rumesh.nb_nodes[0], subs[1].umesh.nb_nodes[0]);
+  mu_assert_eq("groups", rumesh.nb_groups, subs[1].umesh.nb_groups);
+  AH5_free_umesh(&rumesh);
+  mu_assert("close", AH5_close_test_file(file_id) >= 0);
+
+  ahh5_free_umesh_part(subs);
+  ahh5_free_umesh_part(subs + 1);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_rcb_partition);
+  mu_run_test(test_split);
+  mu_run_test(test_write_part);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,248 @@
+/**
+ * @file   umesh_reorder.c
+ *
+ * @brief  Test ahh5_umesh_reorder.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include <ahh5_umesh_reorder.h>
+
+int tests_run = 0;
+
+
+#define NB_HEXA 4
+#define NB_NODES (4 * (NB_HEXA + 1))
+
+
+// A row of NB_HEXA unit hexa along x with scrambled nodes and elements, a
+// node group, an element group and two selector on mesh tables.
+static void build_hexa_row(AH5_umesh_t *umesh)
+{
+  static const int corners[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+  int i, c, node, element;
+
+  AH5_init_umesh(umesh, 8 * NB_HEXA, NB_HEXA, NB_NODES, 2, 0, 2);
+  for (i = 0; i < NB_NODES; ++i)
+  {
+    // The node x + 2 * (y + 2 * z) of the slice i / 4 is (7 * i) % NB_NODES.
+    node = (7 * i) % NB_NODES;
+    umesh->nodes[3 * node] = (float) (i / 4);
+    umesh->nodes[3 * node + 1] = (float) (i % 2);
+    umesh->nodes[3 * node + 2] = (float) ((i / 2) % 2);
+  }
+  for (i = 0; i < NB_HEXA; ++i)
+  {
+    element = (3 * i) % NB_HEXA;
+    umesh->elementtypes[element] = AH5_UELE_HEXA8;
+    for (c = 0; c < 8; ++c)
+      umesh->elementnodes[8 * element + c] =
+        (7 * (4 * (i + corners[c][0]) + corners[c][1] + 2 * corners[c][2])) % NB_NODES;
+  }
+
+  AH5_init_ugroup(umesh->groups, "/nodes", 2, AH5_GROUP_NODE);
+  umesh->groups[0].groupelts[0] = 0;
+  umesh->groups[0].groupelts[1] = 13;
+  AH5_init_ugroup(umesh->groups + 1, "/volumes", 2, AH5_GROUP_VOLUME);
+  umesh->groups[1].groupelts[0] = 1;
+  umesh->groups[1].groupelts[1] = 2;
+
+  AH5_init_usom_table(umesh->som_tables, "/pie", 1, SOM_POINT_IN_ELEMENT);
+  umesh->som_tables[0].data.pie.indices[0] = 3;
+  AH5_init_usom_table(umesh->som_tables + 1, "/faces", 1, SOM_FACE);
+  umesh->som_tables[1].data.ef.items[0] = 2;
+  umesh->som_tables[1].data.ef.items[1] = 5;
+}
+
+
+// Position key of an element (sum of x + 8 y + 64 z of its nodes).
+static float element_center(const AH5_umesh_t *umesh, int element)
+{
+  float center = 0;
+  int c;
+
+  for (c = 0; c < 8; ++c)
+    center += umesh->nodes[3 * umesh->elementnodes[8 * element + c]]
+              + 8 * umesh->nodes[3 * umesh->elementnodes[8 * element + c] + 1]
+              + 64 * umesh->nodes[3 * umesh->elementnodes[8 * element + c] + 2];
+  return center;
+}
+
+
+// Smallest and largest nodes of an element.
+static void element_range(const AH5_umesh_t *umesh, int element, int *low, int *high)
+{
+  int c;
+
+  *low = *high = umesh->elementnodes[8 * element];
+  for (c = 1; c < 8; ++c)
+  {
+    if (umesh->elementnodes[8 * element + c] < *low)
+      *low = umesh->elementnodes[8 * element + c];
+    if (umesh->elementnodes[8 * element + c] > *high)
+      *high = umesh->elementnodes[8 * element + c];
+  }
+}
+
+
+// Largest node difference in an element.
+static int bandwidth(const AH5_umesh_t *umesh)
+{
+  int element, low, high, width = 0;
+
+  for (element = 0; element < NB_HEXA; ++element)
+  {
+    element_range(umesh, element, &low, &high);
+    if (high - low > width)
+      width = high - low;
+  }
+  return width;
+}
+
+
+static char *test_renumber()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  int node_perm[NB_NODES], element_perm[NB_HEXA], i;
+  float centers[NB_HEXA], x;
+
+  build_hexa_row(&umesh);
+  AH5_init_uelement_index(&index, &umesh);
+  for (i = 0; i < NB_HEXA; ++i)
+    centers[i] = element_center(&umesh, i);
+
+  mu_assert("morton nodes", ahh5_umesh_morton_nodes(&umesh, node_perm));
+  mu_assert("morton elements", ahh5_umesh_morton_elements(&umesh, &index, element_perm));
+  AH5_free_uelement_index(&index);
+  x = umesh.nodes[3 * 13];
+  mu_assert("renumber", ahh5_umesh_renumber(&umesh, node_perm, element_perm));
+
+  // Same geometry, the elements along x.
+  for (i = 0; i < NB_HEXA; ++i)
+    mu_assert_close("geometry", element_center(&umesh, element_perm[i]), centers[i], 1e-5);
+  for (i = 1; i < NB_HEXA; ++i)
+    mu_assert("along x", element_center(&umesh, i - 1) < element_center(&umesh, i));
+
+  mu_assert_eq("node group", umesh.groups[0].groupelts[1], node_perm[13]);
+  mu_assert_close("node group", umesh.nodes[3 * umesh.groups[0].groupelts[1]], x, 1e-6);
+  mu_assert_eq("element group", umesh.groups[1].groupelts[0], element_perm[1]);
+  mu_assert_eq("pie table", umesh.som_tables[0].data.pie.indices[0], element_perm[3]);
+  mu_assert_eq("face table", umesh.som_tables[1].data.ef.items[0], element_perm[2]);
+  mu_assert_eq("face table", umesh.som_tables[1].data.ef.items[1], 5);
+
+  // Not a permutation.
+  node_perm[0] = node_perm[1];
+  mu_assert("invalid permutation", !ahh5_umesh_renumber(&umesh, node_perm, NULL));
+  mu_assert_eq("unchanged", umesh.groups[0].groupelts[1], node_perm[13]);
+
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_rcm()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  int node_perm[NB_NODES], element_perm[NB_HEXA], scrambled, i, low, previous, high;
+
+  build_hexa_row(&umesh);
+  AH5_init_uelement_index(&index, &umesh);
+  scrambled = bandwidth(&umesh);
+
+  mu_assert("rcm", ahh5_umesh_rcm_nodes(&umesh, &index, node_perm));
+  mu_assert("sort elements", ahh5_umesh_sort_elements(&umesh, &index, node_perm, element_perm));
+  AH5_free_uelement_index(&index);
+  mu_assert("renumber", ahh5_umesh_renumber(&umesh, node_perm, element_perm));
+
+  mu_assert("bandwidth", bandwidth(&umesh) < scrambled);
+  mu_assert("bandwidth", bandwidth(&umesh) <= 11);
+  for (i = 1; i < NB_HEXA; ++i)
+  {
+    element_range(&umesh, i - 1, &previous, &high);
+    element_range(&umesh, i, &low, &high);
+    mu_assert("elements by nodes", previous < low);
+  }
+
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_reorder_mesh()
+{
+  AH5_mesh_t mesh;
+  AH5_msh_group_t *group;
+  AH5_mlk_instance_t *nodes_link, *volumes_link;
+  AH5_umesh_t *umesh;
+  float x, center;
+
+  AH5_init_mesh(&mesh, 1);
+  group = mesh.groups;
+  AH5_init_msh_group(group, "/mesh/group", 1, 2);
+  AH5_init_msh_instance(group->msh_instances, "/mesh/group/row", MSH_UNSTRUCTURED);
+  umesh = &group->msh_instances->data.unstructured;
+  build_hexa_row(umesh);
+
+  // One pair per row on mesh1 and one side per row on mesh2.
+  nodes_link = group->mlk_instances;
+  AH5_init_mlk_instance(nodes_link, "/mesh/group/link/nodes", MSHLNK_NODE);
+  AH5_setpath(&nodes_link->mesh1, "/mesh/group/row");
+  AH5_setpath(&nodes_link->mesh2, "/mesh/group/other");
+  nodes_link->dims[0] = 2;
+  nodes_link->dims[1] = 2;
+  nodes_link->data = (int *) malloc(4 * sizeof(int));
+  nodes_link->data[0] = 13;
+  nodes_link->data[1] = 13;
+  nodes_link->data[2] = 1;
+  nodes_link->data[3] = 1;
+  volumes_link = group->mlk_instances + 1;
+  AH5_init_mlk_instance(volumes_link, "/mesh/group/link/volumes", MSHLNK_VOLUME);
+  AH5_setpath(&volumes_link->mesh1, "/mesh/group/other");
+  AH5_setpath(&volumes_link->mesh2, "/mesh/group/row");
+  volumes_link->dims[0] = 2;
+  volumes_link->dims[1] = 3;
+  volumes_link->data = (int *) malloc(6 * sizeof(int));
+  volumes_link->data[0] = 0;
+  volumes_link->data[1] = 1;
+  volumes_link->data[2] = 2;
+  volumes_link->data[3] = 2;
+  volumes_link->data[4] = 1;
+  volumes_link->data[5] = 0;
+
+  x = umesh->nodes[3 * 13];
+  center = element_center(umesh, 2);
+  mu_assert("reorder", ahh5_reorder_mesh(&mesh, AHH5_REORDER_RCM));
+
+  mu_assert_eq("other side", nodes_link->data[1], 13);
+  mu_assert_close("node link", umesh->nodes[3 * nodes_link->data[0]], x, 1e-6);
+  mu_assert_eq("other side", volumes_link->data[0], 0);
+  mu_assert_close("volume link", element_center(umesh, volumes_link->data[3]), center, 1e-5);
+
+  mu_assert("reorder", ahh5_reorder_mesh(&mesh, AHH5_REORDER_MORTON));
+  mu_assert_close("node link", umesh->nodes[3 * nodes_link->data[0]], x, 1e-6);
+  mu_assert_close("volume link", element_center(umesh, volumes_link->data[3]), center, 1e-5);
+
+  AH5_free_mesh(&mesh);
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_renumber);
+  mu_run_test(test_rcm);
+  mu_run_test(test_reorder_mesh);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,279 @@
+/**
+ * @file   umesh_topo.c
+ *
+ * @brief  Test ahh5_umesh_topo.h
+ *
+ *
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include "utest.h"
+#include "umesh_fixture.h"
+#include <ahh5_umesh_topo.h>
+
+int tests_run = 0;
+
+
+// Two tetra sharing the face (1, 2, 3) and a tri on that face.
+static void build_two_tetra(AH5_umesh_t *umesh, AH5_uelement_index_t *index)
+{
+  int elementnodes[11] = {0, 1, 2, 3, 1, 2, 3, 4, 1, 2, 3};
+  char elementtypes[3] = {AH5_UELE_TETRA4, AH5_UELE_TETRA4, AH5_UELE_TRI3};
+  hsize_t i;
+
+  AH5_init_umesh(umesh, 11, 3, 5, 0, 0, 0);
+  memcpy(umesh->elementnodes, elementnodes, sizeof(elementnodes));
+  memcpy(umesh->elementtypes, elementtypes, sizeof(elementtypes));
+  for (i = 0; i < 15; ++i)
+    umesh->nodes[i] = (float) i;
+  AH5_init_uelement_index(index, umesh);
+}
+
+
+static char *test_build_node_elements()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_node_elements_t adjacency;
+
+  build_two_tetra(&umesh, &index);
+  mu_assert("build node elements", ahh5_build_node_elements(&umesh, &index, &adjacency));
+  mu_assert_eq("nb nodes", adjacency.nb_nodes, 5);
+  mu_assert_eq("node 0", (int) (adjacency.offsets[1] - adjacency.offsets[0]), 1);
+  mu_assert_eq("node 0", adjacency.elements[adjacency.offsets[0]], 0);
+  mu_assert_eq("node 1", (int) (adjacency.offsets[2] - adjacency.offsets[1]), 3);
+  mu_assert_eq("node 1", adjacency.elements[adjacency.offsets[1]], 0);
+  mu_assert_eq("node 1", adjacency.elements[adjacency.offsets[1] + 1], 1);
+  mu_assert_eq("node 1", adjacency.elements[adjacency.offsets[1] + 2], 2);
+  mu_assert_eq("node 4", (int) (adjacency.offsets[5] - adjacency.offsets[4]), 1);
+  mu_assert_eq("node 4", adjacency.elements[adjacency.offsets[4]], 1);
+  mu_assert_eq("total", adjacency.offsets[5], 11);
+  ahh5_free_node_elements(&adjacency);
+
+  // Out of range node.
+  umesh.elementnodes[7] = 5;
+  mu_assert("out of range node", !ahh5_build_node_elements(&umesh, &index, &adjacency));
+  mu_assert("out of range node", adjacency.offsets == NULL);
+
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_build_uedges()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_uedges_t edges;
+  int e;
+
+  build_two_tetra(&umesh, &index);
+  mu_assert("build edges", ahh5_build_uedges(&umesh, &index, &edges));
+  mu_assert_eq("nb edges", edges.nb_edges, 9);
+  mu_assert_eq("offsets", edges.offsets[3], 15);
+  // first edge of the first tetra
+  mu_assert_eq("edge 0", edges.nodes[0], 0);
+  mu_assert_eq("edge 0", edges.nodes[1], 1);
+  // second tetra edges (1, 2), (2, 3), (3, 1) are shared
+  mu_assert_eq("shared edge", edges.element_edges[6], 1);
+  mu_assert_eq("shared edge", edges.element_edges[7], 5);
+  mu_assert_eq("shared edge", edges.element_edges[8], 4);
+  e = edges.element_edges[9];
+  mu_assert_eq("new edge", e, 6);
+  mu_assert_eq("new edge", edges.nodes[2 * e], 1);
+  mu_assert_eq("new edge", edges.nodes[2 * e + 1], 4);
+  // the tri edges
+  mu_assert_eq("tri edges", edges.element_edges[12], 1);
+  mu_assert_eq("tri edges", edges.element_edges[13], 5);
+  mu_assert_eq("tri edges", edges.element_edges[14], 4);
+
+  ahh5_free_uedges(&edges);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+static char *test_build_ufaces()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_ufaces_t faces;
+  hsize_t f;
+  int nb_boundary = 0;
+
+  build_two_tetra(&umesh, &index);
+  mu_assert("build faces", ahh5_build_ufaces(&umesh, &index, &faces));
+  mu_assert_eq("nb faces", faces.nb_faces, 7);
+  mu_assert_eq("offsets", faces.offsets[3], 9);
+  mu_assert_eq("face offsets", faces.face_offsets[7], 21);
+
+  // first face of the first tetra, oriented as in the element
+  mu_assert_eq("face 0", faces.face_nodes[0], 0);
+  mu_assert_eq("face 0", faces.face_nodes[1], 2);
+  mu_assert_eq("face 0", faces.face_nodes[2], 1);
+
+  // the shared face
+  mu_assert_eq("shared face", faces.element_faces[2], 2);
+  mu_assert_eq("shared face", faces.element_faces[4], 2);
+  mu_assert_eq("shared face", faces.element_faces[8], 2);
+  mu_assert_eq("shared face", faces.face_elements[4], 0);
+  mu_assert_eq("shared face", faces.face_elements[5], 1);
+  mu_assert_eq("shared face", faces.face_nodes[faces.face_offsets[2]], 1);
+  mu_assert_eq("shared face", faces.face_nodes[faces.face_offsets[2] + 1], 2);
+  mu_assert_eq("shared face", faces.face_nodes[faces.face_offsets[2] + 2], 3);
+
+  for (f = 0; f < faces.nb_faces; ++f)
+    if (faces.face_elements[2 * f + 1] == -1)
+      ++nb_boundary;
+  mu_assert_eq("boundary faces", nb_boundary, 6);
+
+  ahh5_free_ufaces(&faces);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// Test the ids are numbered in first occurrence order.
+static char first_occurrence_order(const int *ids, hsize_t nb_ids, hsize_t nb_unique)
+{
+  hsize_t k;
+  int next = 0;
+
+  for (k = 0; k < nb_ids; ++k)
+  {
+    if (ids[k] > next || ids[k] < 0)
+      return AH5_FALSE;
+    if (ids[k] == next)
+      ++next;
+  }
+  return (hsize_t) next == nb_unique;
+}
+
+
+// A block of hexa spreads its keys over all the hash buckets.
+static char *test_hexa_block()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  ahh5_node_elements_t adjacency;
+  ahh5_uedges_t edges;
+  ahh5_ufaces_t faces;
+  hsize_t i, f, nb_boundary = 0;
+  const int n = 6;
+
+  init_hexa_block(&umesh, n, 0, 0, 0);
+  AH5_init_uelement_index(&index, &umesh);
+
+  mu_assert("build adjacency", ahh5_build_node_elements(&umesh, &index, &adjacency));
+  mu_assert_eq("adjacency size", (int) adjacency.offsets[adjacency.nb_nodes], 8 * n * n * n);
+  for (i = 0; i < adjacency.nb_nodes; ++i)
+    for (f = adjacency.offsets[i] + 1; f < adjacency.offsets[i + 1]; ++f)
+      mu_assert("sorted elements", adjacency.elements[f - 1] < adjacency.elements[f]);
+  mu_assert_eq("inner node", (int) (adjacency.offsets[58] - adjacency.offsets[57]), 8);
+
+  mu_assert("build edges", ahh5_build_uedges(&umesh, &index, &edges));
+  mu_assert_eq("nb edges", (int) edges.nb_edges, 3 * n * (n + 1) * (n + 1));
+  mu_assert("edges order", first_occurrence_order(edges.element_edges, edges.offsets[n * n * n],
+                                                  edges.nb_edges));
+  mu_assert_eq("first edge", edges.nodes[0], 0);
+  mu_assert_eq("first edge", edges.nodes[1], 1);
+
+  mu_assert("build faces", ahh5_build_ufaces(&umesh, &index, &faces));
+  mu_assert_eq("nb faces", (int) faces.nb_faces, 3 * n * n * (n + 1));
+  mu_assert("faces order", first_occurrence_order(faces.element_faces, faces.offsets[n * n * n],
+                                                  faces.nb_faces));
+  for (f = 0; f < faces.nb_faces; ++f)
+  {
+    mu_assert_eq("face size", (int) (faces.face_offsets[f + 1] - faces.face_offsets[f]), 4);
+    if (faces.face_elements[2 * f + 1] == -1)
+      ++nb_boundary;
+    else
+      mu_assert("face elements", faces.face_elements[2 * f] < faces.face_elements[2 * f + 1]);
+  }
+  mu_assert_eq("boundary faces", (int) nb_boundary, 6 * n * n);
+  // the face x = 1 of the first hexa is shared with the next one
+  mu_assert_eq("shared face", faces.face_elements[2 * faces.element_faces[3] + 1], 1);
+
+  ahh5_free_ufaces(&faces);
+  ahh5_free_uedges(&edges);
+  ahh5_free_node_elements(&adjacency);
+  AH5_free_uelement_index(&index);
+  AH5_free_umesh(&umesh);
+  return NULL;
+}
+
+
+// Sum the signed volumes (x6) of the tetrahedra of an element, count the
+// negative ones.
+static double tetras_volume(char type, const double (*xyz)[3], int *nb_negative)
+{
+  const int (*tetras)[4];
+  double e[3][3], det, volume = 0;
+  int t, i, d, nb_tetras;
+
+  *nb_negative = 0;
+  nb_tetras = ahh5_uelement_tetras(type, &tetras);
+  for (t = 0; t < nb_tetras; ++t)
+  {
+    for (i = 0; i < 3; ++i)
+      for (d = 0; d < 3; ++d)
+        e[i][d] = xyz[tetras[t][i + 1]][d] - xyz[tetras[t][0]][d];
+    det = e[0][0] * (e[1][1] * e[2][2] - e[1][2] * e[2][1])
+          - e[0][1] * (e[1][0] * e[2][2] - e[1][2] * e[2][0])
+          + e[0][2] * (e[1][0] * e[2][1] - e[1][1] * e[2][0]);
+    if (det <= 0)
+      ++*nb_negative;
+    volume += det;
+  }
+  return volume;
+}
+
+
+static char *test_uelement_tetras()
+{
+  static const double tetra[4][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  static const double pyra[5][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0.5, 0.5, 1}};
+  static const double penta[6][3] = {
+    {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {0, 1, 1}};
+  static const double hexa[8][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+  const int (*tetras)[4];
+  int nb_negative;
+
+  mu_assert_close("tetra", tetras_volume(AH5_UELE_TETRA4, tetra, &nb_negative), 1., 1e-12);
+  mu_assert_eq("tetra", nb_negative, 0);
+  mu_assert_close("tetra10", tetras_volume(AH5_UELE_TETRA10, tetra, &nb_negative), 1., 1e-12);
+  mu_assert_close("pyra", tetras_volume(AH5_UELE_PYRA5, pyra, &nb_negative), 2., 1e-12);
+  mu_assert_eq("pyra", nb_negative, 0);
+  mu_assert_close("penta", tetras_volume(AH5_UELE_PENTA6, penta, &nb_negative), 3., 1e-12);
+  mu_assert_eq("penta", nb_negative, 0);
+  mu_assert_close("hexa", tetras_volume(AH5_UELE_HEXA8, hexa, &nb_negative), 6., 1e-12);
+  mu_assert_eq("hexa", nb_negative, 0);
+  mu_assert_close("hexa20", tetras_volume(AH5_UELE_HEXA20, hexa, &nb_negative), 6., 1e-12);
+
+  mu_assert_eq("quad", ahh5_uelement_tetras(AH5_UELE_QUAD4, &tetras), 0);
+  mu_assert("quad", tetras == NULL);
+
+  return NULL;
+}
+
+
+// Make a function for run all tests.
+static char *all_tests()
+{
+  mu_run_test(test_build_node_elements);
+  mu_run_test(test_build_uedges);
+  mu_run_test(test_build_ufaces);
+  mu_run_test(test_hexa_block);
+  mu_run_test(test_uelement_tetras);
+
+  return NULL; // And do not forget to return NULL at end to say success.
+}
+
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -78,7 +78,6 @@ char AH5_read_flt_attr(hid_t loc_id, const char *path, const char *attr_name, fl
 char AH5_read_cpx_attr(hid_t loc_id, const char *path, const char *attr_name, AH5_complex_t *rdata)
 {
   hid_t attr_id, type_id;
-  float buf[2];
   char success = AH5_FALSE;
 
   if (AH5_path_valid(loc_id, path))
@@ -86,11 +85,8 @@ char AH5_read_cpx_attr(hid_t loc_id, const char *path, const char *attr_name, AH
     {
       attr_id = H5Aopen_by_name(loc_id, path, attr_name, H5P_DEFAULT, H5P_DEFAULT);
       type_id = AH5_H5Tcreate_cpx_memtype();
-      if (H5Aread(attr_id, type_id, buf) >= 0)
-      {
-        *rdata = AH5_set_complex(buf[0], buf[1]);
+      if (H5Aread(attr_id, type_id, rdata) >= 0)
         success = AH5_TRUE;
-      }
       H5Tclose(type_id);
       H5Aclose(attr_id);
     }
@@ -161,7 +157,6 @@ char AH5_read_opt_attrs(hid_t loc_id, const char *path, AH5_opt_attrs_t *opt_att
   H5O_info_t object_info;
   hsize_t i, j, k = 0;
   hid_t attr_id, type_id;
-  float buf[2];
   hsize_t nb_present_mandatory_attrs = 0;
   char temp_name[AH5_ATTR_LENGTH];
 
@@ -206,11 +201,8 @@ char AH5_read_opt_attrs(hid_t loc_id, const char *path, AH5_opt_attrs_t *opt_att
         case H5T_COMPOUND:
           opt_attrs->instances[k].value.c = AH5_set_complex(0, 0);
           type_id = AH5_H5Tcreate_cpx_memtype();
-          if (H5Aread(attr_id, type_id, buf) >= 0)
-          {
-            opt_attrs->instances[k].value.c = AH5_set_complex(buf[0], buf[1]);
+          if (H5Aread(attr_id, type_id, &(opt_attrs->instances[k].value.c)) >= 0)
             success = AH5_TRUE;
-          }
           H5Tclose(type_id);
           break;
         case H5T_STRING:
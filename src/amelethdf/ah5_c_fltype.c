@@ -150,7 +150,18 @@ AH5_dataset_t *AH5_init_ft_dataset(
         data_size *= dims[i];
 
       flt->type_class = type_class;
-      AH5_init_datasetx(&flt->values, data_size, type_class);
+      flt->values.f = NULL;
+      switch (type_class)
+      {
+        case AH5_TYPE_FLOAT:
+          flt->values.f = (float*)AH5_alloc(data_size * sizeof(float));
+          break;
+        case AH5_TYPE_INTEGER:
+          flt->values.i = (int*)AH5_alloc(data_size * sizeof(int));
+          break;
+        default:
+          break;
+      }
     }
   }
 
@@ -197,6 +208,7 @@ AH5_arrayset_t *AH5_init_ft_arrayset(
         snprintf(flt->dims[i].path, 5, "dim%d", i+1);
         flt->dims[i].nb_values = dims[nb_dims-i-1];
         flt->dims[i].values.f = NULL;
+        AH5_init_opt_attrs(&flt->dims[i].opt_attrs, 0);
       }
     }
   }
@@ -737,11 +749,12 @@ char AH5_read_ft_rational (hid_t file_id, const char *path, AH5_rational_t *rati
 }
 
 
-// Read dataset, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
-char AH5_read_ft_dataset (hid_t file_id, const char *path, AH5_dataset_t *dataset)
+// Read dataset, into the l, d and z values if wide, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+static char AH5_read_ft_dataset_ex (hid_t file_id, const char *path, char wide,
+                                    AH5_dataset_t *dataset)
 {
   char mandatory[][AH5_ATTR_LENGTH] = {AH5_A_FLOATING_TYPE};
-  hsize_t total_size = 1;
+  hsize_t total_size = 1, j;
   char rdata = AH5_FALSE;
   size_t length;
   int i;
@@ -754,27 +767,68 @@ char AH5_read_ft_dataset (hid_t file_id, const char *path, AH5_dataset_t *datase
       {
         for (i = 0; i < dataset->nb_dims; i++)
           total_size *= dataset->dims[i];
+        dataset->values.f = NULL;
         switch (dataset->type_class)
         {
         case H5T_INTEGER:
-          if (AH5_read_int_dataset(file_id, path, total_size, &(dataset->values.i)))
+          if (wide)
+          {
+            dataset->values.l = (int64_t *) AH5_alloc((size_t) total_size * sizeof(int64_t));
+            if (AH5_read_i64_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.l))
+              rdata = AH5_TRUE;
+            break;
+          }
+          dataset->values.i = (int *) AH5_alloc((size_t) total_size * sizeof(int));
+          if (AH5_read_int_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.i))
             rdata = AH5_TRUE;
           break;
         case H5T_FLOAT:
-          if (AH5_read_flt_dataset(file_id, path, total_size, &(dataset->values.f)))
+          if (wide)
+          {
+            dataset->values.d = (double *) AH5_alloc((size_t) total_size * sizeof(double));
+            if (AH5_read_dbl_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.d))
+              rdata = AH5_TRUE;
+            break;
+          }
+          dataset->values.f = (float *) AH5_alloc((size_t) total_size * sizeof(float));
+          if (AH5_read_flt_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.f))
             rdata = AH5_TRUE;
           break;
         case H5T_COMPOUND:
-          if (AH5_read_cpx_dataset(file_id, path, total_size, &(dataset->values.c)))
+          if (wide)
+          {
+            dataset->values.z = (AH5_dcomplex_t *) AH5_alloc((size_t) total_size * sizeof(AH5_dcomplex_t));
+            if (AH5_read_dcpx_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.z))
+              rdata = AH5_TRUE;
+            break;
+          }
+          dataset->values.c = (AH5_complex_t *) AH5_alloc((size_t) total_size * sizeof(AH5_complex_t));
+          if (AH5_read_cpx_dataset_into(file_id, path, total_size, H5P_DEFAULT, dataset->values.c))
             rdata = AH5_TRUE;
           break;
         case H5T_STRING:
-          if (AH5_read_str_dataset(file_id, path, total_size, length, &(dataset->values.s)))
+          dataset->values.s = (char **) AH5_alloc((size_t) total_size * sizeof(char *));
+          if (dataset->values.s == NULL)
+            break;
+          dataset->values.s[0] = (char *) AH5_alloc((size_t) total_size * (length + 1) * sizeof(char));
+          if (dataset->values.s[0] == NULL)
+            break;
+          for (j = 1; j < total_size; j++)
+            dataset->values.s[j] = dataset->values.s[0] + j * (length + 1);
+          if (AH5_read_str_dataset_into(file_id, path, total_size, length, H5P_DEFAULT,
+                                        dataset->values.s[0]))
             rdata = AH5_TRUE;
+          else
+            AH5_release(dataset->values.s[0]);
           break;
         default:
           break;
         }
+        if (!rdata)  // all the members of values share the same address
+        {
+          AH5_release(dataset->values.f);
+          dataset->values.f = NULL;
+        }
       }
       if (!rdata)
         free(dataset->dims);
@@ -791,8 +845,108 @@ char AH5_read_ft_dataset (hid_t file_id, const char *path, AH5_dataset_t *datase
 }
 
 
-// Read arraySet, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
-char AH5_read_ft_arrayset (hid_t file_id, const char *path, AH5_arrayset_t *arrayset)
+// Read dataset, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+char AH5_read_ft_dataset (hid_t file_id, const char *path, AH5_dataset_t *dataset)
+{
+  return AH5_read_ft_dataset_ex(file_id, path, AH5_FALSE, dataset);
+}
+
+
+// Read dataset in 64-bit values, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+char AH5_read_ft_dataset_wide (hid_t file_id, const char *path, AH5_dataset_t *dataset)
+{
+  return AH5_read_ft_dataset_ex(file_id, path, AH5_TRUE, dataset);
+}
+
+
+// Read a part of a dataset, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+char AH5_read_ft_dataset_slab (hid_t file_id, const char *path, const hsize_t *start,
+                               const hsize_t *count, const hsize_t *stride,
+                               AH5_dataset_t *dataset)
+{
+  char mandatory[][AH5_ATTR_LENGTH] = {AH5_A_FLOATING_TYPE};
+  hsize_t total_size = 1, j;
+  char rdata = AH5_FALSE;
+  size_t length;
+  int i, nb_dims;
+
+  dataset->nb_dims = 0;
+  dataset->dims = NULL;
+  dataset->values.f = NULL;
+  if (AH5_path_valid(file_id, path)
+      && H5LTget_dataset_ndims(file_id, path, &nb_dims) >= 0 && nb_dims > 0)
+  {
+    dataset->dims = (hsize_t *) malloc(nb_dims * sizeof(hsize_t));
+    if (H5LTget_dataset_info(file_id, path, dataset->dims, &(dataset->type_class), &length) >= 0)
+    {
+      for (i = 0; i < nb_dims; i++)
+      {
+        dataset->dims[i] = count[i];
+        total_size *= count[i];
+      }
+      switch (dataset->type_class)
+      {
+      case H5T_INTEGER:
+        dataset->values.i = (int *) AH5_alloc((size_t) total_size * sizeof(int));
+        rdata = AH5_read_int_slab(file_id, path, nb_dims, start, count, stride,
+                                  dataset->values.i);
+        break;
+      case H5T_FLOAT:
+        dataset->values.f = (float *) AH5_alloc((size_t) total_size * sizeof(float));
+        rdata = AH5_read_flt_slab(file_id, path, nb_dims, start, count, stride,
+                                  dataset->values.f);
+        break;
+      case H5T_COMPOUND:
+        dataset->values.c = (AH5_complex_t *) AH5_alloc((size_t) total_size * sizeof(AH5_complex_t));
+        rdata = AH5_read_cpx_slab(file_id, path, nb_dims, start, count, stride,
+                                  dataset->values.c);
+        break;
+      case H5T_STRING:
+        dataset->values.s = (char **) AH5_alloc((size_t) total_size * sizeof(char *));
+        if (dataset->values.s == NULL)
+          break;
+        dataset->values.s[0] = (char *) AH5_alloc((size_t) total_size * (length + 1) * sizeof(char));
+        if (dataset->values.s[0] == NULL)
+          break;
+        for (j = 1; j < total_size; j++)
+          dataset->values.s[j] = dataset->values.s[0] + j * (length + 1);
+        rdata = AH5_read_str_slab(file_id, path, nb_dims, start, count, stride, length,
+                                  dataset->values.s[0]);
+        if (!rdata)
+          AH5_release(dataset->values.s[0]);
+        break;
+      default:
+        break;
+      }
+      if (!rdata)  // all the members of values share the same address
+      {
+        AH5_release(dataset->values.f);
+        dataset->values.f = NULL;
+      }
+    }
+    if (rdata)
+      dataset->nb_dims = nb_dims;
+    else
+    {
+      free(dataset->dims);
+      dataset->dims = NULL;
+    }
+  }
+  if (rdata)
+  {
+    dataset->path = strdup(path);
+    AH5_read_opt_attrs(file_id, path, &(dataset->opt_attrs), mandatory,
+                       sizeof(mandatory)/AH5_ATTR_LENGTH);
+  }
+  else
+    AH5_print_err_dset("", path);
+  return rdata;
+}
+
+
+// Read arraySet, into the l, d and z values if wide, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+static char AH5_read_ft_arrayset_ex (hid_t file_id, const char *path, char wide,
+                                     AH5_arrayset_t *arrayset)
 {
   char mandatory[][AH5_ATTR_LENGTH] = {AH5_A_FLOATING_TYPE};
   char *path2;
@@ -804,7 +958,7 @@ char AH5_read_ft_arrayset (hid_t file_id, const char *path, AH5_arrayset_t *arra
   path2 = malloc((strlen(path) + strlen(AH5_G_DATA) + 1) * sizeof(*path2));
   strncpy(path2, path, strlen(path) + 1);
   strncat(path2, AH5_G_DATA, strlen(AH5_G_DATA));
-  if (AH5_read_ft_dataset(file_id, path2, &(arrayset->data)))
+  if (AH5_read_ft_dataset_ex(file_id, path2, wide, &(arrayset->data)))
   {
     strncpy(path2, path, strlen(path) + 1);
     strncat(path2, AH5_G_DS, strlen(AH5_G_DS));
@@ -851,6 +1005,20 @@ char AH5_read_ft_arrayset (hid_t file_id, const char *path, AH5_arrayset_t *arra
   return rdata;
 }
 
+
+// Read arraySet, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+char AH5_read_ft_arrayset (hid_t file_id, const char *path, AH5_arrayset_t *arrayset)
+{
+  return AH5_read_ft_arrayset_ex(file_id, path, AH5_FALSE, arrayset);
+}
+
+
+// Read arraySet in 64-bit values, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
+char AH5_read_ft_arrayset_wide (hid_t file_id, const char *path, AH5_arrayset_t *arrayset)
+{
+  return AH5_read_ft_arrayset_ex(file_id, path, AH5_TRUE, arrayset);
+}
+
 // Read floatingType structure, return AH5_TRUE (all OK) or AH5_FALSE (no malloc)
 char AH5_read_floatingtype(hid_t file_id, const char *path, AH5_ft_t *floatingtype)
 {
@@ -1193,7 +1361,8 @@ char AH5_write_ft_rational (hid_t UNUSED(file_id), AH5_rational_t *rational)
   return success;
 }
 
-char AH5_write_ft_dataset (hid_t file_id, AH5_dataset_t *dataset)
+// Write dataset, from the l, d and z values if wide
+static char AH5_write_ft_dataset_ex (hid_t file_id, AH5_dataset_t *dataset, char wide)
 {
   char success = AH5_FALSE;
   hsize_t total_size = 1;
@@ -1203,15 +1372,24 @@ char AH5_write_ft_dataset (hid_t file_id, AH5_dataset_t *dataset)
     for (i = 0; i < dataset->nb_dims; ++i) total_size *= dataset->dims[i];
     switch (dataset->type_class) {
     case H5T_INTEGER:
-      if (AH5_write_int_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.i))
+      if (wide)
+        success = AH5_write_i64_array(file_id, dataset->path, dataset->nb_dims, dataset->dims,
+                                      dataset->values.l);
+      else if (AH5_write_int_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.i))
         success = AH5_TRUE;
       break;
     case H5T_FLOAT:
-      if (AH5_write_flt_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.f))
+      if (wide)
+        success = AH5_write_dbl_array(file_id, dataset->path, dataset->nb_dims, dataset->dims,
+                                      dataset->values.d);
+      else if (AH5_write_flt_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.f))
         success = AH5_TRUE;
       break;
     case H5T_COMPOUND:
-      if (AH5_write_cpx_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.c))
+      if (wide)
+        success = AH5_write_dcpx_array(file_id, dataset->path, dataset->nb_dims, dataset->dims,
+                                       dataset->values.z);
+      else if (AH5_write_cpx_array(file_id, dataset->path, dataset->nb_dims, dataset->dims, dataset->values.c))
         success = AH5_TRUE;
       break;
     case H5T_STRING:
@@ -1236,7 +1414,18 @@ char AH5_write_ft_dataset (hid_t file_id, AH5_dataset_t *dataset)
   return success;
 }
 
-char AH5_write_ft_arrayset (hid_t file_id, AH5_arrayset_t *arrayset)
+char AH5_write_ft_dataset (hid_t file_id, AH5_dataset_t *dataset)
+{
+  return AH5_write_ft_dataset_ex(file_id, dataset, AH5_FALSE);
+}
+
+char AH5_write_ft_dataset_wide (hid_t file_id, AH5_dataset_t *dataset)
+{
+  return AH5_write_ft_dataset_ex(file_id, dataset, AH5_TRUE);
+}
+
+// Write arraySet, from the l, d and z values of the data if wide
+static char AH5_write_ft_arrayset_ex (hid_t file_id, AH5_arrayset_t *arrayset, char wide)
 {
   char success = AH5_FALSE;
 
@@ -1265,7 +1454,7 @@ char AH5_write_ft_arrayset (hid_t file_id, AH5_arrayset_t *arrayset)
       tmp = arrayset->data.path;
       arrayset->data.path = path2;
 
-      if (AH5_write_ft_dataset(file_id, &(arrayset->data)))
+      if (AH5_write_ft_dataset_ex(file_id, &(arrayset->data), wide))
       {
         path2 = malloc((strlen(arrayset->path) + strlen(AH5_G_DS) + 7) * sizeof(*path2));
         strcpy(path2, arrayset->path);
@@ -1306,6 +1495,16 @@ char AH5_write_ft_arrayset (hid_t file_id, AH5_arrayset_t *arrayset)
   return success;
 }
 
+char AH5_write_ft_arrayset (hid_t file_id, AH5_arrayset_t *arrayset)
+{
+  return AH5_write_ft_arrayset_ex(file_id, arrayset, AH5_FALSE);
+}
+
+char AH5_write_ft_arrayset_wide (hid_t file_id, AH5_arrayset_t *arrayset)
+{
+  return AH5_write_ft_arrayset_ex(file_id, arrayset, AH5_TRUE);
+}
+
 char AH5_write_floatingtype (hid_t file_id, AH5_ft_t *floatingtype)
 {
   switch (floatingtype->type)
@@ -1553,8 +1752,8 @@ void AH5_print_ft_rational (const AH5_rational_t *rational, int space)
 }
 
 
-// Print dataset
-void AH5_print_ft_dataset (const AH5_dataset_t *dataset, int space)
+// Print dataset, the l, d and z values if wide
+static void AH5_print_ft_dataset_ex (const AH5_dataset_t *dataset, int space, char wide)
 {
   hsize_t i, total = 1;
   int j;
@@ -1571,25 +1770,31 @@ void AH5_print_ft_dataset (const AH5_dataset_t *dataset, int space)
   switch (dataset->type_class)
   {
   case H5T_INTEGER:
-    for (i = 0; i < total - 1; i++)
+    for (i = 0; i < total; i++)
     {
-      printf("%i, ", dataset->values.i[i]);
+      if (wide)
+        printf("%li", (long) dataset->values.l[i]);
+      else
+        printf("%i", dataset->values.i[i]);
+      printf((i < total - 1) ? ", " : "}\n");
     }
-    printf("%i}\n", dataset->values.i[total - 1]);
     break;
   case H5T_FLOAT:
-    for (i = 0; i < total - 1; i++)
+    for (i = 0; i < total; i++)
     {
-      printf("%g, ", dataset->values.f[i]);
+      printf("%g", wide ? dataset->values.d[i] : dataset->values.f[i]);
+      printf((i < total - 1) ? ", " : "}\n");
     }
-    printf("%g}\n", dataset->values.f[total - 1]);
     break;
   case H5T_COMPOUND:
-    for (i = 0; i < total - 1; i++)
+    for (i = 0; i < total; i++)
     {
-      printf("%g%+gi, ", creal(dataset->values.c[i]), cimag(dataset->values.c[i]));
+      if (wide)
+        printf("%g%+gi", creal(dataset->values.z[i]), cimag(dataset->values.z[i]));
+      else
+        printf("%g%+gi", creal(dataset->values.c[i]), cimag(dataset->values.c[i]));
+      printf((i < total - 1) ? ", " : "}\n");
     }
-    printf("%g%+gi}\n", creal(dataset->values.c[total - 1]), cimag(dataset->values.c[total - 1]));
     break;
   case H5T_STRING:
     if (dataset->values.s != NULL)
@@ -1607,6 +1812,18 @@ void AH5_print_ft_dataset (const AH5_dataset_t *dataset, int space)
   AH5_print_opt_attrs(&(dataset->opt_attrs), space + 3);
 }
 
+// Print dataset
+void AH5_print_ft_dataset (const AH5_dataset_t *dataset, int space)
+{
+  AH5_print_ft_dataset_ex(dataset, space, AH5_FALSE);
+}
+
+// Print dataset of 64-bit values
+void AH5_print_ft_dataset_wide (const AH5_dataset_t *dataset, int space)
+{
+  AH5_print_ft_dataset_ex(dataset, space, AH5_TRUE);
+}
+
 
 // Print arrayset
 void AH5_print_ft_arrayset (const AH5_arrayset_t *arrayset, int space)
@@ -1962,28 +2179,29 @@ void AH5_free_ft_dataset (AH5_dataset_t *dataset)
   case H5T_INTEGER:
     if (dataset->values.i != NULL)
     {
-      free(dataset->values.i);
+      AH5_release(dataset->values.i);
       dataset->values.i = NULL;
     }
     break;
   case H5T_FLOAT:
     if (dataset->values.f != NULL)
     {
-      free(dataset->values.f);
+      AH5_release(dataset->values.f);
       dataset->values.f = NULL;
     }
     break;
   case H5T_COMPOUND:
     if (dataset->values.c != NULL)
     {
-      free(dataset->values.c);
+      AH5_release(dataset->values.c);
       dataset->values.c = NULL;
     }
     break;
   case H5T_STRING:
     if (dataset->values.s != NULL)
     {
-      free(dataset->values.s);
+      AH5_release(dataset->values.s[0]);
+      AH5_release(dataset->values.s);
       dataset->values.s = NULL;
     }
     break;
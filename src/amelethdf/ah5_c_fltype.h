@@ -64,6 +64,9 @@ typedef union _AH5_datasetx_t
   float           *f;
   AH5_complex_t   *c;
   char            **s;
+  int64_t         *l;
+  double          *d;
+  AH5_dcomplex_t  *z;
 } AH5_datasetx_t;
 
 typedef struct _AH5_vector_t
@@ -239,7 +242,39 @@ AH5_PUBLIC char AH5_read_ft_generalrationalfunction (hid_t file_id, const char *
     AH5_generalrationalfunction_t *generalrationalfunction);
 AH5_PUBLIC char AH5_read_ft_rational (hid_t file_id, const char *path, AH5_rational_t *rational);
 AH5_PUBLIC char AH5_read_ft_dataset (hid_t file_id, const char *path, AH5_dataset_t *dataset);
+/**
+ * Read a hyperslab of a floatingType dataset.
+ *
+ * The dataset is filled like AH5_read_ft_dataset but its dims are the
+ * selection count and its values the selected values only.
+ *
+ * @param file_id the file or a parent node
+ * @param path the dataset path
+ * @param start the offset of the first value along each dimension
+ * @param count the number of values to read along each dimension
+ * @param stride the step between two values along each dimension or NULL
+ * @param dataset the read dataset
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_ft_dataset_slab (hid_t file_id, const char *path, const hsize_t *start,
+    const hsize_t *count, const hsize_t *stride, AH5_dataset_t *dataset);
 AH5_PUBLIC char AH5_read_ft_arrayset (hid_t file_id, const char *path, AH5_arrayset_t *arrayset);
+/**
+ * Read a floatingType dataset (or arraySet) in 64-bit values.
+ *
+ * The integers, reals and complex values are read into values.l, values.d
+ * and values.z (without conversion for the 64-bit values of the file), the
+ * strings are read like AH5_read_ft_dataset. Such a dataset is written with
+ * AH5_write_ft_dataset_wide (AH5_write_ft_arrayset_wide for an arraySet) and
+ * printed with AH5_print_ft_dataset_wide.
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_ft_dataset_wide (hid_t file_id, const char *path,
+    AH5_dataset_t *dataset);
+AH5_PUBLIC char AH5_read_ft_arrayset_wide (hid_t file_id, const char *path,
+    AH5_arrayset_t *arrayset);
 AH5_PUBLIC char AH5_read_floatingtype (hid_t file_id, const char *path, AH5_ft_t *floatingtype);
 
 
@@ -264,7 +299,11 @@ AH5_PUBLIC char AH5_write_ft_generalrationalfunction (hid_t file_id,
     AH5_generalrationalfunction_t *generalrationalfunction);
 AH5_PUBLIC char AH5_write_ft_rational (hid_t file_id, AH5_rational_t *rational);
 AH5_PUBLIC char AH5_write_ft_dataset (hid_t file_id, AH5_dataset_t *dataset);
+// Write the values.l, values.d or values.z of a dataset (64-bit values in the file).
+AH5_PUBLIC char AH5_write_ft_dataset_wide (hid_t file_id, AH5_dataset_t *dataset);
 AH5_PUBLIC char AH5_write_ft_arrayset (hid_t file_id, AH5_arrayset_t *arrayset);
+// Write an arraySet with the values.l, values.d or values.z of its data.
+AH5_PUBLIC char AH5_write_ft_arrayset_wide (hid_t file_id, AH5_arrayset_t *arrayset);
 AH5_PUBLIC char AH5_write_floatingtype (hid_t file_id, AH5_ft_t *floatingtype);
 
 AH5_PUBLIC void AH5_print_ft_singleinteger (const AH5_singleinteger_t *singleinteger, int space);
@@ -288,6 +327,7 @@ AH5_PUBLIC void AH5_print_ft_generalrationalfunction (const AH5_generalrationalf
     *generalrationalfunction, int space);
 AH5_PUBLIC void AH5_print_ft_rational (const AH5_rational_t *rational, int space);
 AH5_PUBLIC void AH5_print_ft_dataset (const AH5_dataset_t *dataset, int space);
+AH5_PUBLIC void AH5_print_ft_dataset_wide (const AH5_dataset_t *dataset, int space);
 AH5_PUBLIC void AH5_print_ft_arrayset (const AH5_arrayset_t *arrayset, int space);
 AH5_PUBLIC void AH5_print_floatingtype (const AH5_ft_t *floatingtype, int space);
 
@@ -391,7 +391,7 @@ AH5_ugroup_t *AH5_init_ugroup(
 
     if (nb_eles)
     {
-      group->groupelts = (int *)malloc(nb_eles*sizeof(int));
+      group->groupelts = (int *)AH5_alloc(nb_eles*sizeof(int));
       /*release memory in error.*/
       if (group->groupelts == NULL)
       {
@@ -602,15 +602,15 @@ AH5_umesh_t *AH5_init_umesh(
     {
       if (nb_elementnodes && nb_elementtypes)
       {
-        umesh->elementnodes = (int *)malloc(nb_elementnodes*sizeof(int));
+        umesh->elementnodes = (int *)AH5_alloc(nb_elementnodes*sizeof(int));
         success &= (umesh->elementnodes != NULL);
 
-        umesh->elementtypes = (char *)malloc(nb_elementtypes*sizeof(char));
+        umesh->elementtypes = (char *)AH5_alloc(nb_elementtypes*sizeof(char));
         success &= (umesh->elementtypes != NULL);
       }
 
       umesh->nb_nodes[1] = 3;
-      umesh->nodes = (float *)malloc(3*nb_nodes*sizeof(float));
+      umesh->nodes = (float *)AH5_alloc(3*nb_nodes*sizeof(float));
       success &= (umesh->nodes != NULL);
 
       /*no groups if no elements.*/
@@ -649,9 +649,9 @@ AH5_umesh_t *AH5_init_umesh(
       /*release memory in error*/
       if (!success)
       {
-        free(umesh->elementnodes);
-        free(umesh->elementtypes);
-        free(umesh->nodes);
+        AH5_release(umesh->elementnodes);
+        AH5_release(umesh->elementtypes);
+        AH5_release(umesh->nodes);
         free(umesh->groups);
         free(umesh->groupgroups);
         free(umesh->som_tables);
@@ -879,6 +879,100 @@ char AH5_read_smesh_axis(hid_t file_id, const char *path, AH5_axis_t *axis)
 }
 
 
+// Open a mesh group dataset of 32-bit integers relative to its container
+static hid_t AH5_open_group_dataset(hid_t grp_id, const char *name, int *rank, hsize_t *dims)
+{
+  hid_t dset_id, type_id, space_id;
+
+  dims[0] = 1;
+  dims[1] = 1;
+  *rank = -1;
+  dset_id = H5Dopen(grp_id, name, H5P_DEFAULT);
+  if (dset_id < 0)
+    return dset_id;
+
+  type_id = H5Dget_type(dset_id);
+  if (H5Tget_class(type_id) == H5T_INTEGER && H5Tget_size(type_id) == 4)
+  {
+    space_id = H5Dget_space(dset_id);
+    *rank = H5Sget_simple_extent_ndims(space_id);
+    if (*rank < 0 || *rank > 2)
+      *rank = -1;
+    else
+      H5Sget_simple_extent_dims(space_id, dims, NULL);
+    H5Sclose(space_id);
+  }
+  H5Tclose(type_id);
+
+  if (*rank < 0)
+  {
+    H5Dclose(dset_id);
+    dset_id = -1;
+  }
+  return dset_id;
+}
+
+
+// Read the type and entityType attributes of an opened mesh group
+static char AH5_read_group_entitytype_attrs(
+    hid_t dset_id, const char *path, AH5_group_entitytype_t *entitytype)
+{
+  char *type = NULL, *centitytype = NULL, success = AH5_TRUE;
+
+  if (!AH5_read_str_attr(dset_id, ".", AH5_A_TYPE, &type))
+  {
+    AH5_print_err_attr(AH5_C_MESH, path, AH5_A_TYPE);
+    success = AH5_FALSE;
+  }
+  else if (!AH5_read_str_attr(dset_id, ".", AH5_A_ENTITY_TYPE, &centitytype)
+           && AH5_strcmp(type, AH5_V_NODE) != 0)
+  {
+    AH5_print_err_attr(AH5_C_MESH, path, AH5_A_ENTITY_TYPE);
+    success = AH5_FALSE;
+  }
+  AH5_read_group_entitytype(type, centitytype, entitytype);
+  free(type);
+  free(centitytype);
+  return success;
+}
+
+
+// Read the normals of a structured mesh face group (<mesh>/normal/<group_name>)
+static char AH5_read_sgroup_normals(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
+{
+  char *temp, *normalpath, success = AH5_FALSE;
+  hsize_t dims[2] = {1, 1};
+  H5T_class_t type_class;
+  size_t length;
+  int nb_dims;
+
+  /* path = <mesh_path>/group/<group_name> */
+  normalpath = malloc((strlen(path) + strlen(AH5_G_NORMAL) - strlen(AH5_G_GROUP) + 1)
+                      * sizeof(*normalpath));
+  strcpy(normalpath, path);
+  temp = strstr(path, "/group/");
+  normalpath[temp-path] = '\0';  /* get <mesh_path> */
+  temp = AH5_get_name_from_path(path);  /* temp = <group_name> */
+  strcat(normalpath, AH5_G_NORMAL);
+  strcat(normalpath, "/");
+  strcat(normalpath, temp);
+  /* normalpath = <mesh_path>/normal/<group_name> */
+
+  // TODO(XXX) read the normals in flat_normal member.
+  if (AH5_path_valid(file_id, normalpath))
+    if (H5LTget_dataset_ndims(file_id, normalpath, &nb_dims) >= 0)
+      if (nb_dims <= 1)
+        if (H5LTget_dataset_info(file_id, normalpath, dims, &type_class, &length) >= 0)
+          if (dims[0] == sgroup->dims[0] && type_class == H5T_STRING && length == 2)
+            if(AH5_read_str_dataset(file_id, normalpath, dims[0], length, &(sgroup->normals)))
+              success = AH5_TRUE;
+  if (!success)
+    AH5_print_err_dset(AH5_C_MESH, normalpath);
+  free(normalpath);
+  return success;
+}
+
+
 // Read group in structured mesh (+normals)
 char AH5_read_smsh_group(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
 {
@@ -886,9 +980,7 @@ char AH5_read_smsh_group(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
 }
 char AH5_read_sgroup(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
 {
-  char *temp, success1 = AH5_FALSE, success2 = AH5_TRUE, success3 = AH5_FALSE, rdata = AH5_TRUE;
-  char *normalpath;
-  hsize_t dims[2] = {1, 1};
+  char success1 = AH5_FALSE, success2 = AH5_TRUE, rdata = AH5_TRUE;
   H5T_class_t type_class;
   size_t length;
   int nb_dims;
@@ -945,34 +1037,8 @@ char AH5_read_sgroup(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
       if (success2)
       {
         if (sgroup->entitytype == AH5_GROUP_FACE)
-        {
-          /* path = <mesh_path>/group/<group_name> */
-          normalpath = malloc((strlen(path) + strlen(AH5_G_NORMAL) - strlen(AH5_G_GROUP) + 1)
-                              * sizeof(*normalpath));
-          strcpy(normalpath, path);
-          temp = strstr(path, "/group/");
-          normalpath[temp-path] = '\0';  /* get <mesh_path> */
-          temp = AH5_get_name_from_path(path);  /* temp = <group_name> */
-          strcat(normalpath, AH5_G_NORMAL);
-          strcat(normalpath, "/");
-          strcat(normalpath, temp);
-          /* normalpath = <mesh_path>/normal/<group_name> */
-
-          // TODO(XXX) read the normals in flat_normal member.
-          if (AH5_path_valid(file_id, normalpath))
-            if (H5LTget_dataset_ndims(file_id, normalpath, &nb_dims) >= 0)
-              if (nb_dims <= 1)
-                if (H5LTget_dataset_info(file_id, normalpath, dims, &type_class, &length) >= 0)
-                  if (dims[0] == sgroup->dims[0] && type_class == H5T_STRING && length == 2)
-                    if(AH5_read_str_dataset(file_id, normalpath, dims[0], length, &(sgroup->normals)))
-                      success3 = AH5_TRUE;
-          if (!success3)
-          {
-            AH5_print_err_dset(AH5_C_MESH, normalpath);
+          if (!AH5_read_sgroup_normals(file_id, path, sgroup))
             rdata = AH5_FALSE;
-          }
-          free(normalpath);
-        }
       }
     }
   }
@@ -985,6 +1051,93 @@ char AH5_read_sgroup(hid_t file_id, const char *path, AH5_sgroup_t *sgroup)
 }
 
 
+/**
+ * Read all the groups of a structured mesh.
+ *
+ * The container is listed once and each group dataset is opened once for
+ * its attributes and its elements, instead of the path checks and reopening
+ * done by AH5_read_sgroup for each group.
+ *
+ * @param[in] file_id the file or location identifier
+ * @param[in] path the groups container path (<mesh>/group)
+ * @param[out] nb_groups the number of read groups
+ * @param[out] groups the read groups (free them with AH5_free_sgroup)
+ *
+ * @return AH5_TRUE if all the groups have been read.
+ */
+char AH5_read_sgroups(hid_t file_id, const char *path, hsize_t *nb_groups, AH5_sgroup_t **groups)
+{
+  AH5_names_t names;
+  AH5_sgroup_t *sgroup;
+  char rdata = AH5_TRUE, success;
+  hid_t grp_id, dset_id;
+  hsize_t i;
+  int rank;
+
+  *nb_groups = 0;
+  *groups = NULL;
+
+  AH5_init_names(&names);
+  AH5_read_names(file_id, path, &names);
+  if (names.nb_names == 0)
+  {
+    AH5_free_names(&names);
+    return AH5_TRUE;
+  }
+
+  grp_id = H5Gopen(file_id, path, H5P_DEFAULT);
+  *groups = (AH5_sgroup_t *) malloc((size_t) names.nb_names * sizeof(AH5_sgroup_t));
+  *nb_groups = names.nb_names;
+  for (i = 0; i < names.nb_names; i++)
+  {
+    sgroup = *groups + i;
+    sgroup->path = malloc((strlen(path) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(char));
+    strcpy(sgroup->path, path);
+    strcat(sgroup->path, AH5_NAME(&names, i));
+    sgroup->entitytype = AH5_GROUP_ENTITYTYPE_UNDEF;
+    sgroup->dims[0] = 0;
+    sgroup->dims[1] = 0;
+    sgroup->elements = NULL;
+    sgroup->normals = NULL;
+    sgroup->flat_normals = NULL;
+
+    success = AH5_FALSE;
+    dset_id = AH5_open_group_dataset(grp_id, AH5_NAME(&names, i) + 1, &rank, sgroup->dims);
+    if (dset_id >= 0)
+    {
+      success = AH5_read_group_entitytype_attrs(dset_id, sgroup->path, &(sgroup->entitytype));
+      if (rank == 2 && sgroup->dims[1] >= 1 && sgroup->dims[1] <= 6)
+        sgroup->elements = (int *) malloc(
+            (size_t) (sgroup->dims[0] * sgroup->dims[1]) * sizeof(int));
+      if (!sgroup->elements
+          || H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, sgroup->elements) < 0)
+      {
+        AH5_print_err_dset(AH5_C_MESH, sgroup->path);
+        free(sgroup->elements);
+        sgroup->elements = NULL;
+        success = AH5_FALSE;
+      }
+      else if (success && sgroup->entitytype == AH5_GROUP_FACE)
+        success = AH5_read_sgroup_normals(file_id, sgroup->path, sgroup);
+      H5Dclose(dset_id);
+    }
+    else
+      AH5_print_err_dset(AH5_C_MESH, sgroup->path);
+
+    if (!sgroup->elements)
+    {
+      sgroup->dims[0] = 0;
+      sgroup->dims[1] = 0;
+    }
+    if (!success)
+      rdata = AH5_FALSE;
+  }
+  AH5_free_names(&names);
+  H5Gclose(grp_id);
+  return rdata;
+}
+
+
 char AH5_read_ssom_pie_table(hid_t file_id, const char *path, AH5_ssom_pie_table_t *som) {
   char success = AH5_FALSE;
   hsize_t nb_fields, nb_dims, nb_points, i, j;
@@ -1116,13 +1269,14 @@ char AH5_read_ssom_pie_table(hid_t file_id, const char *path, AH5_ssom_pie_table
 char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh)
 {
   char *path2, *path3;
-  AH5_children_t children;
+  AH5_names_t names;
   char *type, success, rdata = AH5_TRUE;
   hsize_t i;
 
   smesh->groups = NULL;
   smesh->groupgroups = NULL;
   smesh->som_tables = NULL;
+  AH5_init_names(&names);
 
   if (AH5_path_valid(file_id, path))
   {
@@ -1153,46 +1307,28 @@ char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh)
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_GROUP) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_GROUP);
-    children = AH5_read_children_name(file_id, path2);
-    smesh->nb_groups = children.nb_children;
-    if (children.nb_children > 0)
-    {
-      smesh->groups = (AH5_sgroup_t *) malloc((size_t) children.nb_children * sizeof(AH5_sgroup_t));
-      path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
-      {
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
-        strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
-        if (!AH5_read_sgroup(file_id, path3, smesh->groups + i))
-          rdata = AH5_FALSE;
-        free(children.childnames[i]);
-      }
-      free(children.childnames);
-      free(path3);
-    }
+    if (!AH5_read_sgroups(file_id, path2, &(smesh->nb_groups), &(smesh->groups)))
+      rdata = AH5_FALSE;
 
     // read groupGroup if exists
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_GROUPGROUP) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_GROUPGROUP);
-    children = AH5_read_children_name(file_id, path2);
-    smesh->nb_groupgroups = children.nb_children;
-    if (children.nb_children > 0)
+    AH5_read_names(file_id, path2, &names);
+    smesh->nb_groupgroups = names.nb_names;
+    if (names.nb_names > 0)
     {
-      smesh->groupgroups = (AH5_groupgroup_t *) malloc((size_t) children.nb_children * sizeof(
+      smesh->groupgroups = (AH5_groupgroup_t *) malloc((size_t) names.nb_names * sizeof(
                              AH5_groupgroup_t));
       path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
+      for (i = 0; i < names.nb_names; i++)
       {
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
+        path3 = realloc(path3, (strlen(path2) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(*path3));
         strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
+        strcat(path3, AH5_NAME(&names, i));
         if (!AH5_read_groupgroup(file_id, path3, smesh->groupgroups + i))
           rdata = AH5_FALSE;
-        free(children.childnames[i]);
       }
-      free(children.childnames);
       free(path3);
     }
 
@@ -1200,21 +1336,21 @@ char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh)
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_SELECTOR_ON_MESH) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_SELECTOR_ON_MESH);
-    children = AH5_read_children_name(file_id, path2);
-    smesh->nb_som_tables = children.nb_children;
-    if (children.nb_children > 0)
+    AH5_read_names(file_id, path2, &names);
+    smesh->nb_som_tables = names.nb_names;
+    if (names.nb_names > 0)
     {
-      smesh->som_tables = (AH5_ssom_pie_table_t *) malloc((size_t) children.nb_children * sizeof(
+      smesh->som_tables = (AH5_ssom_pie_table_t *) malloc((size_t) names.nb_names * sizeof(
                             AH5_ssom_pie_table_t));
       path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
+      for (i = 0; i < names.nb_names; i++)
       {
         AH5_init_ssom_pie_table(smesh->som_tables + i, NULL, 0);
 
         success = AH5_FALSE;
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
+        path3 = realloc(path3, (strlen(path2) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(*path3));
         strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
+        strcat(path3, AH5_NAME(&names, i));
         if (AH5_read_str_attr(file_id, path3, AH5_A_TYPE, &type)) {
           if (AH5_strcmp(type,AH5_V_POINT_IN_ELEMENT) == 0)
             success = AH5_read_ssom_pie_table(file_id, path3, smesh->som_tables + i);
@@ -1224,9 +1360,7 @@ char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh)
           AH5_print_err_attr(AH5_C_MESH, AH5_A_TYPE, path3);
           rdata = AH5_FALSE;
         }
-        free(children.childnames[i]);
       }
-      free(children.childnames);
       free(path3);
     }
 
@@ -1237,6 +1371,7 @@ char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh)
     AH5_print_err_path(AH5_C_MESH, path);
     rdata = AH5_FALSE;
   }
+  AH5_free_names(&names);
   return rdata;
 }
 
@@ -1269,8 +1404,17 @@ char AH5_read_ugroup(hid_t file_id, const char *path, AH5_ugroup_t *ugroup)
         if (nb_dims <= 1)
           if (H5LTget_dataset_info(file_id, path, &(ugroup->nb_groupelts), &type_class, &length) >= 0)
             if (type_class == H5T_INTEGER && length == 4)
-              if (AH5_read_int_dataset(file_id, path, ugroup->nb_groupelts, &(ugroup->groupelts)))
-                rdata = AH5_TRUE;
+              {
+                ugroup->groupelts = (int *) AH5_alloc((size_t) ugroup->nb_groupelts * sizeof(int));
+                if (AH5_read_int_dataset_into(file_id, path, ugroup->nb_groupelts, H5P_DEFAULT,
+                                              ugroup->groupelts))
+                  rdata = AH5_TRUE;
+                else
+                {
+                  AH5_release(ugroup->groupelts);
+                  ugroup->groupelts = NULL;
+                }
+              }
       //XXX Why not point to the constant value (AH5_V_ELEMENT, ...)?
       //      Does not forgot to update free function.
       if(!AH5_read_str_attr(file_id, path, AH5_A_ENTITY_TYPE, &entitytype))
@@ -1281,7 +1425,8 @@ char AH5_read_ugroup(hid_t file_id, const char *path, AH5_ugroup_t *ugroup)
           rdata = AH5_FALSE;
         }
       }
-      AH5_read_group_entitytype(type, entitytype, &(ugroup->entitytype));
+      if (entitytype || AH5_strcmp(type, AH5_V_NODE) == 0)
+        AH5_read_group_entitytype(type, entitytype, &(ugroup->entitytype));
       free(type);
       free(entitytype);
     }
@@ -1295,6 +1440,84 @@ char AH5_read_ugroup(hid_t file_id, const char *path, AH5_ugroup_t *ugroup)
 }
 
 
+/**
+ * Read all the groups of an unstructured mesh.
+ *
+ * The container is listed once and each group dataset is opened once for
+ * its attributes and its elements, instead of the path checks and reopening
+ * done by AH5_read_ugroup for each group. The elements are allocated with
+ * AH5_alloc, so an arena allocator (see AH5_set_allocator) packs them.
+ *
+ * @param[in] file_id the file or location identifier
+ * @param[in] path the groups container path (<mesh>/group)
+ * @param[out] nb_groups the number of read groups
+ * @param[out] groups the read groups
+ *
+ * @return AH5_TRUE if all the groups have been read.
+ */
+char AH5_read_ugroups(hid_t file_id, const char *path, hsize_t *nb_groups, AH5_ugroup_t **groups)
+{
+  AH5_names_t names;
+  AH5_ugroup_t *ugroup;
+  char rdata = AH5_TRUE, success;
+  hid_t grp_id, dset_id;
+  hsize_t i, dims[2];
+  int rank;
+
+  *nb_groups = 0;
+  *groups = NULL;
+
+  AH5_init_names(&names);
+  AH5_read_names(file_id, path, &names);
+  if (names.nb_names == 0)
+  {
+    AH5_free_names(&names);
+    return AH5_TRUE;
+  }
+
+  grp_id = H5Gopen(file_id, path, H5P_DEFAULT);
+  *groups = (AH5_ugroup_t *) malloc((size_t) names.nb_names * sizeof(AH5_ugroup_t));
+  *nb_groups = names.nb_names;
+  for (i = 0; i < names.nb_names; i++)
+  {
+    ugroup = *groups + i;
+    ugroup->path = malloc((strlen(path) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(char));
+    strcpy(ugroup->path, path);
+    strcat(ugroup->path, AH5_NAME(&names, i));
+    ugroup->entitytype = AH5_GROUP_ENTITYTYPE_UNDEF;
+    ugroup->nb_groupelts = 0;
+    ugroup->groupelts = NULL;
+
+    success = AH5_FALSE;
+    dset_id = AH5_open_group_dataset(grp_id, AH5_NAME(&names, i) + 1, &rank, dims);
+    if (dset_id >= 0)
+    {
+      success = AH5_read_group_entitytype_attrs(dset_id, ugroup->path, &(ugroup->entitytype));
+      if (rank <= 1)
+        ugroup->groupelts = (int *) AH5_alloc((size_t) dims[0] * sizeof(int));
+      if (ugroup->groupelts
+          && H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, ugroup->groupelts) >= 0)
+        ugroup->nb_groupelts = dims[0];
+      else
+      {
+        AH5_release(ugroup->groupelts);
+        ugroup->groupelts = NULL;
+        success = AH5_FALSE;
+      }
+      H5Dclose(dset_id);
+    }
+    if (!success)
+    {
+      AH5_print_err_dset(AH5_C_MESH, ugroup->path);
+      rdata = AH5_FALSE;
+    }
+  }
+  AH5_free_names(&names);
+  H5Gclose(grp_id);
+  return rdata;
+}
+
+
 char AH5_read_usom_pie_table(hid_t file_id, const char *path, AH5_usom_pie_table_t *som) {
   char success = AH5_FALSE;
   hsize_t nb_fields, size, i, j;
@@ -1460,8 +1683,7 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
   int nb_dims;
   H5T_class_t type_class;
   size_t length;
-  hid_t dset_id;
-  AH5_children_t children;
+  AH5_names_t names;
 
   umesh->elementnodes = NULL;
   umesh->elementtypes = NULL;
@@ -1469,6 +1691,7 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
   umesh->groups = NULL;
   umesh->groupgroups = NULL;
   umesh->som_tables = NULL;
+  AH5_init_names(&names);
 
   if (AH5_path_valid(file_id, path))
   {
@@ -1482,8 +1705,17 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
         if (nb_dims <= 1)
           if (H5LTget_dataset_info(file_id, path2, &(umesh->nb_elementnodes), &type_class, &length) >= 0)
             if (type_class == H5T_INTEGER)
-              if (AH5_read_int_dataset(file_id, path2, umesh->nb_elementnodes, &(umesh->elementnodes)))
+            {
+              umesh->elementnodes = (int *) AH5_alloc((size_t) umesh->nb_elementnodes * sizeof(int));
+              if (AH5_read_int_dataset_into(file_id, path2, umesh->nb_elementnodes, H5P_DEFAULT,
+                                            umesh->elementnodes))
                 success = AH5_TRUE;
+              else
+              {
+                AH5_release(umesh->elementnodes);
+                umesh->elementnodes = NULL;
+              }
+            }
     }
     else
     {
@@ -1510,14 +1742,13 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
           if (H5LTget_dataset_info(file_id, path2, &(umesh->nb_elementtypes), &type_class, &length) >= 0)
             if (type_class == H5T_INTEGER)
             {
-              umesh->elementtypes = (char *) malloc((size_t) umesh->nb_elementtypes * sizeof(char));
-              dset_id = H5Dopen(file_id, path2, H5P_DEFAULT);
-              if (H5Dread(dset_id, H5T_NATIVE_CHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, umesh->elementtypes) >= 0)
+              umesh->elementtypes = (char *) AH5_alloc((size_t) umesh->nb_elementtypes * sizeof(char));
+              if (AH5_read_char_dataset_into(file_id, path2, umesh->nb_elementtypes, H5P_DEFAULT,
+                                             umesh->elementtypes))
                 success = AH5_TRUE;
-              H5Dclose(dset_id);
-              if (!success)
+              else
               {
-                free(umesh->elementtypes);
+                AH5_release(umesh->elementtypes);
                 umesh->elementtypes = NULL;
               }
             }
@@ -1537,7 +1768,7 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
     success = AH5_FALSE;
     umesh->nb_nodes[0] = 1;
     umesh->nb_nodes[1] = 1;
-    // Read m x n dataset "nodes" (32-bit signed float)
+    // Read m x n dataset "nodes" (32-bit float, 64-bit float are not narrowed)
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_NODES) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_NODES);
@@ -1545,9 +1776,24 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
       if (H5LTget_dataset_ndims(file_id, path2, &nb_dims) >= 0)
         if (nb_dims == 2)
           if (H5LTget_dataset_info(file_id, path2, umesh->nb_nodes, &type_class, &length) >= 0)
+          {
+            if (type_class == H5T_FLOAT && length == 8)
+              AH5_log_error("Unstructured mesh '%s': the nodes are in double precision, "
+                            "read them with AH5_read_umesh_nodes_dbl_slab.", path);
             if (umesh->nb_nodes[1] <= 3 && type_class == H5T_FLOAT && length == 4)
-              if (AH5_read_flt_dataset(file_id, path2, umesh->nb_nodes[0] * umesh->nb_nodes[1], &(umesh->nodes)))
+            {
+              umesh->nodes = (float *) AH5_alloc(
+                  (size_t) (umesh->nb_nodes[0] * umesh->nb_nodes[1]) * sizeof(float));
+              if (AH5_read_flt_dataset_into(file_id, path2, umesh->nb_nodes[0] * umesh->nb_nodes[1],
+                                            H5P_DEFAULT, umesh->nodes))
                 success = AH5_TRUE;
+              else
+              {
+                AH5_release(umesh->nodes);
+                umesh->nodes = NULL;
+              }
+            }
+          }
     if (!success)
     {
       AH5_print_err_dset(AH5_C_MESH, path2);
@@ -1560,23 +1806,21 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_GROUPGROUP) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_GROUPGROUP);
-    children = AH5_read_children_name(file_id, path2);
-    umesh->nb_groupgroups = children.nb_children;
-    if (children.nb_children > 0)
+    AH5_read_names(file_id, path2, &names);
+    umesh->nb_groupgroups = names.nb_names;
+    if (names.nb_names > 0)
     {
-      umesh->groupgroups = (AH5_groupgroup_t *) malloc((size_t) children.nb_children * sizeof(
+      umesh->groupgroups = (AH5_groupgroup_t *) malloc((size_t) names.nb_names * sizeof(
                              AH5_groupgroup_t));
       path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
+      for (i = 0; i < names.nb_names; i++)
       {
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
+        path3 = realloc(path3, (strlen(path2) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(*path3));
         strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
+        strcat(path3, AH5_NAME(&names, i));
         if (!AH5_read_groupgroup(file_id, path3, umesh->groupgroups + i))
           rdata = AH5_FALSE;
-        free(children.childnames[i]);
       }
-      free(children.childnames);
       free(path3);
     }
 
@@ -1584,49 +1828,31 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_GROUP) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_GROUP);
-    children = AH5_read_children_name(file_id, path2);
-    umesh->nb_groups = children.nb_children;
-    if (children.nb_children > 0)
-    {
-      umesh->groups = (AH5_ugroup_t *) malloc((size_t) children.nb_children * sizeof(AH5_ugroup_t));
-      path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
-      {
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
-        strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
-        if (!AH5_read_ugroup(file_id, path3, umesh->groups + i))
-          rdata = AH5_FALSE;
-        free(children.childnames[i]);
-      }
-      free(path3);
-      free(children.childnames);
-    }
+    if (!AH5_read_ugroups(file_id, path2, &(umesh->nb_groups), &(umesh->groups)))
+      rdata = AH5_FALSE;
 
     // read selectorOnMesh
     path2 = realloc(path2, (strlen(path) + strlen(AH5_G_SELECTOR_ON_MESH) + 1) * sizeof(*path2));
     strcpy(path2, path);
     strcat(path2, AH5_G_SELECTOR_ON_MESH);
-    children = AH5_read_children_name(file_id, path2);
-    umesh->nb_som_tables = children.nb_children;
-    if (children.nb_children > 0)
+    AH5_read_names(file_id, path2, &names);
+    umesh->nb_som_tables = names.nb_names;
+    if (names.nb_names > 0)
     {
-      umesh->som_tables = (AH5_usom_table_t *) malloc((size_t) children.nb_children * sizeof(
+      umesh->som_tables = (AH5_usom_table_t *) malloc((size_t) names.nb_names * sizeof(
                             AH5_usom_table_t));
       path3 = malloc((strlen(path2) + 1) * sizeof(*path3));
-      for (i = 0; i < children.nb_children; i++)
+      for (i = 0; i < names.nb_names; i++)
       {
         AH5_init_usom_table(umesh->som_tables + i, NULL, 0, SOM_INVALID);
 
-        path3 = realloc(path3, (strlen(path2) + strlen(children.childnames[i]) + 1) * sizeof(*path3));
+        path3 = realloc(path3, (strlen(path2) + strlen(AH5_NAME(&names, i)) + 1) * sizeof(*path3));
         strcpy(path3, path2);
-        strcat(path3, children.childnames[i]);
+        strcat(path3, AH5_NAME(&names, i));
         if (!AH5_read_usom_table(file_id, path3, umesh->som_tables + i))
           rdata = AH5_FALSE;
-        free(children.childnames[i]);
       }
       free(path3);
-      free(children.childnames);
     }
 
     free(path2);
@@ -1636,10 +1862,570 @@ char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh)
     AH5_print_err_path(AH5_C_MESH, path);
     rdata = AH5_FALSE;
   }
+  AH5_free_names(&names);
   return rdata;
 }
 
 
+// Read a range of unstructured mesh nodes into a 'mem_type' buffer
+static char AH5_read_umesh_nodes_range(hid_t file_id, const char *path, hsize_t first,
+                                       hsize_t count, hid_t mem_type, void *nodes)
+{
+  char success = AH5_FALSE;
+  char *path2;
+  hsize_t dims[2], start[2];
+  H5T_class_t type_class;
+  size_t length;
+  int nb_dims;
+
+  path2 = malloc((strlen(path) + strlen(AH5_G_NODES) + 1) * sizeof(*path2));
+  strcpy(path2, path);
+  strcat(path2, AH5_G_NODES);
+  if (AH5_path_valid(file_id, path2))
+    if (H5LTget_dataset_ndims(file_id, path2, &nb_dims) >= 0)
+      if (nb_dims == 2)
+        if (H5LTget_dataset_info(file_id, path2, dims, &type_class, &length) >= 0)
+          if (type_class == H5T_FLOAT && first + count <= dims[0])
+          {
+            start[0] = first;
+            start[1] = 0;
+            dims[0] = count;
+            success = AH5_read_dataset_slab(file_id, path2, 2, start, dims, NULL, mem_type,
+                                            nodes);
+          }
+  if (!success)
+    AH5_print_err_dset(AH5_C_MESH, path2);
+  free(path2);
+  return success;
+}
+
+
+// Read a range of unstructured mesh nodes
+char AH5_read_umesh_nodes_slab(hid_t file_id, const char *path, hsize_t first, hsize_t count,
+                               float *nodes)
+{
+  return AH5_read_umesh_nodes_range(file_id, path, first, count, H5T_NATIVE_FLOAT, nodes);
+}
+
+
+// Read a range of unstructured mesh nodes in double precision
+char AH5_read_umesh_nodes_dbl_slab(hid_t file_id, const char *path, hsize_t first,
+                                   hsize_t count, double *nodes)
+{
+  return AH5_read_umesh_nodes_range(file_id, path, first, count, H5T_NATIVE_DOUBLE, nodes);
+}
+
+
+// Read a 1D slab of the mesh dataset 'path' + 'name'
+static char AH5_read_umesh_slab(hid_t file_id, const char *path, const char *name,
+                                hsize_t first, hsize_t count, hid_t mem_type, void *buffer)
+{
+  char success = AH5_FALSE;
+  char *path2;
+  hsize_t size;
+  H5T_class_t type_class;
+  size_t length;
+  int nb_dims;
+
+  path2 = malloc((strlen(path) + strlen(name) + 1) * sizeof(*path2));
+  strcpy(path2, path);
+  strcat(path2, name);
+  if (AH5_path_valid(file_id, path2))
+    if (H5LTget_dataset_ndims(file_id, path2, &nb_dims) >= 0)
+      if (nb_dims == 1)
+        if (H5LTget_dataset_info(file_id, path2, &size, &type_class, &length) >= 0)
+          if (type_class == H5T_INTEGER && first + count <= size)
+            success = AH5_read_dataset_slab(file_id, path2, 1, &first, &count, NULL,
+                                            mem_type, buffer);
+  if (!success)
+    AH5_print_err_dset(AH5_C_MESH, path2);
+  free(path2);
+  return success;
+}
+
+
+// Read a range of unstructured mesh element nodes
+char AH5_read_umesh_elementnodes_slab(hid_t file_id, const char *path, hsize_t first,
+                                      hsize_t count, int *elementnodes)
+{
+  return AH5_read_umesh_slab(file_id, path, AH5_G_ELEMENT_NODES, first, count,
+                             H5T_NATIVE_INT, elementnodes);
+}
+
+
+// Read a range of unstructured mesh element nodes with 64-bit indices
+char AH5_read_umesh_elementnodes_i64_slab(hid_t file_id, const char *path, hsize_t first,
+                                          hsize_t count, int64_t *elementnodes)
+{
+  return AH5_read_umesh_slab(file_id, path, AH5_G_ELEMENT_NODES, first, count,
+                             H5T_NATIVE_INT64, elementnodes);
+}
+
+
+// Read a range of unstructured mesh element types
+char AH5_read_umesh_elementtypes_slab(hid_t file_id, const char *path, hsize_t first,
+                                      hsize_t count, char *elementtypes)
+{
+  return AH5_read_umesh_slab(file_id, path, AH5_G_ELEMENT_TYPES, first, count,
+                             H5T_NATIVE_CHAR, elementtypes);
+}
+
+
+// Read the rows [first, first + count) of an opened dataset
+static char AH5_read_rows(hid_t dset_id, int rank, const hsize_t *dims, hsize_t first,
+                          hsize_t count, hid_t mem_type, void *buffer)
+{
+  char success = AH5_FALSE;
+  hid_t file_space, mem_space;
+  hsize_t start[2] = {0, 0}, size[2];
+
+  start[0] = first;
+  size[0] = count;
+  size[1] = (rank == 2) ? dims[1] : 1;
+
+  file_space = H5Dget_space(dset_id);
+  mem_space = H5Screate_simple(rank, size, NULL);
+  if (H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, size, NULL) >= 0)
+    if (H5Dread(dset_id, mem_type, mem_space, file_space, H5P_DEFAULT, buffer) >= 0)
+      success = AH5_TRUE;
+  H5Sclose(mem_space);
+  H5Sclose(file_space);
+  return success;
+}
+
+
+// Open the mesh dataset 'path' + 'name' and read its dims
+static hid_t AH5_open_umesh_dataset(hid_t file_id, const char *path, const char *name,
+                                    int rank, hsize_t *dims)
+{
+  hid_t dset_id = -1;
+  char *path2;
+  H5T_class_t type_class;
+  size_t length;
+  int nb_dims;
+
+  path2 = malloc((strlen(path) + strlen(name) + 1) * sizeof(*path2));
+  strcpy(path2, path);
+  strcat(path2, name);
+  if (AH5_path_valid(file_id, path2))
+    if (H5LTget_dataset_ndims(file_id, path2, &nb_dims) >= 0)
+      if (nb_dims == rank)
+        if (H5LTget_dataset_info(file_id, path2, dims, &type_class, &length) >= 0)
+          dset_id = H5Dopen(file_id, path2, H5P_DEFAULT);
+  if (dset_id < 0)
+    AH5_print_err_dset(AH5_C_MESH, path2);
+  free(path2);
+  return dset_id;
+}
+
+
+// Walk the unstructured mesh elements by blocks
+char AH5_read_umesh_elements_blocks(hid_t file_id, const char *path, hsize_t block_size,
+                                    AH5_umesh_elements_block_func_t func, void *user_data)
+{
+  char success = AH5_TRUE;
+  hid_t types_id, nodes_id;
+  hsize_t nb_elementtypes = 0, nb_elementnodes = 0;
+  hsize_t first = 0, offset = 0, count, size, capacity = 0, i;
+  char *elementtypes = NULL;
+  int *elementnodes = NULL;
+  int element_size;
+
+  if (!block_size || !func)
+    return AH5_FALSE;
+
+  types_id = AH5_open_umesh_dataset(file_id, path, AH5_G_ELEMENT_TYPES, 1, &nb_elementtypes);
+  nodes_id = AH5_open_umesh_dataset(file_id, path, AH5_G_ELEMENT_NODES, 1, &nb_elementnodes);
+  if (types_id < 0 || nodes_id < 0)
+    success = AH5_FALSE;
+  else
+    elementtypes = (char *) malloc((size_t) block_size * sizeof(char));
+
+  while (success && first < nb_elementtypes)
+  {
+    count = nb_elementtypes - first;
+    if (count > block_size)
+      count = block_size;
+
+    success = AH5_read_rows(types_id, 1, &nb_elementtypes, first, count, H5T_NATIVE_CHAR,
+                            elementtypes);
+
+    // Size of the connectivity slice of this block.
+    size = 0;
+    for (i = 0; success && i < count; ++i)
+    {
+      element_size = AH5_element_size(elementtypes[i]);
+      if (element_size == 0)
+      {
+        AH5_log_error("Unstructured mesh '%s': invalid type of element %lu.",
+                      path, (unsigned long) (first + i));
+        success = AH5_FALSE;
+      }
+      size += element_size;
+    }
+    if (success && offset + size > nb_elementnodes)
+    {
+      AH5_log_error("Unstructured mesh '%s': elementNodes is too short.", path);
+      success = AH5_FALSE;
+    }
+
+    if (success && size > capacity)
+    {
+      capacity = size;
+      free(elementnodes);
+      elementnodes = (int *) malloc((size_t) capacity * sizeof(int));
+    }
+    if (success && size)
+      success = AH5_read_rows(nodes_id, 1, &nb_elementnodes, offset, size, H5T_NATIVE_INT,
+                              elementnodes);
+
+    if (success)
+      success = func(first, count, elementtypes, offset, size, elementnodes, user_data);
+
+    first += count;
+    offset += size;
+  }
+
+  free(elementtypes);
+  free(elementnodes);
+  if (types_id >= 0)
+    H5Dclose(types_id);
+  if (nodes_id >= 0)
+    H5Dclose(nodes_id);
+  return success;
+}
+
+
+// Walk the unstructured mesh nodes by blocks
+char AH5_read_umesh_nodes_blocks(hid_t file_id, const char *path, hsize_t block_size,
+                                 AH5_umesh_nodes_block_func_t func, void *user_data)
+{
+  char success = AH5_TRUE;
+  hid_t nodes_id;
+  hsize_t dims[2] = {0, 0};
+  hsize_t first = 0, count;
+  float *nodes = NULL;
+
+  if (!block_size || !func)
+    return AH5_FALSE;
+
+  nodes_id = AH5_open_umesh_dataset(file_id, path, AH5_G_NODES, 2, dims);
+  if (nodes_id < 0)
+    return AH5_FALSE;
+
+  nodes = (float *) malloc((size_t) (block_size * dims[1]) * sizeof(float));
+  while (success && first < dims[0])
+  {
+    count = dims[0] - first;
+    if (count > block_size)
+      count = block_size;
+
+    success = AH5_read_rows(nodes_id, 2, dims, first, count, H5T_NATIVE_FLOAT, nodes);
+    if (success)
+      success = func(first, count, dims[1], nodes, user_data);
+
+    first += count;
+  }
+
+  free(nodes);
+  H5Dclose(nodes_id);
+  return success;
+}
+
+
+// Read the dimensions of an optional unstructured mesh dataset
+static char AH5_umesh_dataset_dims(hid_t file_id, const char *path, const char *name,
+                                   hsize_t *dims)
+{
+  char success = AH5_FALSE;
+  char *path2;
+  H5T_class_t type_class;
+  size_t length;
+
+  path2 = malloc((strlen(path) + strlen(name) + 1) * sizeof(*path2));
+  strcpy(path2, path);
+  strcat(path2, name);
+  if (AH5_path_valid(file_id, path2))
+    if (H5LTget_dataset_info(file_id, path2, dims, &type_class, &length) >= 0)
+      success = AH5_TRUE;
+  free(path2);
+  return success;
+}
+
+
+// Build the path of a child of an unstructured mesh category
+static char *AH5_umesh_child_path(const AH5_umesh_handle_t *handle, const char *category,
+                                  const char *childname)
+{
+  char *path;
+
+  path = malloc((strlen(handle->path) + strlen(category) + strlen(childname) + 1) * sizeof(*path));
+  strcpy(path, handle->path);
+  strcat(path, category);
+  strcat(path, childname);
+  return path;
+}
+
+
+// Open a lazy unstructured mesh
+char AH5_open_umesh_handle(hid_t file_id, const char *path, AH5_umesh_handle_t *handle)
+{
+  char *path2;
+  hsize_t i, dims[2] = {0, 0};
+
+  handle->file_id = file_id;
+  handle->path = NULL;
+  AH5_init_names(&handle->groups);
+  AH5_init_names(&handle->groupgroups);
+  AH5_init_names(&handle->som_tables);
+  AH5_init_umesh(&handle->umesh, 0, 0, 0, 0, 0, 0);
+
+  if (!AH5_path_valid(file_id, path))
+  {
+    AH5_print_err_path(AH5_C_MESH, path);
+    return AH5_FALSE;
+  }
+  handle->path = strdup(path);
+
+  if (AH5_umesh_dataset_dims(file_id, path, AH5_G_ELEMENT_NODES, dims))
+    handle->umesh.nb_elementnodes = dims[0];
+  if (AH5_umesh_dataset_dims(file_id, path, AH5_G_ELEMENT_TYPES, dims))
+    handle->umesh.nb_elementtypes = dims[0];
+  if (!AH5_umesh_dataset_dims(file_id, path, AH5_G_NODES, handle->umesh.nb_nodes))
+  {
+    AH5_print_err_dset(AH5_C_MESH, path);
+    AH5_close_umesh_handle(handle);
+    return AH5_FALSE;
+  }
+
+  // Only the names, the sub-objects are read on first access.
+  path2 = AH5_umesh_child_path(handle, AH5_G_GROUP, "");
+  AH5_read_names(file_id, path2, &handle->groups);
+  free(path2);
+  path2 = AH5_umesh_child_path(handle, AH5_G_GROUPGROUP, "");
+  AH5_read_names(file_id, path2, &handle->groupgroups);
+  free(path2);
+  path2 = AH5_umesh_child_path(handle, AH5_G_SELECTOR_ON_MESH, "");
+  AH5_read_names(file_id, path2, &handle->som_tables);
+  free(path2);
+
+  handle->umesh.nb_groups = handle->groups.nb_names;
+  if (handle->umesh.nb_groups)
+    handle->umesh.groups = (AH5_ugroup_t *) calloc(
+        (size_t) handle->umesh.nb_groups, sizeof(AH5_ugroup_t));
+  handle->umesh.nb_groupgroups = handle->groupgroups.nb_names;
+  if (handle->umesh.nb_groupgroups)
+    handle->umesh.groupgroups = (AH5_groupgroup_t *) calloc(
+        (size_t) handle->umesh.nb_groupgroups, sizeof(AH5_groupgroup_t));
+  handle->umesh.nb_som_tables = handle->som_tables.nb_names;
+  if (handle->umesh.nb_som_tables)
+  {
+    handle->umesh.som_tables = (AH5_usom_table_t *) malloc(
+        (size_t) handle->umesh.nb_som_tables * sizeof(AH5_usom_table_t));
+    for (i = 0; i < handle->umesh.nb_som_tables; ++i)
+      AH5_init_usom_table(handle->umesh.som_tables + i, NULL, 0, SOM_INVALID);
+  }
+
+  return AH5_TRUE;
+}
+
+
+// Return the nodes of a lazy unstructured mesh, read them on first access
+float *AH5_umesh_handle_nodes(AH5_umesh_handle_t *handle)
+{
+  AH5_umesh_t *umesh = &handle->umesh;
+  hsize_t size = umesh->nb_nodes[0] * umesh->nb_nodes[1];
+  char *path2;
+
+  if (!umesh->nodes && size)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_NODES, "");
+    umesh->nodes = (float *) AH5_alloc((size_t) size * sizeof(float));
+    if (umesh->nodes && !AH5_read_flt_dataset_into(handle->file_id, path2, size, H5P_DEFAULT,
+                                                   umesh->nodes))
+    {
+      AH5_release(umesh->nodes);
+      umesh->nodes = NULL;
+    }
+    free(path2);
+  }
+  return umesh->nodes;
+}
+
+
+// Return the element nodes of a lazy unstructured mesh, read them on first access
+int *AH5_umesh_handle_elementnodes(AH5_umesh_handle_t *handle)
+{
+  AH5_umesh_t *umesh = &handle->umesh;
+  char *path2;
+
+  if (!umesh->elementnodes && umesh->nb_elementnodes)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_ELEMENT_NODES, "");
+    umesh->elementnodes = (int *) AH5_alloc((size_t) umesh->nb_elementnodes * sizeof(int));
+    if (umesh->elementnodes && !AH5_read_int_dataset_into(
+            handle->file_id, path2, umesh->nb_elementnodes, H5P_DEFAULT, umesh->elementnodes))
+    {
+      AH5_release(umesh->elementnodes);
+      umesh->elementnodes = NULL;
+    }
+    free(path2);
+  }
+  return umesh->elementnodes;
+}
+
+
+// Return the element types of a lazy unstructured mesh, read them on first access
+char *AH5_umesh_handle_elementtypes(AH5_umesh_handle_t *handle)
+{
+  AH5_umesh_t *umesh = &handle->umesh;
+  char *path2;
+
+  if (!umesh->elementtypes && umesh->nb_elementtypes)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_ELEMENT_TYPES, "");
+    umesh->elementtypes = (char *) AH5_alloc((size_t) umesh->nb_elementtypes * sizeof(char));
+    if (umesh->elementtypes && !AH5_read_char_dataset_into(
+            handle->file_id, path2, umesh->nb_elementtypes, H5P_DEFAULT, umesh->elementtypes))
+    {
+      AH5_release(umesh->elementtypes);
+      umesh->elementtypes = NULL;
+    }
+    free(path2);
+  }
+  return umesh->elementtypes;
+}
+
+
+// Return a group of a lazy unstructured mesh, read it on first access
+AH5_ugroup_t *AH5_umesh_handle_group(AH5_umesh_handle_t *handle, hsize_t i)
+{
+  AH5_ugroup_t *ugroup;
+  char *path2;
+
+  if (i >= handle->umesh.nb_groups)
+    return NULL;
+
+  ugroup = handle->umesh.groups + i;
+  if (!ugroup->path)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_GROUP, AH5_NAME(&handle->groups, i));
+    if (!AH5_read_ugroup(handle->file_id, path2, ugroup))
+    {
+      free(ugroup->path);
+      ugroup->path = NULL;
+      AH5_release(ugroup->groupelts);
+      ugroup->groupelts = NULL;
+      ugroup->nb_groupelts = 0;
+      ugroup = NULL;
+    }
+    free(path2);
+  }
+  return ugroup;
+}
+
+
+// Return a groupGroup of a lazy unstructured mesh, read it on first access
+AH5_groupgroup_t *AH5_umesh_handle_groupgroup(AH5_umesh_handle_t *handle, hsize_t i)
+{
+  AH5_groupgroup_t *groupgroup;
+  char *path2;
+
+  if (i >= handle->umesh.nb_groupgroups)
+    return NULL;
+
+  groupgroup = handle->umesh.groupgroups + i;
+  if (!groupgroup->path)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_GROUPGROUP, AH5_NAME(&handle->groupgroups, i));
+    if (!AH5_read_groupgroup(handle->file_id, path2, groupgroup))
+    {
+      AH5_free_groupgroup(groupgroup);
+      groupgroup = NULL;
+    }
+    free(path2);
+  }
+  return groupgroup;
+}
+
+
+// Return a selector on mesh of a lazy unstructured mesh, read it on first access
+AH5_usom_table_t *AH5_umesh_handle_som_table(AH5_umesh_handle_t *handle, hsize_t i)
+{
+  AH5_usom_table_t *som;
+  char *path2;
+
+  if (i >= handle->umesh.nb_som_tables)
+    return NULL;
+
+  som = handle->umesh.som_tables + i;
+  if (!som->path)
+  {
+    path2 = AH5_umesh_child_path(handle, AH5_G_SELECTOR_ON_MESH, AH5_NAME(&handle->som_tables, i));
+    if (!AH5_read_usom_table(handle->file_id, path2, som))
+    {
+      AH5_free_usom_table(som);
+      som = NULL;
+    }
+    free(path2);
+  }
+  return som;
+}
+
+
+// Release the loaded parts of a lazy unstructured mesh, they are read again on next access
+void AH5_release_umesh_handle(AH5_umesh_handle_t *handle, int parts)
+{
+  AH5_umesh_t *umesh = &handle->umesh;
+  hsize_t i;
+
+  if (parts & AH5_UMESH_NODES)
+  {
+    AH5_release(umesh->nodes);
+    umesh->nodes = NULL;
+  }
+  if (parts & AH5_UMESH_ELEMENTS)
+  {
+    AH5_release(umesh->elementnodes);
+    umesh->elementnodes = NULL;
+    AH5_release(umesh->elementtypes);
+    umesh->elementtypes = NULL;
+  }
+  if (parts & AH5_UMESH_GROUPS)
+    for (i = 0; i < umesh->nb_groups; ++i)
+    {
+      free(umesh->groups[i].path);
+      umesh->groups[i].path = NULL;
+      AH5_release(umesh->groups[i].groupelts);
+      umesh->groups[i].groupelts = NULL;
+    }
+  if (parts & AH5_UMESH_GROUPGROUPS)
+    for (i = 0; i < umesh->nb_groupgroups; ++i)
+      AH5_free_groupgroup(umesh->groupgroups + i);
+  if (parts & AH5_UMESH_SOM_TABLES)
+    for (i = 0; i < umesh->nb_som_tables; ++i)
+      AH5_free_usom_table(umesh->som_tables + i);
+}
+
+
+// Release a lazy unstructured mesh
+void AH5_close_umesh_handle(AH5_umesh_handle_t *handle)
+{
+  AH5_release_umesh_handle(handle, AH5_UMESH_ALL);
+  free(handle->umesh.groups);
+  free(handle->umesh.groupgroups);
+  free(handle->umesh.som_tables);
+  AH5_init_umesh(&handle->umesh, 0, 0, 0, 0, 0, 0);
+
+  AH5_free_names(&handle->groups);
+  AH5_free_names(&handle->groupgroups);
+  AH5_free_names(&handle->som_tables);
+
+  free(handle->path);
+  handle->path = NULL;
+}
+
+
 // Read mesh instance
 char AH5_read_msh_instance(hid_t file_id, const char *path, AH5_msh_instance_t *msh_instance)
 {
@@ -2396,7 +3182,7 @@ char AH5_write_usom_ef_table(
 
       if (loc_id >= 0) {
         // Write selector on mesh dataset
-        if (H5LTmake_dataset_int(loc_id, basename, 2, som->dims, som->items) < 0) {
+        if (!AH5_write_int_array(loc_id, basename, 2, som->dims, som->items)) {
           success = AH5_FALSE;
 
         } else {
@@ -3033,21 +3819,21 @@ void AH5_free_umesh(AH5_umesh_t *umesh)
 
   if (umesh->elementnodes != NULL)  // if any elementnodes...
   {
-    free(umesh->elementnodes);
+    AH5_release(umesh->elementnodes);
     umesh->elementnodes = NULL;
     umesh->nb_elementnodes = 0;
   }
 
   if (umesh->elementtypes != NULL)  // if any elementtypes...
   {
-    free(umesh->elementtypes);
+    AH5_release(umesh->elementtypes);
     umesh->elementtypes = NULL;
     umesh->nb_elementtypes = 0;
   }
 
   if (umesh->nodes != NULL)  // if any nodes...
   {
-    free(umesh->nodes);
+    AH5_release(umesh->nodes);
     umesh->nodes = NULL;
     umesh->nb_nodes[0] = 0;
     umesh->nb_nodes[1] = 0;
@@ -3058,7 +3844,7 @@ void AH5_free_umesh(AH5_umesh_t *umesh)
     for (i = 0; i < umesh->nb_groups; i++)    // for each group...
     {
       free(umesh->groups[i].path);  // free group name
-      free(umesh->groups[i].groupelts);  // free group values (no need to assign NULL & set nb_groupelts to 0
+      AH5_release(umesh->groups[i].groupelts);  // free group values (no need to assign NULL & set nb_groupelts to 0
     }
     free(umesh->groups);  // free space for pointers to groups
     umesh->groups = NULL;
@@ -3285,3 +4071,75 @@ int AH5_element_size(char element_type)
 
   return size;
 }
+
+
+// Build the element offsets index of an unstructured mesh.
+AH5_uelement_index_t *AH5_init_uelement_index(
+    AH5_uelement_index_t *index, const AH5_umesh_t *umesh)
+{
+  int sizes[256];
+  hsize_t i, nb_elements;
+  hsize_t *offsets;
+  int invalid = 0;
+
+  if (!index || !umesh)
+    return NULL;
+
+  index->nb_elements = 0;
+  index->offsets = NULL;
+
+  // The element sizes indexed by the (unsigned) element type.
+  for (i = 0; i < 256; ++i)
+    sizes[i] = AH5_element_size((char) i);
+
+  nb_elements = umesh->nb_elementtypes;
+  offsets = (hsize_t *) malloc((size_t) (nb_elements + 1) * sizeof(hsize_t));
+  if (!offsets)
+    return NULL;
+
+  // First gather the element sizes then sum them.
+  offsets[0] = 0;
+  for (i = 0; i < nb_elements; ++i)
+    offsets[i + 1] = sizes[(unsigned char) umesh->elementtypes[i]];
+  for (i = 0; i < nb_elements; ++i)
+    invalid |= (offsets[i + 1] == 0);
+  for (i = 0; i < nb_elements; ++i)
+    offsets[i + 1] += offsets[i];
+
+  if (invalid || offsets[nb_elements] != umesh->nb_elementnodes)
+  {
+    AH5_log_error("Unstructured mesh: the element nodes do not match the element types.");
+    free(offsets);
+    return NULL;
+  }
+
+  index->nb_elements = nb_elements;
+  index->offsets = offsets;
+  return index;
+}
+
+
+void AH5_free_uelement_index(AH5_uelement_index_t *index)
+{
+  if (index)
+  {
+    free(index->offsets);
+    index->offsets = NULL;
+    index->nb_elements = 0;
+  }
+}
+
+
+char AH5_uelement_type(const AH5_umesh_t *umesh, hsize_t i)
+{
+  return umesh->elementtypes[i];
+}
+
+
+int *AH5_uelement_nodes(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, hsize_t i, int *nb_nodes)
+{
+  if (nb_nodes)
+    *nb_nodes = (int) AH5_UELEMENT_SIZE(index, i);
+  return umesh->elementnodes + AH5_UELEMENT_OFFSET(index, i);
+}
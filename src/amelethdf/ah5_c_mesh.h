@@ -149,6 +149,58 @@ typedef struct _AH5_umesh_t
   AH5_usom_table_t *som_tables;
 } AH5_umesh_t;
 
+/**
+ * Element offsets (CSR) index of an unstructured mesh.
+ *
+ * The nodes of the element i are elementnodes[offsets[i]] up to
+ * elementnodes[offsets[i + 1] - 1], so offsets holds nb_elements + 1 values
+ * and offsets[nb_elements] is the number of element nodes.
+ *
+ * @def AH5_UELEMENT_OFFSET(index, i)
+ * The offset of the element i first node into umesh.elementnodes
+ * @def AH5_UELEMENT_SIZE(index, i)
+ * The number of nodes of the element i
+ */
+typedef struct _AH5_uelement_index_t
+{
+  hsize_t         nb_elements;
+  hsize_t         *offsets;
+} AH5_uelement_index_t;
+
+/**
+ * Parts of a lazy unstructured mesh (see AH5_release_umesh_handle).
+ */
+typedef enum _AH5_umesh_part_t
+{
+  AH5_UMESH_NODES         = 1,
+  AH5_UMESH_ELEMENTS      = 2,
+  AH5_UMESH_GROUPS        = 4,
+  AH5_UMESH_GROUPGROUPS   = 8,
+  AH5_UMESH_SOM_TABLES    = 16,
+  AH5_UMESH_ALL           = 31
+} AH5_umesh_part_t;
+
+/**
+ * Lazy unstructured mesh.
+ *
+ * The handle records the sizes (umesh.nb_*) and the sub-objects names when
+ * opened. The payloads, groups, groupGroups and selectors on mesh are read
+ * on first access and can be released at any time. The file must stay open
+ * while the handle is in use.
+ */
+typedef struct _AH5_umesh_handle_t
+{
+  hid_t           file_id;
+  char            *path;
+  AH5_umesh_t     umesh;
+  AH5_names_t     groups;
+  AH5_names_t     groupgroups;
+  AH5_names_t     som_tables;
+} AH5_umesh_handle_t;
+
+#define AH5_UELEMENT_OFFSET(index, i) ((index)->offsets[(i)])
+#define AH5_UELEMENT_SIZE(index, i) ((index)->offsets[(i) + 1] - (index)->offsets[(i)])
+
 typedef enum _AH5_mesh_class_t
 {
   MSH_INVALID             = -1,
@@ -247,17 +299,114 @@ AH5_PUBLIC char AH5_read_axis(hid_t file_id, const char *path, AH5_axis_t *axis)
 AH5_PUBLIC char AH5_read_smsh_group(  // deprecated in favor of AH5_read_sgroup
     hid_t file_id, const char *path, AH5_sgroup_t *sgroup);
 AH5_PUBLIC char AH5_read_sgroup(hid_t file_id, const char *path, AH5_sgroup_t *sgroup);
+AH5_PUBLIC char AH5_read_sgroups(
+    hid_t file_id, const char *path, hsize_t *nb_groups, AH5_sgroup_t **groups);
 AH5_PUBLIC char AH5_read_ssom_pie_table(hid_t file_id, const char *path, AH5_ssom_pie_table_t *som);
 AH5_PUBLIC char AH5_read_smesh(hid_t file_id, const char *path, AH5_smesh_t *smesh);
 AH5_PUBLIC char AH5_read_umsh_group(  // deprecated in favor of AH5_read_ugroup
     hid_t file_id, const char *path, AH5_ugroup_t *ugroup);
 AH5_PUBLIC char AH5_read_ugroup(hid_t file_id, const char *path, AH5_ugroup_t *ugroup);
+AH5_PUBLIC char AH5_read_ugroups(
+    hid_t file_id, const char *path, hsize_t *nb_groups, AH5_ugroup_t **groups);
 AH5_PUBLIC char AH5_read_usom_pie_table(hid_t file_id, const char *path, AH5_usom_pie_table_t *som);
 AH5_PUBLIC char AH5_read_usom_ef_table(hid_t file_id, const char *path, AH5_usom_ef_table_t *som);
 AH5_PUBLIC char AH5_read_umesh_som_table(  // deprecated in favor of AH5_read_usom_table
     hid_t file_id, const char *path, AH5_usom_table_t *som);
 AH5_PUBLIC char AH5_read_usom_table(hid_t file_id, const char *path, AH5_usom_table_t *som);
 AH5_PUBLIC char AH5_read_umesh(hid_t file_id, const char *path, AH5_umesh_t *umesh);
+/**
+ * Read a range of an unstructured mesh datasets without loading the mesh.
+ *
+ * The nodes [first, first + count) are read into nodes which must hold count
+ * times the nodes dimension (the 'nodes' dataset second dimension) values.
+ * The element nodes (or types) [first, first + count) are read into
+ * elementnodes (or elementtypes) which must hold count values.
+ *
+ * @param file_id the file or a parent node
+ * @param path the unstructured mesh path
+ * @param first the first value to read
+ * @param count the number of values to read
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_umesh_nodes_slab(
+    hid_t file_id, const char *path, hsize_t first, hsize_t count, float *nodes);
+AH5_PUBLIC char AH5_read_umesh_elementnodes_slab(
+    hid_t file_id, const char *path, hsize_t first, hsize_t count, int *elementnodes);
+AH5_PUBLIC char AH5_read_umesh_elementtypes_slab(
+    hid_t file_id, const char *path, hsize_t first, hsize_t count, char *elementtypes);
+
+/**
+ * Read a range of nodes in double precision or of element nodes with 64-bit
+ * indices, without narrowing.
+ *
+ * @see AH5_read_umesh_nodes_slab
+ */
+AH5_PUBLIC char AH5_read_umesh_nodes_dbl_slab(
+    hid_t file_id, const char *path, hsize_t first, hsize_t count, double *nodes);
+AH5_PUBLIC char AH5_read_umesh_elementnodes_i64_slab(
+    hid_t file_id, const char *path, hsize_t first, hsize_t count, int64_t *elementnodes);
+
+/**
+ * Callback called by AH5_read_umesh_elements_blocks for each block of elements.
+ *
+ * @param first_element the index of the first element of the block
+ * @param nb_elements the number of elements of the block
+ * @param elementtypes the element types of the block
+ * @param first_elementnode the offset of the block connectivity in 'elementNodes'
+ * @param nb_elementnodes the size of the block connectivity
+ * @param elementnodes the block connectivity (the nodes of elementtypes[0] first)
+ * @param user_data the user data given to AH5_read_umesh_elements_blocks
+ *
+ * @return AH5_TRUE to go on, AH5_FALSE to stop the reading.
+ */
+typedef char (*AH5_umesh_elements_block_func_t)(
+    hsize_t first_element, hsize_t nb_elements, const char *elementtypes,
+    hsize_t first_elementnode, hsize_t nb_elementnodes, const int *elementnodes,
+    void *user_data);
+
+/**
+ * Callback called by AH5_read_umesh_nodes_blocks for each block of nodes.
+ *
+ * @param first_node the index of the first node of the block
+ * @param nb_nodes the number of nodes of the block
+ * @param nodes_dim the nodes dimension (the 'nodes' second dimension)
+ * @param nodes the nodes coordinates of the block
+ * @param user_data the user data given to AH5_read_umesh_nodes_blocks
+ *
+ * @return AH5_TRUE to go on, AH5_FALSE to stop the reading.
+ */
+typedef char (*AH5_umesh_nodes_block_func_t)(
+    hsize_t first_node, hsize_t nb_nodes, hsize_t nodes_dim, const float *nodes,
+    void *user_data);
+
+/**
+ * Walk the unstructured mesh elements by blocks of block_size elements.
+ *
+ * Only one block of 'elementTypes' and the matching slice of 'elementNodes'
+ * are kept in memory, so the memory used does not depend on the mesh size.
+ *
+ * @param file_id the file or a parent node
+ * @param path the unstructured mesh path
+ * @param block_size the maximum number of elements in a block
+ * @param func the callback called for each block
+ * @param user_data passed to func
+ *
+ * @return AH5_TRUE if all the elements were read and func never returned
+ * AH5_FALSE.
+ */
+AH5_PUBLIC char AH5_read_umesh_elements_blocks(
+    hid_t file_id, const char *path, hsize_t block_size,
+    AH5_umesh_elements_block_func_t func, void *user_data);
+
+/**
+ * Walk the unstructured mesh nodes by blocks of block_size nodes.
+ *
+ * @see AH5_read_umesh_elements_blocks
+ */
+AH5_PUBLIC char AH5_read_umesh_nodes_blocks(
+    hid_t file_id, const char *path, hsize_t block_size,
+    AH5_umesh_nodes_block_func_t func, void *user_data);
 AH5_PUBLIC char AH5_read_msh_instance(
     hid_t file_id, const char *path, AH5_msh_instance_t *msh_instance);
 AH5_PUBLIC char AH5_read_mlk_instance(
@@ -333,6 +482,67 @@ AH5_PUBLIC AH5_umesh_t *AH5_copy_umesh(AH5_umesh_t *destination, const AH5_umesh
 // Define some useful tools to work on mesh
 AH5_PUBLIC int AH5_element_size(char element_type);
 
+/**
+ * Build the element offsets index of an unstructured mesh in one pass.
+ *
+ * @param[out] index the index to build, free it with AH5_free_uelement_index
+ * @param[in] umesh the unstructured mesh
+ *
+ * @return index on success, NULL if an element type is invalid or if the
+ * element nodes do not match the element types.
+ */
+AH5_PUBLIC AH5_uelement_index_t *AH5_init_uelement_index(
+    AH5_uelement_index_t *index, const AH5_umesh_t *umesh);
+AH5_PUBLIC void AH5_free_uelement_index(AH5_uelement_index_t *index);
+
+/**
+ * Return the type of the element i of umesh.
+ */
+AH5_PUBLIC char AH5_uelement_type(const AH5_umesh_t *umesh, hsize_t i);
+
+/**
+ * Return the nodes of the element i of umesh.
+ *
+ * @param[in] umesh the unstructured mesh
+ * @param[in] index the umesh element index
+ * @param[in] i the element
+ * @param[out] nb_nodes the number of nodes of the element (can be NULL)
+ *
+ * @return a pointer on the first node of the element into umesh.elementnodes.
+ */
+AH5_PUBLIC int *AH5_uelement_nodes(
+    const AH5_umesh_t *umesh, const AH5_uelement_index_t *index, hsize_t i, int *nb_nodes);
+
+/**
+ * Open a lazy unstructured mesh, only the sizes and the names are read.
+ *
+ * @param[in] file_id the file identifier
+ * @param[in] path the mesh path
+ * @param[out] handle the handle, release it with AH5_close_umesh_handle
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_open_umesh_handle(hid_t file_id, const char *path, AH5_umesh_handle_t *handle);
+AH5_PUBLIC void AH5_close_umesh_handle(AH5_umesh_handle_t *handle);
+
+/**
+ * Access a part of a lazy unstructured mesh, it is read on first access.
+ *
+ * @return the part (owned by the handle) or NULL on failure.
+ */
+AH5_PUBLIC float *AH5_umesh_handle_nodes(AH5_umesh_handle_t *handle);
+AH5_PUBLIC int *AH5_umesh_handle_elementnodes(AH5_umesh_handle_t *handle);
+AH5_PUBLIC char *AH5_umesh_handle_elementtypes(AH5_umesh_handle_t *handle);
+AH5_PUBLIC AH5_ugroup_t *AH5_umesh_handle_group(AH5_umesh_handle_t *handle, hsize_t i);
+AH5_PUBLIC AH5_groupgroup_t *AH5_umesh_handle_groupgroup(AH5_umesh_handle_t *handle, hsize_t i);
+AH5_PUBLIC AH5_usom_table_t *AH5_umesh_handle_som_table(AH5_umesh_handle_t *handle, hsize_t i);
+
+/**
+ * Release the loaded parts (an AH5_umesh_part_t combination) of a lazy
+ * unstructured mesh, they are read again on next access.
+ */
+AH5_PUBLIC void AH5_release_umesh_handle(AH5_umesh_handle_t *handle, int parts);
+
 
 #ifdef __cplusplus
 }
@@ -72,7 +72,9 @@ extern "C" {
 #define AH5_FALSE                       0
 #define AH5_NATIVE_CHAR                 H5T_STD_I8LE   // NATIVE Amelet-HDF data type
 #define AH5_NATIVE_INT                  H5T_STD_I32LE
+#define AH5_NATIVE_INT64                H5T_STD_I64LE
 #define AH5_NATIVE_FLOAT                H5T_IEEE_F32LE
+#define AH5_NATIVE_DOUBLE               H5T_IEEE_F64LE
 #define AH5_NATIVE_STRING               H5T_FORTRAN_S1
 #define AH5_TYPE_FLOAT                  H5T_FLOAT
 #define AH5_TYPE_INTEGER                H5T_INTEGER
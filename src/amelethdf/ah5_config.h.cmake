@@ -14,6 +14,8 @@
 
 #define AH5_MPI_ENABME_ @AMELETHDF_ENABLE_MPI@
 
+#define AH5_WITH_PTHREADS_ @AMELETHDF_WITH_PTHREADS@
+
 #if @AMELETHDF_DEBUG@
 # define AH5__DEBUG 1
 #else
@@ -1,76 +1,247 @@
 #include "ah5_dataset.h"
+#include "ah5_edataset.h"
 #include "ah5_log.h"
 
-// Read 1D int dataset
-char AH5_read_int_dataset(hid_t file_id, const char *path, const hsize_t mn, int **rdata)
+#if AH5_WITH_PTHREADS_
+#include <pthread.h>
+#endif
+
+// Read a whole dataset into buffer if it holds at most capacity values.
+static char AH5_read_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                  hid_t mem_type, void *buffer)
 {
   char success = AH5_FALSE;
-  hid_t dset_id;
+  hid_t dset_id, space_id;
+  hssize_t nb_values = -1;
 
-  *rdata = (int *) malloc((size_t) mn * sizeof(int));
   dset_id = H5Dopen(file_id, path, H5P_DEFAULT);
-  if (H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, *rdata) >= 0)
-    success = AH5_TRUE;
-  H5Dclose(dset_id);
-  if (!success)
+  if (dset_id < 0)
+    return AH5_FALSE;
+
+  space_id = H5Dget_space(dset_id);
+  if (space_id >= 0)
   {
-    free(*rdata);
-    *rdata = NULL;
+    nb_values = H5Sget_simple_extent_npoints(space_id);
+    H5Sclose(space_id);
   }
+
+  if (nb_values >= 0 && (hsize_t) nb_values > capacity)
+    AH5_log_error("Dataset '%s' holds %lu values, the buffer only %lu.",
+                  path, (unsigned long) nb_values, (unsigned long) capacity);
+  else if (nb_values >= 0)
+    if (H5Dread(dset_id, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer) >= 0)
+      success = AH5_TRUE;
+
+  H5Dclose(dset_id);
   return success;
 }
 
 
-// Read 1D float dataset
-char AH5_read_flt_dataset(hid_t file_id, const char *path, const hsize_t mn, float **rdata)
+// Read 1D int dataset into a caller buffer
+char AH5_read_int_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               hid_t mem_type, int *buffer)
+{
+  if (mem_type == H5P_DEFAULT)
+    mem_type = H5T_NATIVE_INT;
+  return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+}
+
+
+// Read 1D char dataset into a caller buffer
+char AH5_read_char_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                hid_t mem_type, char *buffer)
+{
+  if (mem_type == H5P_DEFAULT)
+    mem_type = H5T_NATIVE_CHAR;
+  return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+}
+
+
+// Read 1D float dataset into a caller buffer
+char AH5_read_flt_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               hid_t mem_type, float *buffer)
+{
+  if (mem_type == H5P_DEFAULT)
+    mem_type = H5T_NATIVE_FLOAT;
+  return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+}
+
+
+// Read 1D complex float dataset into a caller buffer
+char AH5_read_cpx_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               hid_t mem_type, AH5_complex_t *buffer)
+{
+  char success;
+  hid_t type_id;
+
+  if (mem_type != H5P_DEFAULT)
+    return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+
+  type_id = AH5_H5Tcreate_cpx_memtype();
+  success = AH5_read_dataset_into(file_id, path, capacity, type_id, buffer);
+  H5Tclose(type_id);
+  return success;
+}
+
+
+// Read 1D double dataset into a caller buffer
+char AH5_read_dbl_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               hid_t mem_type, double *buffer)
+{
+  if (mem_type == H5P_DEFAULT)
+    mem_type = H5T_NATIVE_DOUBLE;
+  return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+}
+
+
+// Read 1D 64-bit int dataset into a caller buffer
+char AH5_read_i64_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               hid_t mem_type, int64_t *buffer)
+{
+  if (mem_type == H5P_DEFAULT)
+    mem_type = H5T_NATIVE_INT64;
+  return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+}
+
+
+// Read 1D complex double dataset into a caller buffer
+char AH5_read_dcpx_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                hid_t mem_type, AH5_dcomplex_t *buffer)
+{
+  char success;
+  hid_t type_id;
+
+  if (mem_type != H5P_DEFAULT)
+    return AH5_read_dataset_into(file_id, path, capacity, mem_type, buffer);
+
+  type_id = AH5_H5Tcreate_dcpx_memtype();
+  success = AH5_read_dataset_into(file_id, path, capacity, type_id, buffer);
+  H5Tclose(type_id);
+  return success;
+}
+
+
+// Read 1D string dataset into a caller buffer
+char AH5_read_str_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                               size_t length, hid_t mem_type, char *buffer)
 {
   char success = AH5_FALSE;
-  hid_t dset_id;
+  hid_t memtype = mem_type;
 
-  *rdata = (float *) malloc((size_t) mn * sizeof(float));
-  dset_id = H5Dopen(file_id, path, H5P_DEFAULT);
-  if (H5Dread(dset_id, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, *rdata) >= 0)
-    success = AH5_TRUE;
-  H5Dclose(dset_id);
-  if (!success)
+  if (mem_type == H5P_DEFAULT)
   {
-    free(*rdata);
-    *rdata = NULL;
+    memtype = H5Tcopy(H5T_C_S1);
+    if (H5Tset_size(memtype, length + 1) < 0)  // make a space for the null terminator
+    {
+      H5Tclose(memtype);
+      return AH5_FALSE;
+    }
   }
+
+  success = AH5_read_dataset_into(file_id, path, capacity, memtype, buffer);
+
+  if (mem_type == H5P_DEFAULT)
+    H5Tclose(memtype);
   return success;
 }
 
 
+// Read 1D int dataset
+char AH5_read_int_dataset(hid_t file_id, const char *path, const hsize_t mn, int **rdata)
+{
+  *rdata = (int *) malloc((size_t) mn * sizeof(int));
+  if (AH5_read_int_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
+// Read 1D float dataset
+char AH5_read_flt_dataset(hid_t file_id, const char *path, const hsize_t mn, float **rdata)
+{
+  *rdata = (float *) malloc((size_t) mn * sizeof(float));
+  if (AH5_read_flt_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
 // Read 1D complex float dataset
 char AH5_read_cpx_dataset(hid_t file_id, const char *path, const hsize_t mn, AH5_complex_t **rdata)
 {
-  char success = AH5_FALSE;
-  hid_t dset_id, type_id;
-  hsize_t i;
-  float *buf = NULL;
-
   *rdata = (AH5_complex_t *) malloc((size_t) mn * sizeof(AH5_complex_t));
-  buf = (float *) malloc((size_t) mn * 2 * sizeof(float));
-  type_id = AH5_H5Tcreate_cpx_memtype();
+  if (AH5_read_cpx_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
+// Read 1D double dataset
+char AH5_read_dbl_dataset(hid_t file_id, const char *path, const hsize_t mn, double **rdata)
+{
+  *rdata = (double *) malloc((size_t) mn * sizeof(double));
+  if (AH5_read_dbl_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
+// Read 1D 64-bit int dataset
+char AH5_read_i64_dataset(hid_t file_id, const char *path, const hsize_t mn, int64_t **rdata)
+{
+  *rdata = (int64_t *) malloc((size_t) mn * sizeof(int64_t));
+  if (AH5_read_i64_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
+// Read 1D complex double dataset
+char AH5_read_dcpx_dataset(hid_t file_id, const char *path, const hsize_t mn,
+                           AH5_dcomplex_t **rdata)
+{
+  *rdata = (AH5_dcomplex_t *) malloc((size_t) mn * sizeof(AH5_dcomplex_t));
+  if (AH5_read_dcpx_dataset_into(file_id, path, mn, H5P_DEFAULT, *rdata))
+    return AH5_TRUE;
+
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+
+// Native memory type of a dataset
+hid_t AH5_get_dataset_memtype(hid_t file_id, const char *path)
+{
+  hid_t dset_id, type_id, mem_type = -1;
 
   dset_id = H5Dopen(file_id, path, H5P_DEFAULT);
+  if (dset_id < 0)
+    return -1;
 
-  if (H5Dread(dset_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0)
+  type_id = H5Dget_type(dset_id);
+  if (type_id >= 0)
   {
-    success = AH5_TRUE;
-    for (i = 0; i < mn; i++)
-      rdata[0][i] = AH5_set_complex(buf[2*i], buf[2*i+1]);
+    mem_type = H5Tget_native_type(type_id, H5T_DIR_ASCEND);
+    H5Tclose(type_id);
   }
   H5Dclose(dset_id);
-  H5Tclose(type_id);
-  if (buf != NULL)
-    free(buf);
-  if (!success)
-  {
-    free(*rdata);
-    *rdata = NULL;
-  }
-  return success;
+  return mem_type;
 }
 
 
@@ -78,32 +249,359 @@ char AH5_read_cpx_dataset(hid_t file_id, const char *path, const hsize_t mn, AH5
 char AH5_read_str_dataset(hid_t file_id, const char *path, const hsize_t mn, size_t length,
                           char ***rdata)
 {
-  char success = AH5_FALSE;
-  hid_t dset_id, memtype;
   hsize_t i;
 
-  length++; // make a space for the null terminator
-  dset_id = H5Dopen(file_id, path, H5P_DEFAULT);
-
   *rdata = (char **) malloc((size_t) mn * sizeof(char *));
-  **rdata = (char *) malloc((size_t) mn * length * sizeof(char));
+  **rdata = (char *) malloc((size_t) mn * (length + 1) * sizeof(char));
   for (i = 1; i < mn; i++)
-    rdata[0][i] = rdata[0][0] + i * length;
-  memtype = H5Tcopy(H5T_C_S1);
-  if (H5Tset_size(memtype, length) >= 0)
-    if (H5Dread(dset_id, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, **rdata) >= 0)
+    rdata[0][i] = rdata[0][0] + i * (length + 1);
+  if (AH5_read_str_dataset_into(file_id, path, mn, length, H5P_DEFAULT, **rdata))
+    return AH5_TRUE;
+
+  free(**rdata);
+  free(*rdata);
+  *rdata = NULL;
+  return AH5_FALSE;
+}
+
+// Read a hyperslab of a dataset
+char AH5_read_dataset_slab(hid_t file_id, const char *path, const int rank,
+                           const hsize_t start[], const hsize_t count[],
+                           const hsize_t stride[], hid_t mem_type, void *buffer)
+{
+  char success = AH5_FALSE;
+  hid_t dset_id, file_space, mem_space;
+  hsize_t nb_values = 1;
+  int i;
+
+  for (i = 0; i < rank; i++)
+    nb_values *= count[i];
+  if (nb_values == 0)
+    return AH5_TRUE;
+
+  dset_id = H5Dopen(file_id, path, H5P_DEFAULT);
+  if (dset_id < 0)
+    return AH5_FALSE;
+
+  file_space = H5Dget_space(dset_id);
+  if (H5Sget_simple_extent_ndims(file_space) != rank)
+    AH5_log_error("Dataset '%s' is not of rank %d.", path, rank);
+  else if (H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, stride, count, NULL) < 0
+           || H5Sselect_valid(file_space) <= 0)
+    AH5_log_error("Invalid selection in dataset '%s'.", path);
+  else
+  {
+    mem_space = H5Screate_simple(1, &nb_values, NULL);
+    if (H5Dread(dset_id, mem_type, mem_space, file_space, H5P_DEFAULT, buffer) >= 0)
       success = AH5_TRUE;
-  H5Tclose(memtype);
+    H5Sclose(mem_space);
+  }
+
+  H5Sclose(file_space);
   H5Dclose(dset_id);
-  if (!success)
+  return success;
+}
+
+
+// Read a hyperslab of an int dataset
+char AH5_read_int_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], int *buffer)
+{
+  return AH5_read_dataset_slab(file_id, path, rank, start, count, stride, H5T_NATIVE_INT, buffer);
+}
+
+
+// Read a hyperslab of a float dataset
+char AH5_read_flt_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], float *buffer)
+{
+  return AH5_read_dataset_slab(file_id, path, rank, start, count, stride, H5T_NATIVE_FLOAT,
+                               buffer);
+}
+
+
+// Read a hyperslab of a double dataset
+char AH5_read_dbl_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], double *buffer)
+{
+  return AH5_read_dataset_slab(file_id, path, rank, start, count, stride, H5T_NATIVE_DOUBLE,
+                               buffer);
+}
+
+
+// Read a hyperslab of a 64-bit int dataset
+char AH5_read_i64_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], int64_t *buffer)
+{
+  return AH5_read_dataset_slab(file_id, path, rank, start, count, stride, H5T_NATIVE_INT64,
+                               buffer);
+}
+
+
+// Read a hyperslab of a complex double dataset
+char AH5_read_dcpx_slab(hid_t file_id, const char *path, const int rank,
+                        const hsize_t start[], const hsize_t count[],
+                        const hsize_t stride[], AH5_dcomplex_t *buffer)
+{
+  char success;
+  hid_t type_id;
+
+  type_id = AH5_H5Tcreate_dcpx_memtype();
+  success = AH5_read_dataset_slab(file_id, path, rank, start, count, stride, type_id, buffer);
+  H5Tclose(type_id);
+  return success;
+}
+
+
+// Read a hyperslab of a complex float dataset
+char AH5_read_cpx_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], AH5_complex_t *buffer)
+{
+  char success;
+  hid_t type_id;
+
+  type_id = AH5_H5Tcreate_cpx_memtype();
+  success = AH5_read_dataset_slab(file_id, path, rank, start, count, stride, type_id, buffer);
+  H5Tclose(type_id);
+  return success;
+}
+
+
+// Read a hyperslab of a string dataset
+char AH5_read_str_slab(hid_t file_id, const char *path, const int rank,
+                       const hsize_t start[], const hsize_t count[],
+                       const hsize_t stride[], size_t length, char *buffer)
+{
+  char success = AH5_FALSE;
+  hid_t memtype;
+
+  memtype = H5Tcopy(H5T_C_S1);
+  if (H5Tset_size(memtype, length + 1) >= 0)  // make a space for the null terminator
+    success = AH5_read_dataset_slab(file_id, path, rank, start, count, stride, memtype, buffer);
+  H5Tclose(memtype);
+  return success;
+}
+
+
+typedef struct _AH5_file_filter_policy_t
+{
+  hid_t               file_id;
+  AH5_filter_policy_t policy;
+} AH5_file_filter_policy_t;
+
+// The policies are read by the background writer, they are locked.
+static char AH5_has_default_filter_policy = AH5_FALSE;
+static AH5_filter_policy_t AH5_default_filter_policy;
+static AH5_file_filter_policy_t *AH5_file_filter_policies = NULL;
+static int AH5_nb_file_filter_policies = 0;
+static int AH5_file_filter_policies_capacity = 0;
+#if AH5_WITH_PTHREADS_
+static pthread_mutex_t AH5_filter_policy_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+void AH5_init_filter_policy(AH5_filter_policy_t *policy)
+{
+  policy->deflate = 0;
+  policy->shuffle = AH5_FALSE;
+  policy->int_scaleoffset = AH5_FALSE;
+  policy->float_digits = -1;
+  policy->min_size = 0;
+}
+
+
+// Set the policy of a file, the lock is held.
+static char AH5_set_file_filter_policy(hid_t file_id, const AH5_filter_policy_t *policy)
+{
+  AH5_file_filter_policy_t *policies;
+  int i, capacity;
+
+  if (file_id < 0)
+  {
+    AH5_has_default_filter_policy = policy != NULL;
+    if (policy)
+      AH5_default_filter_policy = *policy;
+    return AH5_TRUE;
+  }
+
+  for (i = 0; i < AH5_nb_file_filter_policies; ++i)
+    if (AH5_file_filter_policies[i].file_id == file_id)
+      break;
+
+  if (policy == NULL)
   {
-    free(**rdata);
-    free(*rdata);
-    *rdata = NULL;
+    if (i < AH5_nb_file_filter_policies)
+      AH5_file_filter_policies[i] = AH5_file_filter_policies[--AH5_nb_file_filter_policies];
+    return AH5_TRUE;
   }
+
+  if (i == AH5_file_filter_policies_capacity)
+  {
+    capacity = AH5_file_filter_policies_capacity ? 2 * AH5_file_filter_policies_capacity : 16;
+    policies = (AH5_file_filter_policy_t *) realloc(
+        AH5_file_filter_policies, capacity * sizeof(AH5_file_filter_policy_t));
+    if (policies == NULL)
+      return AH5_FALSE;
+    AH5_file_filter_policies = policies;
+    AH5_file_filter_policies_capacity = capacity;
+  }
+  if (i == AH5_nb_file_filter_policies)
+    ++AH5_nb_file_filter_policies;
+  AH5_file_filter_policies[i].file_id = file_id;
+  AH5_file_filter_policies[i].policy = *policy;
+  return AH5_TRUE;
+}
+
+
+char AH5_set_filter_policy(hid_t file_id, const AH5_filter_policy_t *policy)
+{
+  char success;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&AH5_filter_policy_lock);
+#endif
+  success = AH5_set_file_filter_policy(file_id, policy);
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&AH5_filter_policy_lock);
+#endif
   return success;
 }
 
+
+// Copy the policy of the file of loc_id (AH5_FALSE if none).
+static char AH5_get_filter_policy(hid_t loc_id, AH5_filter_policy_t *policy)
+{
+  char found = AH5_FALSE;
+  hid_t file_id;
+  int i;
+
+  // the id of an open file is returned, with one more reference
+  file_id = H5Iget_file_id(loc_id);
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&AH5_filter_policy_lock);
+#endif
+  if (file_id >= 0)
+    for (i = 0; i < AH5_nb_file_filter_policies && !found; ++i)
+      if (AH5_file_filter_policies[i].file_id == file_id)
+      {
+        *policy = AH5_file_filter_policies[i].policy;
+        found = AH5_TRUE;
+      }
+  if (!found && AH5_has_default_filter_policy)
+  {
+    *policy = AH5_default_filter_policy;
+    found = AH5_TRUE;
+  }
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&AH5_filter_policy_lock);
+#endif
+
+  if (file_id >= 0)
+    H5Fclose(file_id);
+  return found;
+}
+
+
+char AH5_set_dataset_filters(hid_t plist, hid_t loc_id, hid_t type_id, int rank,
+                             const hsize_t dims[], const hsize_t chunk_dims[])
+{
+  AH5_filter_policy_t file_policy;
+  const AH5_filter_policy_t *policy = &file_policy;
+  H5T_class_t type_class;
+  size_t type_size;
+  hsize_t size, *chunks;
+  char scaleoffset, shuffle, deflate;
+  int i;
+
+  if (!AH5_get_filter_policy(loc_id, &file_policy))
+    return AH5_FALSE;
+
+  type_class = H5Tget_class(type_id);
+  type_size = H5Tget_size(type_id);
+  scaleoffset = ((type_class == H5T_INTEGER && policy->int_scaleoffset)
+                 || (type_class == H5T_FLOAT && policy->float_digits >= 0))
+                && H5Zfilter_avail(H5Z_FILTER_SCALEOFFSET) > 0;
+  // the scale-offset output is not byte aligned, shuffle would not help
+  shuffle = policy->shuffle && !scaleoffset && H5Zfilter_avail(H5Z_FILTER_SHUFFLE) > 0;
+  deflate = policy->deflate > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0;
+  if (!scaleoffset && !shuffle && !deflate)
+    return AH5_FALSE;
+
+  if (chunk_dims == NULL)
+  {
+    size = type_size;
+    for (i = 0; i < rank; ++i)
+      size *= dims[i];
+    if (size == 0 || size < policy->min_size)
+      return AH5_FALSE;
+
+    chunks = (hsize_t *) malloc(rank * sizeof(hsize_t));
+    AH5_earray_chunk_dims(rank, dims, dims, type_size, chunks);
+    i = H5Pset_chunk(plist, rank, chunks) >= 0;
+    free(chunks);
+    if (!i)
+      return AH5_FALSE;
+  }
+
+  if (scaleoffset)
+  {
+    if (type_class == H5T_INTEGER)
+      H5Pset_scaleoffset(plist, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT);
+    else
+      H5Pset_scaleoffset(plist, H5Z_SO_FLOAT_DSCALE, policy->float_digits);
+  }
+  if (shuffle)
+    H5Pset_shuffle(plist);
+  if (deflate)
+    H5Pset_deflate(plist, policy->deflate > 9 ? 9 : policy->deflate);
+
+  return AH5_TRUE;
+}
+
+
+// Create a dataset with the filter policy of loc_id.
+static hid_t AH5_create_dataset(hid_t loc_id, const char *dset_name, hid_t type_id,
+                                const int rank, const hsize_t dims[])
+{
+  hid_t space, plist, dset;
+
+  space = H5Screate_simple(rank, dims, NULL);
+  plist = H5Pcreate(H5P_DATASET_CREATE);
+  AH5_set_dataset_filters(plist, loc_id, type_id, rank, dims, NULL);
+  dset = H5Dcreate(loc_id, dset_name, type_id, space, H5P_DEFAULT, plist, H5P_DEFAULT);
+  H5Pclose(plist);
+  H5Sclose(space);
+
+  return dset;
+}
+
+
+// Create and write a whole dataset (like H5LTmake_dataset).
+static char AH5_make_dataset(hid_t loc_id, const char *dset_name, hid_t file_type,
+                             hid_t mem_type, const int rank, const hsize_t dims[],
+                             const void *wdata)
+{
+  char success = AH5_TRUE;
+  hid_t dset;
+
+  dset = AH5_create_dataset(loc_id, dset_name, file_type, rank, dims);
+  if (dset < 0)
+    return AH5_FALSE;
+
+  if (wdata && H5Dwrite(dset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata) < 0)
+    success = AH5_FALSE;
+  H5Dclose(dset);
+
+  return success;
+}
+
+
 // Write 1D char dataset
 char AH5_write_char_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
                             const char *wdata)
@@ -112,8 +610,7 @@ char AH5_write_char_dataset(hid_t loc_id, const char *dset_name, const hsize_t l
   char success = AH5_FALSE;
 
   // TODO: add check of loc_id using H5Oget_info()
-  if(H5LTmake_dataset_char(loc_id, dset_name, 1, dims, wdata) >= 0)
-    success = AH5_TRUE;
+  success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_CHAR, H5T_NATIVE_CHAR, 1, dims, wdata);
   return success;
 }
 
@@ -126,8 +623,7 @@ char AH5_write_int_dataset(hid_t loc_id, const char *dset_name, const hsize_t le
 
   H5Oget_info(loc_id, &info);
   if (info.type == H5O_TYPE_GROUP)
-    if (H5LTmake_dataset_int(loc_id, dset_name, 1, dims, wdata) >= 0)
-      success = AH5_TRUE;
+    success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_INT, H5T_NATIVE_INT, 1, dims, wdata);
   return success;
 }
 
@@ -142,8 +638,7 @@ char AH5_write_long_dataset(
 
   H5Oget_info(loc_id, &info);
   if (info.type == H5O_TYPE_GROUP)
-    if (H5LTmake_dataset_long(loc_id, dset_name, 1, dims, wdata) >= 0)
-      success = AH5_TRUE;
+    success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_LONG, H5T_NATIVE_LONG, 1, dims, wdata);
   return success;
 }
 
@@ -158,8 +653,7 @@ char AH5_write_flt_dataset(hid_t loc_id, const char *dset_name, const hsize_t le
 
   H5Oget_info(loc_id, &info);
   if (info.type == H5O_TYPE_GROUP)
-    if (H5LTmake_dataset_float(loc_id, dset_name, 1, dims, wdata) >= 0)
-      success = AH5_TRUE;
+    success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_FLOAT, H5T_NATIVE_FLOAT, 1, dims, wdata);
   return success;
 }
 
@@ -168,42 +662,60 @@ char AH5_write_flt_dataset(hid_t loc_id, const char *dset_name, const hsize_t le
 char AH5_write_cpx_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
                            const AH5_complex_t *wdata)
 {
-  hid_t cpx_filetype, cpx_memtype, space, dset;
   char success = AH5_FALSE;
   hsize_t dims[1] = {len};
   H5O_info_t info;
-  float *buf = NULL;
-  hsize_t i;
 
   H5Oget_info(loc_id, &info);
   if (info.type == H5O_TYPE_GROUP)
-  {
-    cpx_filetype = AH5_H5Tcreate_cpx_filetype();
-    cpx_memtype = AH5_H5Tcreate_cpx_memtype();
-    space = H5Screate_simple (1, dims, NULL);
+    success = AH5_write_cpx_array(loc_id, dset_name, 1, dims, wdata);
+  return success;
+}
 
-    if ((dset = H5Dcreate(loc_id, dset_name, cpx_filetype, space, H5P_DEFAULT, H5P_DEFAULT,
-                          H5P_DEFAULT)) >= 0)
-    {
-      buf = (float *) malloc((size_t) 2 * len * sizeof(float));
-      for (i = 0; i < len; ++i)
-      {
-        buf[2*i] = creal(wdata[i]);
-        buf[2*i+1] = cimag(wdata[i]);
-      }
 
-      if (H5Dwrite(dset, cpx_memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0)
-        success = AH5_TRUE;
+// Write 1D double dataset
+char AH5_write_dbl_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                           const double *wdata)
+{
+  char success = AH5_FALSE;
+  hsize_t dims[1] = {len};
+  H5O_info_t info;
 
-      free(buf);
-    }
+  H5Oget_info(loc_id, &info);
+  if (info.type == H5O_TYPE_GROUP)
+    success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_DOUBLE, H5T_NATIVE_DOUBLE, 1, dims,
+                               wdata);
+  return success;
+}
 
-    H5Dclose(dset);
-    H5Sclose(space);
-    H5Tclose(cpx_memtype);
-    H5Tclose(cpx_filetype);
-  }
 
+// Write 1D 64-bit int dataset
+char AH5_write_i64_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                           const int64_t *wdata)
+{
+  char success = AH5_FALSE;
+  hsize_t dims[1] = {len};
+  H5O_info_t info;
+
+  H5Oget_info(loc_id, &info);
+  if (info.type == H5O_TYPE_GROUP)
+    success = AH5_make_dataset(loc_id, dset_name, H5T_NATIVE_INT64, H5T_NATIVE_INT64, 1, dims,
+                               wdata);
+  return success;
+}
+
+
+// Write 1D complex double dataset
+char AH5_write_dcpx_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                            const AH5_dcomplex_t *wdata)
+{
+  char success = AH5_FALSE;
+  hsize_t dims[1] = {len};
+  H5O_info_t info;
+
+  H5Oget_info(loc_id, &info);
+  if (info.type == H5O_TYPE_GROUP)
+    success = AH5_write_dcpx_array(loc_id, dset_name, 1, dims, wdata);
   return success;
 }
 
@@ -215,7 +727,7 @@ char AH5_write_flat_str_dataset(hid_t loc_id, const char *dset_name, const hsize
                                 const size_t slen, char const* buf)
 {
   char success = AH5_FALSE;
-  hid_t filetype, memtype, space, dset;
+  hid_t filetype, memtype, dset;
   hsize_t dims[1] = {len};
 
   filetype = H5Tcopy(AH5_NATIVE_STRING);
@@ -223,15 +735,12 @@ char AH5_write_flat_str_dataset(hid_t loc_id, const char *dset_name, const hsize
   H5Tset_strpad(filetype, H5T_STR_NULLTERM);
   memtype = H5Tcopy(H5T_C_S1);
   H5Tset_size(memtype, slen);
-  space = H5Screate_simple(1, dims, NULL);
 
-  if ((dset = H5Dcreate(loc_id, dset_name, filetype, space, H5P_DEFAULT, H5P_DEFAULT,
-                        H5P_DEFAULT)) >= 0)
+  if ((dset = AH5_create_dataset(loc_id, dset_name, filetype, 1, dims)) >= 0)
     if (H5Dwrite(dset, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) >= 0)
       success = AH5_TRUE;
 
   H5Dclose(dset);
-  H5Sclose(space);
   H5Tclose(memtype);
   H5Tclose(filetype);
 
@@ -269,17 +778,7 @@ char AH5_write_str_dataset(hid_t loc_id, const char *dset_name, const hsize_t le
 char AH5_write_int_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
                          const int *wdata)
 {
-  char success = AH5_FALSE;
-  hid_t dataset_id, dataspace_id;
-
-  dataspace_id = H5Screate_simple(rank, dims, NULL);
-  dataset_id = H5Dcreate(loc_id, dset_name, AH5_NATIVE_INT, dataspace_id, H5P_DEFAULT, H5P_DEFAULT,
-                         H5P_DEFAULT);
-  if (H5Dwrite(dataset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata) >= 0)
-    success = AH5_TRUE;
-  H5Dclose(dataset_id);
-  H5Sclose(dataspace_id);
-  return success;
+  return AH5_make_dataset(loc_id, dset_name, AH5_NATIVE_INT, H5T_NATIVE_INT, rank, dims, wdata);
 }
 
 
@@ -287,28 +786,57 @@ char AH5_write_int_array(hid_t loc_id, const char *dset_name, const int rank, co
 char AH5_write_flt_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
                          const float *wdata)
 {
-  char success = AH5_FALSE;
-  hid_t dataset_id, dataspace_id;
-
-  dataspace_id = H5Screate_simple(rank, dims, NULL);
-  dataset_id = H5Dcreate(loc_id, dset_name, AH5_NATIVE_FLOAT, dataspace_id, H5P_DEFAULT, H5P_DEFAULT,
-                         H5P_DEFAULT);
-  if (H5Dwrite(dataset_id, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata) >= 0)
-    success = AH5_TRUE;
-  H5Dclose(dataset_id);
-  H5Sclose(dataspace_id);
+  return AH5_make_dataset(loc_id, dset_name, AH5_NATIVE_FLOAT, H5T_NATIVE_FLOAT, rank, dims, wdata);
+}
+
+
+// Write nD double dataset
+char AH5_write_dbl_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
+                         const double *wdata)
+{
+  return AH5_make_dataset(loc_id, dset_name, AH5_NATIVE_DOUBLE, H5T_NATIVE_DOUBLE, rank, dims,
+                          wdata);
+}
+
+
+// Write nD 64-bit int dataset
+char AH5_write_i64_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
+                         const int64_t *wdata)
+{
+  return AH5_make_dataset(loc_id, dset_name, AH5_NATIVE_INT64, H5T_NATIVE_INT64, rank, dims,
+                          wdata);
+}
+
+
+// Write nD complex double dataset
+char AH5_write_dcpx_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
+                          const AH5_dcomplex_t *wdata)
+{
+  char success;
+  hid_t dcpx_filetype, dcpx_memtype;
+
+  dcpx_filetype = AH5_H5Tcreate_dcpx_filetype();
+  dcpx_memtype = AH5_H5Tcreate_dcpx_memtype();
+  success = AH5_make_dataset(loc_id, dset_name, dcpx_filetype, dcpx_memtype, rank, dims, wdata);
+  H5Tclose(dcpx_memtype);
+  H5Tclose(dcpx_filetype);
+
   return success;
 }
 
 
 // Write nD complex float dataset
-char AH5_write_cpx_array(hid_t UNUSED(loc_id), const char *dset_name, const int UNUSED(rank), const hsize_t *UNUSED(dims),
-                         const AH5_complex_t *UNUSED(wdata))
+char AH5_write_cpx_array(hid_t loc_id, const char *dset_name, const int rank, const hsize_t dims[],
+                         const AH5_complex_t *wdata)
 {
-  char success = AH5_FALSE;
+  char success;
+  hid_t cpx_filetype, cpx_memtype;
 
-  // TO BE IMPLEMENTED...
-  AH5_PRINT_ERR_FUNC_NOT_IMPLEMENTED("Array", dset_name);
+  cpx_filetype = AH5_H5Tcreate_cpx_filetype();
+  cpx_memtype = AH5_H5Tcreate_cpx_memtype();
+  success = AH5_make_dataset(loc_id, dset_name, cpx_filetype, cpx_memtype, rank, dims, wdata);
+  H5Tclose(cpx_memtype);
+  H5Tclose(cpx_filetype);
 
   return success;
 }
@@ -321,7 +849,6 @@ char AH5_write_str_array(hid_t loc_id, const char *dset_name, const int rank, co
   hsize_t nbstr;
   size_t maxlength = 1;
   hid_t strtype;
-  hid_t dataspace_id;
   hid_t dataset_id;
 
   if (rank > 2)
@@ -337,14 +864,9 @@ char AH5_write_str_array(hid_t loc_id, const char *dset_name, const int rank, co
   strtype = H5Tcopy(H5T_C_S1);
   if (H5Tset_size(strtype, maxlength) < 0) return AH5_FALSE;
 
-  // Create a simple dataspace with the given dimension and the same max dimension
-  dataspace_id = H5Screate_simple(1, &nbstr, NULL);
-  if (dataspace_id < 0) return AH5_FALSE;
-
   // Create the dataset
-  dataset_id = H5Dcreate(loc_id, dset_name, strtype, dataspace_id, H5P_DEFAULT, H5P_DEFAULT,
-                         H5P_DEFAULT);
-  if (dataspace_id < 0) return AH5_FALSE;
+  dataset_id = AH5_create_dataset(loc_id, dset_name, strtype, 1, &nbstr);
+  if (dataset_id < 0) return AH5_FALSE;
 
   // Write the array
   if (H5Dwrite(dataset_id, strtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, wdata) < 0) return AH5_FALSE;
@@ -352,8 +874,5 @@ char AH5_write_str_array(hid_t loc_id, const char *dset_name, const int rank, co
   // Release the dataset
   if (H5Dclose (dataset_id) < 0) AH5_log_warn("Fail to close dataset.");
 
-  // Release dataspace
-  if (H5Sclose(dataspace_id) < 0) AH5_log_warn("Fail to close dataspace.");
-
   return AH5_TRUE;
 }
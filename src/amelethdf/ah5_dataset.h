@@ -15,6 +15,178 @@ AH5_PUBLIC char AH5_read_cpx_dataset(hid_t file_id, const char *path, const hsiz
                                      AH5_complex_t **rdata);
 AH5_PUBLIC char AH5_read_str_dataset(hid_t file_id, const char *path, const hsize_t mn,
                                      size_t length, char ***rdata);
+AH5_PUBLIC char AH5_read_dbl_dataset(hid_t file_id, const char *path, const hsize_t mn,
+                                     double **rdata);
+AH5_PUBLIC char AH5_read_i64_dataset(hid_t file_id, const char *path, const hsize_t mn,
+                                     int64_t **rdata);
+AH5_PUBLIC char AH5_read_dcpx_dataset(hid_t file_id, const char *path, const hsize_t mn,
+                                      AH5_dcomplex_t **rdata);
+
+/**
+ * Return the native memory type of a dataset (H5Tget_native_type of its
+ * type): a read into this memory type needs no conversion, for instance
+ * H5T_NATIVE_DOUBLE selects AH5_read_dbl_dataset over AH5_read_flt_dataset.
+ *
+ * @param file_id the location of the dataset
+ * @param path the dataset path
+ *
+ * @return the memory type to close with H5Tclose or a negative value.
+ */
+AH5_PUBLIC hid_t AH5_get_dataset_memtype(hid_t file_id, const char *path);
+
+/**
+ * Read a whole dataset into a caller-owned buffer.
+ *
+ * Unlike AH5_read_*_dataset, no memory is allocated: the dataset values are
+ * read into buffer which must hold at least capacity values. The read fails
+ * if the dataset holds more values than capacity.
+ *
+ * @param file_id the location of the dataset
+ * @param path the dataset path
+ * @param capacity the number of values buffer can hold
+ * @param mem_type the memory type of buffer or H5P_DEFAULT for the native type
+ * (AH5_H5Tcreate_cpx_memtype for complex)
+ * @param buffer the destination buffer
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_int_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          hid_t mem_type, int *buffer);
+AH5_PUBLIC char AH5_read_char_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                           hid_t mem_type, char *buffer);
+AH5_PUBLIC char AH5_read_flt_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          hid_t mem_type, float *buffer);
+AH5_PUBLIC char AH5_read_cpx_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          hid_t mem_type, AH5_complex_t *buffer);
+AH5_PUBLIC char AH5_read_dbl_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          hid_t mem_type, double *buffer);
+AH5_PUBLIC char AH5_read_i64_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          hid_t mem_type, int64_t *buffer);
+AH5_PUBLIC char AH5_read_dcpx_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                           hid_t mem_type, AH5_dcomplex_t *buffer);
+
+/**
+ * Read a string dataset into a caller-owned flat buffer.
+ *
+ * The strings are written one after the other, each one taking length + 1
+ * characters (null terminator included), buffer must hold at least
+ * capacity * (length + 1) characters.
+ *
+ * @param file_id the location of the dataset
+ * @param path the dataset path
+ * @param capacity the number of strings buffer can hold
+ * @param length the strings length (as given by H5LTget_dataset_info)
+ * @param mem_type the memory type of buffer or H5P_DEFAULT for C strings of
+ * length + 1 characters
+ * @param buffer the destination buffer
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_str_dataset_into(hid_t file_id, const char *path, const hsize_t capacity,
+                                          size_t length, hid_t mem_type, char *buffer);
+
+/**
+ * Read a hyperslab of a dataset into a caller-owned buffer.
+ *
+ * The selection is given per dimension (like H5Sselect_hyperslab) and the
+ * selected values are stored contiguously in buffer (row major order), buffer
+ * must hold the product of count values.
+ *
+ * @param file_id the location of the dataset
+ * @param path the dataset path
+ * @param rank the dataset rank, the size of start, count and stride
+ * @param start the offset of the first value along each dimension
+ * @param count the number of values to read along each dimension
+ * @param stride the step between two values along each dimension or NULL
+ * @param mem_type the memory type of buffer
+ * @param buffer the destination buffer
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_read_dataset_slab(hid_t file_id, const char *path, const int rank,
+                                      const hsize_t start[], const hsize_t count[],
+                                      const hsize_t stride[], hid_t mem_type, void *buffer);
+AH5_PUBLIC char AH5_read_int_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], int *buffer);
+AH5_PUBLIC char AH5_read_flt_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], float *buffer);
+AH5_PUBLIC char AH5_read_cpx_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], AH5_complex_t *buffer);
+AH5_PUBLIC char AH5_read_dbl_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], double *buffer);
+AH5_PUBLIC char AH5_read_i64_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], int64_t *buffer);
+AH5_PUBLIC char AH5_read_dcpx_slab(hid_t file_id, const char *path, const int rank,
+                                   const hsize_t start[], const hsize_t count[],
+                                   const hsize_t stride[], AH5_dcomplex_t *buffer);
+/**
+ * Read a hyperslab of a string dataset into a caller-owned flat buffer.
+ *
+ * @see AH5_read_dataset_slab and AH5_read_str_dataset_into for the buffer layout.
+ */
+AH5_PUBLIC char AH5_read_str_slab(hid_t file_id, const char *path, const int rank,
+                                  const hsize_t start[], const hsize_t count[],
+                                  const hsize_t stride[], size_t length, char *buffer);
+
+/**
+ * Filters of the written datasets.
+ *
+ * The datasets of at least min_size bytes are chunked (see
+ * AH5_earray_chunk_dims) and filtered: scale-offset (integers and floats
+ * only), shuffle, then deflate. A filter not available in the HDF5 library
+ * is skipped. The float scale-offset is lossy and is only set when
+ * float_digits >= 0.
+ */
+typedef struct _AH5_filter_policy_t
+{
+  int             deflate;          /**< deflate level (1 to 9), 0 to disable */
+  char            shuffle;          /**< byte shuffle before deflate */
+  char            int_scaleoffset;  /**< lossless scale-offset of the integers */
+  int             float_digits;     /**< decimal digits kept by the float scale-offset, <0 to disable */
+  size_t          min_size;         /**< size in bytes under which the datasets are not filtered */
+} AH5_filter_policy_t;
+
+/**
+ * Initialize a policy without filter.
+ */
+AH5_PUBLIC void AH5_init_filter_policy(AH5_filter_policy_t *policy);
+
+/**
+ * Set the filter policy of the datasets written in a file.
+ *
+ * The policy is used by all the AH5_write_* functions and the extendible
+ * datasets (except the parallel ones). It is forgotten by AH5_close. The
+ * policies are locked, they can be set while the background writer runs.
+ *
+ * @param file_id the file or a negative id for the default policy of the
+ * files without their own policy
+ * @param policy the policy (copied) or NULL to remove it
+ *
+ * @return AH5_TRUE on success (AH5_FALSE if out of memory).
+ */
+AH5_PUBLIC char AH5_set_filter_policy(hid_t file_id, const AH5_filter_policy_t *policy);
+
+/**
+ * Add the chunks and filters of the policy of loc_id to a dataset creation
+ * property list.
+ *
+ * @param plist the dataset creation property list
+ * @param loc_id the location of the dataset (selects the file policy)
+ * @param type_id the dataset type
+ * @param rank the dataset rank
+ * @param dims the dataset dims, used to chunk when chunk_dims is NULL
+ * @param chunk_dims the chunks of a chunked dataset or NULL to chunk the
+ * dataset (it is not filtered if it is smaller than min_size)
+ *
+ * @return AH5_TRUE if filters have been set.
+ */
+AH5_PUBLIC char AH5_set_dataset_filters(hid_t plist, hid_t loc_id, hid_t type_id, int rank,
+                                        const hsize_t dims[], const hsize_t chunk_dims[]);
 
 AH5_PUBLIC char AH5_write_char_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
                                        const char *wdata);
@@ -41,6 +213,12 @@ AH5_PUBLIC char AH5_write_flt_dataset(hid_t loc_id, const char *dset_name, const
                                       const float *wdata);
 AH5_PUBLIC char AH5_write_cpx_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
                                       const AH5_complex_t *wdata);
+AH5_PUBLIC char AH5_write_dbl_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                                      const double *wdata);
+AH5_PUBLIC char AH5_write_i64_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                                      const int64_t *wdata);
+AH5_PUBLIC char AH5_write_dcpx_dataset(hid_t loc_id, const char *dset_name, const hsize_t len,
+                                       const AH5_dcomplex_t *wdata);
 
 /**
  * Write a dataset made of c-strings of same length.
@@ -63,6 +241,12 @@ AH5_PUBLIC char AH5_write_flt_array(hid_t loc_id, const char *dset_name, const i
                                     const hsize_t dims[], const float *wdata);
 AH5_PUBLIC char AH5_write_cpx_array(hid_t loc_id, const char *dset_name, const int rank,
                                     const hsize_t dims[], const AH5_complex_t *wdata);
+AH5_PUBLIC char AH5_write_dbl_array(hid_t loc_id, const char *dset_name, const int rank,
+                                    const hsize_t dims[], const double *wdata);
+AH5_PUBLIC char AH5_write_i64_array(hid_t loc_id, const char *dset_name, const int rank,
+                                    const hsize_t dims[], const int64_t *wdata);
+AH5_PUBLIC char AH5_write_dcpx_array(hid_t loc_id, const char *dset_name, const int rank,
+                                     const hsize_t dims[], const AH5_dcomplex_t *wdata);
 AH5_PUBLIC char AH5_write_str_array(hid_t loc_id, const char *dset_name, const int rank,
                                     const hsize_t dims[], const char *wdata);
 
@@ -8,14 +8,82 @@ hid_t AH5_Get_cpx_type()
 
 
 
-char AH5_create_earray(hid_t loc_id, const char *dset_name,
-                       const int rank, const hsize_t initialdims[], const hsize_t extendibledims[],
-                       hid_t mem_type_id, hid_t *dataset)
+/* Target size of the chunks of the extendible arrays.*/
+static size_t AH5_earray_chunk_bytes = AH5_EARRAY_CHUNK_BYTES;
+
+
+void AH5_set_earray_chunk_bytes(size_t nbytes)
+{
+  AH5_earray_chunk_bytes = nbytes > 0 ? nbytes : AH5_EARRAY_CHUNK_BYTES;
+}
+
+
+void AH5_earray_chunk_dims(const int rank, const hsize_t initialdims[],
+                           const hsize_t extendibledims[], size_t type_size,
+                           hsize_t chunkdims[])
+{
+  size_t fixed_bytes;
+  hsize_t rows;
+  int i, largest;
+
+  if(type_size == 0)
+    type_size = 1;
+
+  for(i=0; i<rank; i++)
+    chunkdims[i] = initialdims[i] > 0 ? initialdims[i] : 1;
+
+  /* Split the fixed dims, the largest first, until a row fits.*/
+  for(;;)
+  {
+    fixed_bytes = type_size;
+    largest = -1;
+    for(i=0; i<rank; i++)
+    {
+      if(extendibledims[i] == H5S_UNLIMITED)
+        continue;
+      fixed_bytes *= chunkdims[i];
+      if(chunkdims[i] > 1 && (largest < 0 || chunkdims[i] > chunkdims[largest]))
+        largest = i;
+    }
+    if(fixed_bytes <= AH5_earray_chunk_bytes || largest < 0)
+      break;
+    chunkdims[largest] = (chunkdims[largest] + 1) / 2;
+  }
+
+  /* Grow the first extendible dim up to the target, the others keep
+     their initial size.*/
+  for(i=0; i<rank; i++)
+  {
+    if(extendibledims[i] == H5S_UNLIMITED)
+    {
+      rows = AH5_earray_chunk_bytes / fixed_bytes;
+      chunkdims[i] = rows > 0 ? rows : 1;
+      break;
+    }
+  }
+}
+
+
+// Create an extendible array, chunked with the chunk policy if chunkdims is
+// NULL and filtered with the filter policy if filtered.
+static char AH5_create_earray_ex(hid_t loc_id, const char *dset_name,
+                                 const int rank, const hsize_t initialdims[],
+                                 const hsize_t extendibledims[], const hsize_t chunkdims[],
+                                 hid_t mem_type_id, char filtered, hid_t *dataset)
 {
   hid_t dataspace;
   hid_t prop;
+  hsize_t *policydims = NULL;
   herr_t status;
 
+  if(chunkdims == NULL)
+  {
+    policydims = (hsize_t *)malloc(rank * sizeof(hsize_t));
+    AH5_earray_chunk_dims(rank, initialdims, extendibledims,
+                          H5Tget_size(mem_type_id), policydims);
+    chunkdims = policydims;
+  }
+
 
   /* Create the data space with extendible dimensions */
   dataspace = H5Screate_simple (rank, initialdims, extendibledims);
@@ -25,14 +93,19 @@ char AH5_create_earray(hid_t loc_id, const char *dset_name,
   prop = H5Pcreate(H5P_DATASET_CREATE);
 
   /* ... and set it in order to enable chunking. */
-  status = H5Pset_chunk(prop, rank, initialdims);
+  status = H5Pset_chunk(prop, rank, chunkdims);
+  free(policydims);
 
   if(HDF5_FAILED(status))
   {
+    status = H5Pclose(prop);
     status = H5Sclose(dataspace);
     return AH5_FALSE;
   }
 
+  if(filtered)
+    AH5_set_dataset_filters(prop, loc_id, mem_type_id, rank, extendibledims, chunkdims);
+
   /* Create the dataset in the file */
 
   (*dataset) = H5Dcreate(loc_id, dset_name, mem_type_id, dataspace,
@@ -41,20 +114,43 @@ char AH5_create_earray(hid_t loc_id, const char *dset_name,
   status = H5Pclose(prop);
   status = H5Sclose(dataspace);
 
+  HDF5_RETURN_IF_FAILED(*dataset, AH5_FALSE);
 
   return AH5_TRUE;
 }
 
 
+char AH5_create_earray_with_chunk(hid_t loc_id, const char *dset_name,
+                                  const int rank, const hsize_t initialdims[],
+                                  const hsize_t extendibledims[], const hsize_t chunkdims[],
+                                  hid_t mem_type_id, hid_t *dataset)
+{
+  return AH5_create_earray_ex(loc_id, dset_name, rank, initialdims, extendibledims,
+                              chunkdims, mem_type_id, AH5_TRUE, dataset);
+}
+
+
+char AH5_create_earray(hid_t loc_id, const char *dset_name,
+                       const int rank, const hsize_t initialdims[], const hsize_t extendibledims[],
+                       hid_t mem_type_id, hid_t *dataset)
+{
+  return AH5_create_earray_ex(loc_id, dset_name, rank, initialdims, extendibledims,
+                              NULL, mem_type_id, AH5_TRUE, dataset);
+}
+
+
 char AH5_extend_earray(hid_t dataset,
                        const int rank, hsize_t dims[], hsize_t extensiondims[])
 {
   herr_t status;
   int idim;
 
+  /* Only the extended dims are written, the background writer reads the
+     others while it appends (see ah5_ewriter.h). */
   for(idim=0; idim<rank; idim++)
   {
-    dims[idim] += extensiondims[idim];
+    if(extensiondims[idim] != 0)
+      dims[idim] += extensiondims[idim];
   }
 
   status = H5Dset_extent(dataset, dims);
@@ -103,6 +199,52 @@ char AH5_write_array_with_properties(hid_t dataset,
 
 
 
+char AH5_read_array_with_properties(hid_t dataset,
+                                    const int rank, const hsize_t blockdims[],
+                                    const hsize_t* start, const hsize_t* stride,
+                                    const hsize_t* count, const hsize_t* block,
+                                    void *data, hid_t mem_type_id, hid_t properties) {
+  hid_t dataspace = 0;
+  hid_t memspace = 0;
+  herr_t status = 0;
+  char empty = AH5_FALSE;
+  int i;
+
+  for(i=0; i<rank; i++)
+  {
+    if(count[i] == 0 || blockdims[i] == 0 || (block != NULL && block[i] == 0))
+      empty = AH5_TRUE;
+  }
+
+  dataspace = H5Dget_space(dataset);
+  HDF5_RETURN_IF_FAILED(dataspace, AH5_FALSE);
+  memspace = H5Screate_simple(rank, blockdims, NULL);
+
+  /* Select the part to read */
+  if(empty)
+  {
+    status = H5Sselect_none(dataspace);
+    if(!HDF5_FAILED(status))
+      status = H5Sselect_none(memspace);
+  }
+  else
+  {
+    status = H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, start, stride, count, block);
+  }
+
+  if(!HDF5_FAILED(status))
+    status = H5Dread(dataset, mem_type_id, memspace, dataspace, properties, data);
+
+  H5Sclose(memspace);
+  H5Sclose(dataspace);
+
+  HDF5_RETURN_IF_FAILED(status, AH5_FALSE);
+
+  return AH5_TRUE;
+}
+
+
+
 char AH5_write_earray(hid_t dataset,
                       const int rank, const hsize_t totaldims[], const hsize_t blockdims[],
                       const hsize_t start[], const hsize_t stride[],
@@ -126,9 +268,14 @@ void AH5_initialize_Edataset(AH5_Edataset_t *Edataset)
   Edataset->created       = AH5_FALSE;
   Edataset->access        = AH5_undef;
   Edataset->type_class    = H5T_NO_CLASS;
+  Edataset->type_size     = 0;
   Edataset->nature        = NULL;
   Edataset->label         = NULL;
   Edataset->unit          = NULL;
+  Edataset->chunk_dims    = NULL;
+  Edataset->buffer        = NULL;
+  Edataset->buffer_rows   = 0;
+  Edataset->buffer_used   = 0;
   AH5_initialize_memory_mapping(&(Edataset->mapping));
 }
 
@@ -147,6 +294,7 @@ char AH5_create_PEorEdataset(hid_t loc_id,
   Edataset->nb_dims       = nb_dims;
   Edataset->dims          = (hsize_t *)malloc(nb_dims * sizeof(hsize_t));
   Edataset->type_class    = mem_type_id;
+  Edataset->type_size     = H5Tget_size(mem_type_id);
 
   Edataset->access        = access;
 
@@ -304,9 +452,10 @@ char AH5_write_attr_Edataset(AH5_Edataset_t *Edataset)
 }
 
 
-char AH5_append_Edataset(AH5_Edataset_t *Edataset,
-                         hsize_t sizeappend,
-                         void *data)
+/* Extend the dataset and write sizeappend rows. */
+static char AH5_write_append_Edataset(AH5_Edataset_t *Edataset,
+                                      hsize_t sizeappend,
+                                      void *data)
 {
 
   hsize_t *extendibledims;
@@ -330,10 +479,21 @@ char AH5_append_Edataset(AH5_Edataset_t *Edataset,
 
     extendibledims[Edataset->extendibledim] = H5S_UNLIMITED;
 
-    AH5_RETURN_IF_FAILED(AH5_create_earray(Edataset->parent, Edataset->path,
-                                           Edataset->nb_dims, Edataset->dims, extendibledims,
-                                           Edataset->type_class, &(Edataset->dataset)),
-                         AH5_FALSE);
+    if(Edataset->chunk_dims != NULL)
+    {
+      AH5_RETURN_IF_FAILED(AH5_create_earray_with_chunk(
+                             Edataset->parent, Edataset->path,
+                             Edataset->nb_dims, Edataset->dims, extendibledims,
+                             Edataset->chunk_dims, Edataset->type_class, &(Edataset->dataset)),
+                           AH5_FALSE);
+    }
+    else
+    {
+      AH5_RETURN_IF_FAILED(AH5_create_earray(Edataset->parent, Edataset->path,
+                                             Edataset->nb_dims, Edataset->dims, extendibledims,
+                                             Edataset->type_class, &(Edataset->dataset)),
+                           AH5_FALSE);
+    }
 
     Edataset->created = AH5_TRUE;
   }
@@ -405,8 +565,172 @@ char AH5_append_Edataset(AH5_Edataset_t *Edataset,
 
 
 
+/* Number of slabs before the extendible dim and size in bytes of one row
+   of a slab (all the dims after the extendible one).*/
+static void AH5_Edataset_slab_sizes(const AH5_Edataset_t *Edataset,
+                                    size_t *outer, size_t *inner)
+{
+  int i;
+
+  *outer = 1;
+  *inner = Edataset->type_size;
+  for(i=0; i<Edataset->nb_dims; i++)
+  {
+    if((hsize_t)i < Edataset->extendibledim)
+      *outer *= Edataset->dims[i];
+    else if((hsize_t)i > Edataset->extendibledim)
+      *inner *= Edataset->dims[i];
+  }
+}
+
+
+char AH5_set_chunk_Edataset(AH5_Edataset_t *Edataset,
+                            const hsize_t chunk_dims[])
+{
+  int i;
+
+  if(Edataset->created == AH5_TRUE)
+    return AH5_FALSE;
+
+  free(Edataset->chunk_dims);
+  Edataset->chunk_dims = NULL;
+
+  if(chunk_dims == NULL)
+    return AH5_TRUE;
+
+  Edataset->chunk_dims = (hsize_t *)malloc(Edataset->nb_dims * sizeof(hsize_t));
+  for(i=0; i<Edataset->nb_dims; i++)
+  {
+    if(chunk_dims[i] == 0)
+    {
+      free(Edataset->chunk_dims);
+      Edataset->chunk_dims = NULL;
+      return AH5_FALSE;
+    }
+    Edataset->chunk_dims[i] = chunk_dims[i];
+  }
+
+  return AH5_TRUE;
+}
+
+
+size_t AH5_append_size_Edataset(const AH5_Edataset_t *Edataset,
+                                hsize_t sizeappend)
+{
+  size_t outer, inner;
+
+  AH5_Edataset_slab_sizes(Edataset, &outer, &inner);
+  return outer * inner * sizeappend;
+}
+
+
+char AH5_set_buffer_Edataset(AH5_Edataset_t *Edataset,
+                             hsize_t nb_rows)
+{
+  size_t outer, inner;
+
+  AH5_RETURN_IF_FAILED(AH5_flush_Edataset(Edataset), AH5_FALSE);
+
+  free(Edataset->buffer);
+  Edataset->buffer      = NULL;
+  Edataset->buffer_rows = 0;
+
+  if(nb_rows == 0)
+    return AH5_TRUE;
+
+  if(Edataset->access != AH5_serie)
+    return AH5_FALSE;
+
+  AH5_Edataset_slab_sizes(Edataset, &outer, &inner);
+  if(inner == 0)
+    return AH5_FALSE;
+
+  Edataset->buffer = (char *)malloc(outer * inner * nb_rows);
+  if(Edataset->buffer == NULL)
+    return AH5_FALSE;
+  Edataset->buffer_rows = nb_rows;
+
+  return AH5_TRUE;
+}
+
+
+char AH5_flush_Edataset(AH5_Edataset_t *Edataset)
+{
+  size_t outer, inner, o;
+  hsize_t used = Edataset->buffer_used;
+
+  if(used == 0)
+    return AH5_TRUE;
+
+  /* The slabs are staged buffer_rows apart, pack them.*/
+  AH5_Edataset_slab_sizes(Edataset, &outer, &inner);
+  if(used < Edataset->buffer_rows)
+  {
+    for(o=1; o<outer; o++)
+    {
+      memmove(Edataset->buffer + o * used * inner,
+              Edataset->buffer + o * Edataset->buffer_rows * inner,
+              used * inner);
+    }
+  }
+
+  Edataset->buffer_used = 0;
+  return AH5_write_append_Edataset(Edataset, used, Edataset->buffer);
+}
+
+
+char AH5_append_Edataset(AH5_Edataset_t *Edataset,
+                         hsize_t sizeappend,
+                         void *data)
+{
+  size_t outer, inner, o;
+
+  if(Edataset->buffer_rows == 0)
+    return AH5_write_append_Edataset(Edataset, sizeappend, data);
+
+  if(Edataset->buffer_used + sizeappend > Edataset->buffer_rows)
+  {
+    AH5_RETURN_IF_FAILED(AH5_flush_Edataset(Edataset), AH5_FALSE);
+  }
+
+  /* Too large to be staged, write it directly.*/
+  if(sizeappend >= Edataset->buffer_rows)
+    return AH5_write_append_Edataset(Edataset, sizeappend, data);
+
+  AH5_Edataset_slab_sizes(Edataset, &outer, &inner);
+  for(o=0; o<outer; o++)
+  {
+    memcpy(Edataset->buffer + (o * Edataset->buffer_rows + Edataset->buffer_used) * inner,
+           (char *)data + o * sizeappend * inner,
+           sizeappend * inner);
+  }
+  Edataset->buffer_used += sizeappend;
+
+  if(Edataset->buffer_used == Edataset->buffer_rows)
+    return AH5_flush_Edataset(Edataset);
+
+  return AH5_TRUE;
+}
+
+
+
 char AH5_free_Edataset(AH5_Edataset_t *Edataset)
 {
+  char status = AH5_flush_Edataset(Edataset);
+
+  if(Edataset->buffer != NULL)
+  {
+    free(Edataset->buffer);
+    Edataset->buffer = NULL;
+  }
+  Edataset->buffer_rows = 0;
+
+  if(Edataset->chunk_dims != NULL)
+  {
+    free(Edataset->chunk_dims);
+    Edataset->chunk_dims = NULL;
+  }
+
   if(Edataset->dims != NULL)
   {
     free(Edataset->dims);
@@ -440,7 +764,10 @@ char AH5_free_Edataset(AH5_Edataset_t *Edataset)
   Edataset->created = AH5_FALSE;
   Edataset->access  = AH5_undef;
 
-  return AH5_free_memory_mapping(&(Edataset->mapping));
+  if(AH5_free_memory_mapping(&(Edataset->mapping)) != AH5_TRUE)
+    return AH5_FALSE;
+
+  return status;
 }
 
 
@@ -703,6 +1030,39 @@ char AH5_append_Earrayset(AH5_Earrayset_t *Earrayset,
 }
 
 
+char AH5_set_chunk_Earrayset(AH5_Earrayset_t *Earrayset,
+                              const hsize_t chunk_dims[])
+{
+  return AH5_set_chunk_Edataset(&(Earrayset->data), chunk_dims);
+}
+
+
+char AH5_set_buffer_Earrayset(AH5_Earrayset_t *Earrayset,
+                              hsize_t nb_rows)
+{
+  AH5_Edataset_t *dim = Earrayset->dims + Earrayset->data.extendibledim;
+
+  AH5_RETURN_IF_FAILED(AH5_set_buffer_Edataset(&(Earrayset->data), nb_rows),
+                       AH5_FALSE);
+
+  /* The extendible dim can be a void dataset.*/
+  if(dim->access == AH5_serie)
+  {
+    AH5_RETURN_IF_FAILED(AH5_set_buffer_Edataset(dim, nb_rows), AH5_FALSE);
+  }
+
+  return AH5_TRUE;
+}
+
+
+char AH5_flush_Earrayset(AH5_Earrayset_t *Earrayset)
+{
+  AH5_RETURN_IF_FAILED(AH5_flush_Edataset(&(Earrayset->data)), AH5_FALSE);
+
+  return AH5_flush_Edataset(Earrayset->dims + Earrayset->data.extendibledim);
+}
+
+
 char AH5_free_Earrayset(AH5_Earrayset_t *Earrayset)
 {
   int idim;
@@ -813,6 +1173,95 @@ char AH5_free_memory_mapping(AH5_MEMORY_MAPPING_t *mapping)
 
 
 
+char AH5_set_block_memory_mapping(
+  AH5_MEMORY_MAPPING_t *mapping,
+  hid_t loc_id,
+  const char *dset_name,
+  int nb_parts,
+  int part)
+{
+  hid_t dataset, dataspace;
+  hsize_t *dims, *start, *stride, *block;
+  hsize_t nb_rows, first;
+  int rank, i;
+  char success;
+
+  if(nb_parts <= 0 || part < 0 || part >= nb_parts)
+    return AH5_FALSE;
+
+  dataset = H5Dopen(loc_id, dset_name, H5P_DEFAULT);
+  HDF5_RETURN_IF_FAILED(dataset, AH5_FALSE);
+  dataspace = H5Dget_space(dataset);
+  rank = H5Sget_simple_extent_ndims(dataspace);
+  if(rank <= 0)
+  {
+    H5Sclose(dataspace);
+    H5Dclose(dataset);
+    return AH5_FALSE;
+  }
+
+  dims   = (hsize_t *)malloc(4 * rank * sizeof(hsize_t));
+  start  = dims + rank;
+  stride = start + rank;
+  block  = stride + rank;
+  H5Sget_simple_extent_dims(dataspace, dims, NULL);
+  H5Sclose(dataspace);
+  H5Dclose(dataset);
+
+  /* The first (dims[0] % nb_parts) parts get one more row.*/
+  nb_rows = dims[0] / nb_parts;
+  first = part * nb_rows;
+  if((hsize_t)part < dims[0] % nb_parts)
+  {
+    nb_rows++;
+    first += part;
+  }
+  else
+  {
+    first += dims[0] % nb_parts;
+  }
+
+  for(i=0; i<rank; i++)
+  {
+    start[i]  = 0;
+    stride[i] = 1;
+    block[i]  = 1;
+  }
+  start[0] = first;
+  dims[0]  = nb_rows;
+
+  AH5_free_memory_mapping(mapping);
+  success = AH5_set_memory_mapping(mapping, rank, dims, start, stride, dims, block);
+  free(dims);
+
+  return success;
+}
+
+
+char AH5_read_mapped_array(
+  hid_t loc_id,
+  const char *dset_name,
+  const AH5_MEMORY_MAPPING_t *mapping,
+  void *rdata,
+  hid_t mem_type_id)
+{
+  hid_t dataset;
+  char success;
+
+  dataset = H5Dopen(loc_id, dset_name, H5P_DEFAULT);
+  HDF5_RETURN_IF_FAILED(dataset, AH5_FALSE);
+
+  success = AH5_read_array_with_properties(dataset, (int)mapping->nb_dims, mapping->blockdims,
+            mapping->start, mapping->stride,
+            mapping->count, mapping->block,
+            rdata, mem_type_id, H5P_DEFAULT);
+  H5Dclose(dataset);
+
+  return success;
+}
+
+
+
 #ifdef AH5_WITH_MPI_
 char AH5_write_parray(hid_t loc_id, const char *dset_name,
                       const int rank, const hsize_t totaldims[], const hsize_t blockdims[],
@@ -960,6 +1409,76 @@ char AH5_write_str_parray(hid_t loc_id,
 }
 
 
+char AH5_read_parray(hid_t loc_id, const char *dset_name,
+                     const int rank, const hsize_t blockdims[],
+                     const hsize_t start[], const hsize_t stride[], const hsize_t count[],
+                     const hsize_t block[],
+                     void *rdata, hid_t mem_type_id)
+{
+  hid_t dataset_id;
+  hid_t plist_id;
+  char success;
+
+  dataset_id = H5Dopen(loc_id, dset_name, H5P_DEFAULT);
+  HDF5_RETURN_IF_FAILED(dataset_id, AH5_FALSE);
+
+  /* Properties for collective read */
+  plist_id = H5Pcreate(H5P_DATASET_XFER);
+  H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+
+  success = AH5_read_array_with_properties(dataset_id,
+            rank, blockdims, start, stride, count, block,
+            rdata, mem_type_id, plist_id);
+
+  H5Pclose(plist_id);
+  H5Dclose(dataset_id);
+
+  return success;
+}
+
+char AH5_read_int_parray(hid_t loc_id,
+                         const char *dset_name,
+                         const int rank,
+                         const hsize_t blockdims[],
+                         const hsize_t start[],
+                         const hsize_t stride[],
+                         const hsize_t count[],
+                         const hsize_t block[],
+                         int *rdata)
+{
+  return AH5_read_parray(loc_id, dset_name,
+                         rank, blockdims, start, stride, count, block,
+                         (void *)rdata, H5T_NATIVE_INT);
+}
+
+char AH5_read_flt_parray(hid_t loc_id,
+                         const char *dset_name,
+                         const int rank,
+                         const hsize_t blockdims[],
+                         const hsize_t start[],
+                         const hsize_t stride[],
+                         const hsize_t count[],
+                         const hsize_t block[],
+                         float *rdata)
+{
+  return AH5_read_parray(loc_id, dset_name,
+                         rank, blockdims, start, stride, count, block,
+                         (void *)rdata, H5T_NATIVE_FLOAT);
+}
+
+char AH5_read_mapped_parray(hid_t loc_id,
+                            const char *dset_name,
+                            const AH5_MEMORY_MAPPING_t *mapping,
+                            void *rdata,
+                            hid_t mem_type_id)
+{
+  return AH5_read_parray(loc_id, dset_name,
+                         (int)mapping->nb_dims, mapping->blockdims,
+                         mapping->start, mapping->stride, mapping->count, mapping->block,
+                         rdata, mem_type_id);
+}
+
+
 char AH5_create_PEdataset(hid_t loc_id,
                           const char *name,
                           hsize_t nb_dims,
@@ -1079,9 +1598,11 @@ char AH5_append_PEdataset(AH5_Edataset_t *Edataset,
     }
     extensiondims[Edataset->extendibledim] = H5S_UNLIMITED;
 
-    status = AH5_create_earray(Edataset->parent, Edataset->path,
-                               Edataset->nb_dims, Edataset->dims, extensiondims, Edataset->type_class,
-                               &(Edataset->dataset));
+    /* Not filtered: the filtered parallel writes need collective I/O.*/
+    status = AH5_create_earray_ex(Edataset->parent, Edataset->path,
+                                  Edataset->nb_dims, Edataset->dims, extensiondims,
+                                  Edataset->chunk_dims, Edataset->type_class,
+                                  AH5_FALSE, &(Edataset->dataset));
 
     AH5_RETURN_IF_FAILED(status, status);
 
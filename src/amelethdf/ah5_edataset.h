@@ -10,6 +10,9 @@
 #include "ah5_config.h"
 #include "ah5.h"
 
+/* Default target size in bytes of the chunks of the extendible arrays.*/
+#define AH5_EARRAY_CHUNK_BYTES (256 * 1024)
+
 #ifdef AH5_WITH_MPI_
 #include <mpi.h>
 #error "mpi pas bien!"
@@ -46,12 +49,17 @@ typedef struct _AH5_Edataset_t
   hsize_t              extendibledim;
   hsize_t             *dims;
   hid_t                type_class;
+  size_t               type_size;
   char                 created;
   AH5_ACCESS_TYPE      access;
   AH5_MEMORY_MAPPING_t mapping;
   char                *nature;
   char                *label;
   char                *unit;
+  hsize_t             *chunk_dims;      /* NULL for the default chunk policy*/
+  char                *buffer;          /* staged appends (buffered mode)*/
+  hsize_t              buffer_rows;     /* capacity in the extendible dim*/
+  hsize_t              buffer_used;     /* staged size in the extendible dim*/
 }
 AH5_Edataset_t;
 
@@ -76,14 +84,25 @@ AH5_PUBLIC hid_t AH5_Get_cpx_type();
 /* Write extendible array
    TODO : str, complex */
 
-AH5_PUBLIC char AH5_create_earray(hid_t loc_id, const char *dset_name,
-                                  const int rank, const hsize_t initialdims[], const hsize_t extendibledims[],
-                                  hid_t mem_type_id, hid_t *dataset);
+/* Chunk policy: the fixed dims are split until a row is smaller than the*/
+/* target chunk size, then the extendible dim is grown up to it.*/
+AH5_PUBLIC void AH5_set_earray_chunk_bytes(
+  size_t nbytes);               /* target chunk size (0 for the default)*/
+
+AH5_PUBLIC void AH5_earray_chunk_dims(const int rank, const hsize_t initialdims[],
+                                      const hsize_t extendibledims[], size_t type_size,
+                                      hsize_t chunkdims[]);
 
+/* Create an extendible array chunked with the chunk policy.*/
 AH5_PUBLIC char AH5_create_earray(hid_t loc_id, const char *dset_name,
                                   const int rank, const hsize_t initialdims[], const hsize_t extendibledims[],
                                   hid_t mem_type_id, hid_t *dataset);
 
+AH5_PUBLIC char AH5_create_earray_with_chunk(hid_t loc_id, const char *dset_name,
+                                             const int rank, const hsize_t initialdims[],
+                                             const hsize_t extendibledims[], const hsize_t chunkdims[],
+                                             hid_t mem_type_id, hid_t *dataset);
+
 AH5_PUBLIC char AH5_extend_earray(hid_t dataset,
                                   const int rank, hsize_t dims[], hsize_t extensiondims[]);
 
@@ -95,6 +114,16 @@ AH5_PUBLIC char AH5_write_array_with_properties(
     const hsize_t* count, const hsize_t* block,
     const void *data, hid_t mem_type_id, hid_t properties);
 
+/* Read the selection start/stride/count/block of an opened dataset into a
+   blockdims shaped buffer. An empty selection reads nothing but still calls
+   H5Dread, so that a collective transfer stays matched on all processes.*/
+AH5_PUBLIC char AH5_read_array_with_properties(
+    hid_t dataset,
+    const int rank, const hsize_t blockdims[],
+    const hsize_t* start, const hsize_t* stride,
+    const hsize_t* count, const hsize_t* block,
+    void *data, hid_t mem_type_id, hid_t properties);
+
 AH5_PUBLIC char AH5_write_earray(hid_t dataset,
                                  const int rank, const hsize_t dims[], const hsize_t blockdims[],
                                  const hsize_t start[], const hsize_t stride[],
@@ -183,6 +212,29 @@ AH5_PUBLIC char AH5_append_Edataset(
   hsize_t sizeappend,           /* number of dim to append*/
   void *data);                  /* data to append*/
 
+/* Override the chunk policy, before the first append (NULL for the policy).*/
+AH5_PUBLIC char AH5_set_chunk_Edataset(
+  AH5_Edataset_t *Edataset,     /* pointer to AH5_Edataset_t*/
+  const hsize_t chunk_dims[]);  /* size of the chunks*/
+
+/* Size in bytes of the data of an append of sizeappend.*/
+AH5_PUBLIC size_t AH5_append_size_Edataset(
+  const AH5_Edataset_t *Edataset, /* pointer to AH5_Edataset_t*/
+  hsize_t sizeappend);          /* number of dim to append*/
+
+/* Buffered mode: the appends are staged in memory and written to the */
+/* file with one extent and one write when nb_rows are staged, when */
+/* AH5_flush_Edataset is called and when the Edataset is freed. */
+/* dims only counts the rows written in the file. */
+/* The Edataset must have been created, nb_rows=0 disables the buffer.*/
+AH5_PUBLIC char AH5_set_buffer_Edataset(
+  AH5_Edataset_t *Edataset,     /* pointer to AH5_Edataset_t*/
+  hsize_t nb_rows);             /* size of the buffer in the extendible dim*/
+
+/* Write the staged appends to the file.*/
+AH5_PUBLIC char AH5_flush_Edataset(AH5_Edataset_t *Edataset);
+
+/* Flush the staged appends and free the Edataset.*/
 AH5_PUBLIC char AH5_free_Edataset(AH5_Edataset_t *Edataset);
 
 
@@ -295,6 +347,19 @@ AH5_PUBLIC char AH5_append_Earrayset(
   void *data,                   /* data to append*/
   void *dimdata);               /* data to append to extendible dim (can be NULL)*/
 
+/* Override the chunk policy of the data (see AH5_set_chunk_Edataset).*/
+AH5_PUBLIC char AH5_set_chunk_Earrayset(
+  AH5_Earrayset_t *Earrayset,   /* pointer to AH5_Earrayset_t*/
+  const hsize_t chunk_dims[]);  /* size of the chunks*/
+
+/* Buffered mode for the data and the extendible dim (see AH5_set_buffer_Edataset).*/
+/* The dims must have been set before.*/
+AH5_PUBLIC char AH5_set_buffer_Earrayset(
+  AH5_Earrayset_t *Earrayset,   /* pointer to AH5_Earrayset_t*/
+  hsize_t nb_rows);             /* size of the buffer in the extendible dim*/
+
+AH5_PUBLIC char AH5_flush_Earrayset(AH5_Earrayset_t *Earrayset);
+
 AH5_PUBLIC char AH5_free_Earrayset(AH5_Earrayset_t *Earrayset);
 
 
@@ -313,6 +378,25 @@ AH5_PUBLIC char AH5_set_memory_mapping(
 
 AH5_PUBLIC char AH5_free_memory_mapping(AH5_MEMORY_MAPPING_t *mapping);
 
+/* Set the mapping of the contiguous block of rows (first dim) of the part
+   'part' among 'nb_parts' of the dataset 'dset_name', the other dims are
+   complete. The rows are balanced, a part can be empty.*/
+AH5_PUBLIC char AH5_set_block_memory_mapping(
+  AH5_MEMORY_MAPPING_t *mapping,
+  hid_t loc_id,
+  const char *dset_name,
+  int nb_parts,
+  int part);
+
+/* Read the part of a dataset described by a memory mapping
+   (nodes, elementNodes, arrayset data...).*/
+AH5_PUBLIC char AH5_read_mapped_array(
+  hid_t loc_id,
+  const char *dset_name,
+  const AH5_MEMORY_MAPPING_t *mapping,
+  void *rdata,
+  hid_t mem_type_id);
+
 
 
 //  Toot for write extending dataset with mpi.
@@ -350,6 +434,40 @@ AH5_PUBLIC char AH5_write_str_parray(hid_t loc_id, const char *dset_name,
                                      const hsize_t block[],
                                      const char *wdata);
 
+/* Parallel read (Base functions), collective: all processes must call them,
+   a process with nothing to read gives an empty count.*/
+AH5_PUBLIC char AH5_read_parray(hid_t loc_id,
+                                const char *dset_name,
+                                const int rank,
+                                const hsize_t blockdims[],
+                                const hsize_t start[],
+                                const hsize_t stride[],
+                                const hsize_t count[],
+                                const hsize_t block[],
+                                void *rdata,
+                                hid_t mem_type_id);
+
+AH5_PUBLIC char AH5_read_int_parray(hid_t loc_id, const char *dset_name,
+                                    const int rank, const hsize_t blockdims[],
+                                    const hsize_t start[], const hsize_t stride[], const hsize_t count[],
+                                    const hsize_t block[],
+                                    int *rdata);
+
+AH5_PUBLIC char AH5_read_flt_parray(hid_t loc_id, const char *dset_name,
+                                    const int rank, const hsize_t blockdims[],
+                                    const hsize_t start[], const hsize_t stride[], const hsize_t count[],
+                                    const hsize_t block[],
+                                    float *rdata);
+
+/* Collective read of the part of a dataset described by a memory mapping
+   (see AH5_set_block_memory_mapping for a contiguous slice per process).*/
+AH5_PUBLIC char AH5_read_mapped_parray(
+  hid_t loc_id,
+  const char *dset_name,
+  const AH5_MEMORY_MAPPING_t *mapping,
+  void *rdata,
+  hid_t mem_type_id);
+
 
 /* Parallel extendible dataset*/
 
@@ -0,0 +1,198 @@
+#include "ah5_estage.h"
+
+#if AH5_WITH_PTHREADS_
+#include <pthread.h>
+#endif
+
+
+/* A range [start, end) of deposited elements.*/
+typedef struct _AH5_estage_range_t
+{
+  hsize_t            start;
+  hsize_t            end;
+} AH5_estage_range_t;
+
+struct _AH5_estage_t
+{
+  AH5_Earrayset_t   *Earrayset;
+  hsize_t            sizeappend;
+  size_t             type_size;
+  hsize_t            nb_elements; /* size of a block*/
+  hsize_t            deposited;   /* deposited elements in the block*/
+  char               rejected;    /* a deposit was out of the block or overlapping*/
+  AH5_estage_range_t *ranges;     /* sorted disjoint deposited ranges (adjacent ones merged)*/
+  size_t             nb_ranges;
+  size_t             ranges_capacity;
+  char              *block;
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_t    lock;
+#endif
+};
+
+
+char AH5_open_estage(AH5_Earrayset_t *Earrayset,
+                     hsize_t sizeappend,
+                     AH5_estage_t **stage)
+{
+  AH5_estage_t *s;
+  size_t size;
+
+  *stage = NULL;
+  if(Earrayset->data.type_size == 0 || sizeappend == 0)
+    return AH5_FALSE;
+
+  s = (AH5_estage_t *)malloc(sizeof(AH5_estage_t));
+  if(s == NULL)
+    return AH5_FALSE;
+
+  size = AH5_append_size_Edataset(&(Earrayset->data), sizeappend);
+  s->Earrayset   = Earrayset;
+  s->sizeappend  = sizeappend;
+  s->type_size   = Earrayset->data.type_size;
+  s->nb_elements = size / s->type_size;
+  s->deposited   = 0;
+  s->rejected    = AH5_FALSE;
+  s->ranges      = NULL;
+  s->nb_ranges   = 0;
+  s->ranges_capacity = 0;
+  s->block       = (char *)malloc(size > 0 ? size : 1);
+  if(s->block == NULL)
+  {
+    free(s);
+    return AH5_FALSE;
+  }
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_init(&s->lock, NULL);
+#endif
+
+  *stage = s;
+  return AH5_TRUE;
+}
+
+
+/* Add [offset, offset + nb_elements) to the deposited ranges if it does*/
+/* not overlap them: a binary search, the ranges touching it are merged.*/
+static char AH5_estage_cover(AH5_estage_t *stage, hsize_t offset, hsize_t nb_elements)
+{
+  AH5_estage_range_t *ranges = stage->ranges;
+  hsize_t end = offset + nb_elements;
+  size_t low = 0, high = stage->nb_ranges, mid, capacity;
+  char merge_previous, merge_next;
+
+  if(nb_elements == 0)
+    return AH5_TRUE;
+
+  /* first range ending after offset*/
+  while(low < high)
+  {
+    mid = low + (high - low) / 2;
+    if(ranges[mid].end <= offset)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  if(low < stage->nb_ranges && ranges[low].start < end)
+    return AH5_FALSE;
+
+  merge_previous = low > 0 && ranges[low - 1].end == offset;
+  merge_next = low < stage->nb_ranges && ranges[low].start == end;
+  if(merge_previous && merge_next)
+  {
+    ranges[low - 1].end = ranges[low].end;
+    memmove(ranges + low, ranges + low + 1,
+            (stage->nb_ranges - low - 1) * sizeof(AH5_estage_range_t));
+    stage->nb_ranges--;
+  }
+  else if(merge_previous)
+    ranges[low - 1].end = end;
+  else if(merge_next)
+    ranges[low].start = offset;
+  else
+  {
+    if(stage->nb_ranges == stage->ranges_capacity)
+    {
+      capacity = stage->ranges_capacity ? 2 * stage->ranges_capacity : 16;
+      ranges = (AH5_estage_range_t *)realloc(stage->ranges,
+                                             capacity * sizeof(AH5_estage_range_t));
+      if(ranges == NULL)
+        return AH5_FALSE;
+      stage->ranges = ranges;
+      stage->ranges_capacity = capacity;
+    }
+    memmove(ranges + low + 1, ranges + low,
+            (stage->nb_ranges - low) * sizeof(AH5_estage_range_t));
+    ranges[low].start = offset;
+    ranges[low].end = end;
+    stage->nb_ranges++;
+  }
+  return AH5_TRUE;
+}
+
+
+char AH5_estage_deposit(AH5_estage_t *stage,
+                        hsize_t offset,
+                        hsize_t nb_elements,
+                        const void *data)
+{
+  char accepted = (offset <= stage->nb_elements
+                   && nb_elements <= stage->nb_elements - offset);
+
+  /* Reserve the slab, then copy it out of the lock.*/
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&stage->lock);
+#endif
+  if(accepted)
+    accepted = AH5_estage_cover(stage, offset, nb_elements);
+  if(accepted)
+    stage->deposited += nb_elements;
+  else
+    stage->rejected = AH5_TRUE;
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&stage->lock);
+#endif
+
+  if(accepted)
+    memcpy(stage->block + offset * stage->type_size, data,
+           (size_t)nb_elements * stage->type_size);
+
+  return accepted;
+}
+
+
+char AH5_estage_commit(AH5_estage_t *stage,
+                       AH5_ewriter_t *writer,
+                       const void *dimdata)
+{
+  char success;
+
+  if(stage->rejected || stage->deposited != stage->nb_elements)
+    success = AH5_FALSE;
+  else if(writer != NULL)
+    success = AH5_ewriter_append_Earrayset(writer, stage->Earrayset, stage->sizeappend,
+                                           stage->block, dimdata);
+  else
+    success = AH5_append_Earrayset(stage->Earrayset, stage->sizeappend,
+                                   stage->block, (void *)dimdata);
+
+  stage->deposited = 0;
+  stage->rejected  = AH5_FALSE;
+  stage->nb_ranges = 0;
+  return success;
+}
+
+
+char AH5_close_estage(AH5_estage_t *stage)
+{
+  if(stage == NULL)
+    return AH5_TRUE;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_destroy(&stage->lock);
+#endif
+
+  free(stage->ranges);
+  free(stage->block);
+  free(stage);
+  return AH5_TRUE;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file   ah5_estage.h
+ *
+ * @brief  Thread-safe staging of the appends to an Earrayset.
+ *
+ * The threads of a shared-memory code deposit the slabs of a step with
+ * their offset in the step block, then one thread commits the assembled
+ * block with a single append. The deposits are copies to disjoint parts
+ * of the block (an overlapping deposit is rejected) and do not call HDF5,
+ * so they can run concurrently with the serial HDF5 library.
+ *
+ * A step block has the layout of the data of AH5_append_Earrayset for
+ * 'sizeappend' (C order), the offsets and sizes are in elements.
+ *
+ * The commit must not overlap with the deposits (for instance it follows
+ * the barrier of the step). Without pthreads the deposits must be serial.
+ */
+
+#ifndef _AH5_ESTAGE_H_
+#define _AH5_ESTAGE_H_
+
+#include "ah5_ewriter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _AH5_estage_t AH5_estage_t;
+
+
+/* Start the staging of the appends of 'sizeappend' to an Earrayset.*/
+AH5_PUBLIC char AH5_open_estage(
+  AH5_Earrayset_t *Earrayset,   /* pointer to AH5_Earrayset_t*/
+  hsize_t sizeappend,           /* number of dim appended by a commit*/
+  AH5_estage_t **stage);        /* the new stage*/
+
+/* Copy a slab into the current block (thread-safe).*/
+/* Return AH5_FALSE if the slab is out of the block or overlaps a deposit.*/
+AH5_PUBLIC char AH5_estage_deposit(
+  AH5_estage_t *stage,          /* the stage*/
+  hsize_t offset,               /* offset of the slab in the block*/
+  hsize_t nb_elements,          /* size of the slab*/
+  const void *data);            /* data of the slab (copied)*/
+
+/* Append the block when it is complete and start a new one.*/
+/* Return AH5_FALSE if the deposits do not exactly cover the block or one*/
+/* was rejected.*/
+AH5_PUBLIC char AH5_estage_commit(
+  AH5_estage_t *stage,          /* the stage*/
+  AH5_ewriter_t *writer,        /* queue the append (NULL to append now)*/
+  const void *dimdata);         /* data to append to extendible dim (can be NULL)*/
+
+/* Free the stage, an incomplete block is dropped.*/
+AH5_PUBLIC char AH5_close_estage(AH5_estage_t *stage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _AH5_ESTAGE_H_
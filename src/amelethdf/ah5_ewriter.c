@@ -0,0 +1,295 @@
+#include "ah5_ewriter.h"
+
+#if AH5_WITH_PTHREADS_
+#include <pthread.h>
+#endif
+
+
+typedef struct _AH5_ewriter_job_t
+{
+  AH5_Edataset_t            *Edataset;
+  hsize_t                    sizeappend;
+  size_t                     size;
+  char                      *data;
+  AH5_ewriter_func_t         func;        /* a call job if not NULL*/
+  void                      *user_data;
+  char                      *result;      /* where the call writes its result*/
+  struct _AH5_ewriter_job_t *next;
+}
+AH5_ewriter_job_t;
+
+struct _AH5_ewriter_t
+{
+  size_t             max_pending;
+  size_t             pending;     /* queued bytes*/
+  hsize_t            nb_jobs;     /* queued or running jobs*/
+  hsize_t            nb_queued;   /* jobs queued since the start*/
+  hsize_t            nb_done;     /* jobs done since the start*/
+  AH5_ewriter_job_t *head;
+  AH5_ewriter_job_t *tail;
+  char               status;
+  char               stop;
+#if AH5_WITH_PTHREADS_
+  pthread_t          thread;
+  pthread_mutex_t    lock;
+  pthread_cond_t     queued;      /* a job is queued or stop is set*/
+  pthread_cond_t     done;        /* a job is done*/
+#endif
+};
+
+
+/* Write and free a job, return the append status.*/
+/* A call job gives its result to the caller and does not fail the queue.*/
+static char AH5_ewriter_run(AH5_ewriter_job_t *job)
+{
+  char status = AH5_TRUE;
+
+  if(job->func != NULL)
+    *(job->result) = job->func(job->user_data);
+  else
+    status = AH5_append_Edataset(job->Edataset, job->sizeappend, job->data);
+
+  free(job->data);
+  free(job);
+  return status;
+}
+
+
+#if AH5_WITH_PTHREADS_
+static void *AH5_ewriter_main(void *arg)
+{
+  AH5_ewriter_t *writer = (AH5_ewriter_t *)arg;
+  AH5_ewriter_job_t *job;
+  size_t size;
+  char status;
+
+  pthread_mutex_lock(&writer->lock);
+  for(;;)
+  {
+    while(writer->head == NULL && !writer->stop)
+      pthread_cond_wait(&writer->queued, &writer->lock);
+    if(writer->head == NULL)
+      break;
+
+    job = writer->head;
+    writer->head = job->next;
+    if(writer->head == NULL)
+      writer->tail = NULL;
+    size = job->size;
+    pthread_mutex_unlock(&writer->lock);
+
+    status = AH5_ewriter_run(job);
+
+    pthread_mutex_lock(&writer->lock);
+    if(status != AH5_TRUE)
+      writer->status = AH5_FALSE;
+    writer->pending -= size;
+    writer->nb_jobs--;
+    writer->nb_done++;
+    pthread_cond_broadcast(&writer->done);
+  }
+  pthread_mutex_unlock(&writer->lock);
+
+  return NULL;
+}
+#endif
+
+
+char AH5_open_ewriter(size_t max_pending, AH5_ewriter_t **writer)
+{
+  AH5_ewriter_t *w;
+
+  *writer = NULL;
+  w = (AH5_ewriter_t *)malloc(sizeof(AH5_ewriter_t));
+  if(w == NULL)
+    return AH5_FALSE;
+
+  w->max_pending = max_pending;
+  w->pending     = 0;
+  w->nb_jobs     = 0;
+  w->nb_queued   = 0;
+  w->nb_done     = 0;
+  w->head        = NULL;
+  w->tail        = NULL;
+  w->status      = AH5_TRUE;
+  w->stop        = AH5_FALSE;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_init(&w->lock, NULL);
+  pthread_cond_init(&w->queued, NULL);
+  pthread_cond_init(&w->done, NULL);
+  if(pthread_create(&w->thread, NULL, AH5_ewriter_main, w) != 0)
+  {
+    pthread_cond_destroy(&w->done);
+    pthread_cond_destroy(&w->queued);
+    pthread_mutex_destroy(&w->lock);
+    free(w);
+    return AH5_FALSE;
+  }
+#endif
+
+  *writer = w;
+  return AH5_TRUE;
+}
+
+
+#if AH5_WITH_PTHREADS_
+/* Queue a job, writer->lock is held. Return the job ticket.*/
+static hsize_t AH5_ewriter_queue(AH5_ewriter_t *writer, AH5_ewriter_job_t *job)
+{
+  /* Back-pressure: a job larger than max_pending waits for an empty queue.*/
+  while(writer->pending > 0 && writer->pending + job->size > writer->max_pending)
+    pthread_cond_wait(&writer->done, &writer->lock);
+
+  if(writer->tail != NULL)
+    writer->tail->next = job;
+  else
+    writer->head = job;
+  writer->tail = job;
+  writer->pending += job->size;
+  writer->nb_jobs++;
+  pthread_cond_signal(&writer->queued);
+  return ++writer->nb_queued;
+}
+#endif
+
+
+char AH5_ewriter_append_Edataset(AH5_ewriter_t *writer,
+                                 AH5_Edataset_t *Edataset,
+                                 hsize_t sizeappend,
+                                 const void *data)
+{
+  AH5_ewriter_job_t *job;
+
+  job = (AH5_ewriter_job_t *)malloc(sizeof(AH5_ewriter_job_t));
+  if(job == NULL)
+    return AH5_FALSE;
+
+  job->Edataset   = Edataset;
+  job->sizeappend = sizeappend;
+  job->size       = AH5_append_size_Edataset(Edataset, sizeappend);
+  job->func       = NULL;
+  job->user_data  = NULL;
+  job->result     = NULL;
+  job->next       = NULL;
+  job->data       = (char *)malloc(job->size > 0 ? job->size : 1);
+  if(job->data == NULL)
+  {
+    free(job);
+    return AH5_FALSE;
+  }
+  memcpy(job->data, data, job->size);
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&writer->lock);
+  AH5_ewriter_queue(writer, job);
+  pthread_mutex_unlock(&writer->lock);
+#else
+  if(AH5_ewriter_run(job) != AH5_TRUE)
+    writer->status = AH5_FALSE;
+#endif
+
+  return AH5_TRUE;
+}
+
+
+char AH5_ewriter_append_Earrayset(AH5_ewriter_t *writer,
+                                  AH5_Earrayset_t *Earrayset,
+                                  hsize_t sizeappend,
+                                  const void *data,
+                                  const void *dimdata)
+{
+  AH5_RETURN_IF_FAILED(AH5_ewriter_append_Edataset(writer, &(Earrayset->data),
+                       sizeappend, data), AH5_FALSE);
+
+  if(dimdata != NULL)
+  {
+    AH5_RETURN_IF_FAILED(AH5_ewriter_append_Edataset(
+                           writer, Earrayset->dims + Earrayset->data.extendibledim,
+                           sizeappend, dimdata), AH5_FALSE);
+  }
+
+  return AH5_TRUE;
+}
+
+
+char AH5_ewriter_call(AH5_ewriter_t *writer, AH5_ewriter_func_t func, void *data)
+{
+  AH5_ewriter_job_t *job;
+  char result = AH5_FALSE;
+#if AH5_WITH_PTHREADS_
+  hsize_t ticket;
+#endif
+
+  job = (AH5_ewriter_job_t *)malloc(sizeof(AH5_ewriter_job_t));
+  if(job == NULL)
+    return AH5_FALSE;
+
+  job->Edataset   = NULL;
+  job->sizeappend = 0;
+  job->size       = 0;
+  job->data       = NULL;
+  job->func       = func;
+  job->user_data  = data;
+  job->result     = &result;
+  job->next       = NULL;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&writer->lock);
+  ticket = AH5_ewriter_queue(writer, job);
+  while(writer->nb_done < ticket)
+    pthread_cond_wait(&writer->done, &writer->lock);
+  pthread_mutex_unlock(&writer->lock);
+#else
+  (void) writer;
+  AH5_ewriter_run(job);
+#endif
+
+  return result;
+}
+
+
+char AH5_ewriter_flush(AH5_ewriter_t *writer)
+{
+  char status;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&writer->lock);
+  while(writer->nb_jobs > 0)
+    pthread_cond_wait(&writer->done, &writer->lock);
+  status = writer->status;
+  writer->status = AH5_TRUE;
+  pthread_mutex_unlock(&writer->lock);
+#else
+  status = writer->status;
+  writer->status = AH5_TRUE;
+#endif
+
+  return status;
+}
+
+
+char AH5_close_ewriter(AH5_ewriter_t *writer)
+{
+  char status;
+
+  if(writer == NULL)
+    return AH5_TRUE;
+
+  status = AH5_ewriter_flush(writer);
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&writer->lock);
+  writer->stop = AH5_TRUE;
+  pthread_cond_signal(&writer->queued);
+  pthread_mutex_unlock(&writer->lock);
+  pthread_join(writer->thread, NULL);
+
+  pthread_cond_destroy(&writer->done);
+  pthread_cond_destroy(&writer->queued);
+  pthread_mutex_destroy(&writer->lock);
+#endif
+
+  free(writer);
+  return status;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file   ah5_ewriter.h
+ *
+ * @brief  Background writer for the extendible datasets.
+ *
+ * The appends are copied and queued, a dedicated thread does all the
+ * HDF5 calls in the queue order. AH5_ewriter_flush waits until the
+ * queue is written.
+ *
+ * Between an append and the next flush, the queued Edataset/Earrayset
+ * must not be used. Other HDF5 work is run on the writer thread in the
+ * queue order with AH5_ewriter_call, so it can be mixed with the
+ * appends. Only direct HDF5 calls of the caller thread must wait for
+ * the flush, unless HDF5 is built thread-safe.
+ *
+ * Without pthreads the appends are written synchronously.
+ */
+
+#ifndef _AH5_EWRITER_H_
+#define _AH5_EWRITER_H_
+
+#include "ah5_edataset.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct _AH5_ewriter_t AH5_ewriter_t;
+
+/* Work run by AH5_ewriter_call, returns AH5_TRUE on success.*/
+typedef char (*AH5_ewriter_func_t)(void *data);
+
+
+/* Start a writer, an append waits while more than max_pending bytes are queued.*/
+AH5_PUBLIC char AH5_open_ewriter(
+  size_t max_pending,           /* max size of the queued data in bytes*/
+  AH5_ewriter_t **writer);      /* the new writer*/
+
+/* Queue an append to an Edataset (see AH5_append_Edataset).*/
+AH5_PUBLIC char AH5_ewriter_append_Edataset(
+  AH5_ewriter_t *writer,        /* the writer*/
+  AH5_Edataset_t *Edataset,     /* pointer to AH5_Edataset_t*/
+  hsize_t sizeappend,           /* number of dim to append*/
+  const void *data);            /* data to append (copied)*/
+
+/* Queue an append to an Earrayset (see AH5_append_Earrayset).*/
+AH5_PUBLIC char AH5_ewriter_append_Earrayset(
+  AH5_ewriter_t *writer,        /* the writer*/
+  AH5_Earrayset_t *Earrayset,   /* pointer to AH5_Earrayset_t*/
+  hsize_t sizeappend,           /* number of dim to append*/
+  const void *data,             /* data to append (copied)*/
+  const void *dimdata);         /* data to append to extendible dim (can be NULL)*/
+
+/* Run func(data) on the writer thread after the queued appends and wait*/
+/* for it (func must not use the writer). Return the result of func.*/
+AH5_PUBLIC char AH5_ewriter_call(
+  AH5_ewriter_t *writer,        /* the writer*/
+  AH5_ewriter_func_t func,      /* the work to run*/
+  void *data);                  /* the work data*/
+
+/* Wait until the queue is written.*/
+/* Return AH5_FALSE if a write failed since the last flush.*/
+AH5_PUBLIC char AH5_ewriter_flush(AH5_ewriter_t *writer);
+
+/* Flush, stop the thread and free the writer.*/
+AH5_PUBLIC char AH5_close_ewriter(AH5_ewriter_t *writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _AH5_EWRITER_H_
@@ -4,6 +4,9 @@
 #include "ah5_log.h"
 
 #include <ctype.h>
+#if AH5_WITH_PTHREADS_
+#include <pthread.h>
+#endif
 
 
 char AH5_write_str_root_attr(hid_t loc_id, const char *attr_name, const char *wdata)
@@ -34,10 +37,157 @@ char AH5_write_str_root_attr(hid_t loc_id, const char *attr_name, const char *wd
   return success;
 }
 
-hid_t AH5_create(const char *name, unsigned flags, const char *entry_point)
+void AH5_init_file_options(AH5_file_options_t *options)
+{
+  options->chunk_cache_slots = 0;
+  options->chunk_cache_bytes = 0;
+  options->chunk_cache_w0 = -1;
+  options->mdc_size = 0;
+  options->page_buffer_size = 0;
+  options->fspace_strategy = AH5_FSPACE_DEFAULT;
+  options->fspace_page_size = 0;
+  options->alignment = 0;
+  options->alignment_threshold = 0;
+  options->driver = AH5_DRIVER_DEFAULT;
+  options->core_increment = 0;
+  options->core_backing_store = AH5_FALSE;
+}
+
+
+// Build the file access property list of options.
+static hid_t AH5_file_access_plist(const AH5_file_options_t *options)
+{
+  hid_t fapl;
+  int mdc_nelmts;
+  size_t nslots, nbytes;
+  double w0;
+  H5AC_cache_config_t mdc;
+  herr_t status = 0;
+
+  if (!options)
+    return H5P_DEFAULT;
+
+  fapl = H5Pcreate(H5P_FILE_ACCESS);
+  if (fapl < 0)
+    return fapl;
+
+  if (options->chunk_cache_slots || options->chunk_cache_bytes || options->chunk_cache_w0 >= 0)
+  {
+    status |= H5Pget_cache(fapl, &mdc_nelmts, &nslots, &nbytes, &w0);
+    if (options->chunk_cache_slots)
+      nslots = options->chunk_cache_slots;
+    if (options->chunk_cache_bytes)
+      nbytes = options->chunk_cache_bytes;
+    if (options->chunk_cache_w0 >= 0)
+      w0 = options->chunk_cache_w0;
+    status |= H5Pset_cache(fapl, mdc_nelmts, nslots, nbytes, w0);
+  }
+
+  if (options->mdc_size)
+  {
+    mdc.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    status |= H5Pget_mdc_config(fapl, &mdc);
+    mdc.set_initial_size = 1;
+    mdc.initial_size = options->mdc_size;
+    if (mdc.min_size < options->mdc_size)
+      mdc.min_size = options->mdc_size;
+    if (mdc.max_size < options->mdc_size)
+      mdc.max_size = options->mdc_size;
+    status |= H5Pset_mdc_config(fapl, &mdc);
+  }
+
+  if (options->page_buffer_size)
+  {
+#if H5_VERSION_GE(1, 10, 1)
+    status |= H5Pset_page_buffer_size(fapl, options->page_buffer_size, 0, 0);
+#else
+    status = -1;
+#endif
+  }
+
+  if (options->alignment)
+    status |= H5Pset_alignment(fapl, options->alignment_threshold, options->alignment);
+
+  if (options->driver == AH5_DRIVER_SEC2)
+    status |= H5Pset_fapl_sec2(fapl);
+  else if (options->driver == AH5_DRIVER_CORE)
+    status |= H5Pset_fapl_core(
+        fapl, options->core_increment ? options->core_increment : 1024 * 1024,
+        options->core_backing_store ? 1 : 0);
+
+  if (status < 0)
+  {
+    AH5_log_error("Invalid file access options.");
+    H5Pclose(fapl);
+    return -1;
+  }
+
+  return fapl;
+}
+
+
+// Build the file creation property list of options.
+static hid_t AH5_file_create_plist(const AH5_file_options_t *options)
 {
-  hid_t file_id;
-  file_id = H5Fcreate(name, flags, H5P_DEFAULT, H5P_DEFAULT);
+  hid_t fcpl;
+  herr_t status = 0;
+
+  if (!options || options->fspace_strategy == AH5_FSPACE_DEFAULT)
+    return H5P_DEFAULT;
+
+  fcpl = H5Pcreate(H5P_FILE_CREATE);
+  if (fcpl < 0)
+    return fcpl;
+
+#if H5_VERSION_GE(1, 10, 1)
+  switch (options->fspace_strategy)
+  {
+    case AH5_FSPACE_FSM_AGGR:
+      status = H5Pset_file_space_strategy(fcpl, H5F_FSPACE_STRATEGY_FSM_AGGR, 0, 1);
+      break;
+    case AH5_FSPACE_PAGE:
+      status = H5Pset_file_space_strategy(fcpl, H5F_FSPACE_STRATEGY_PAGE, 0, 1);
+      break;
+    case AH5_FSPACE_AGGR:
+      status = H5Pset_file_space_strategy(fcpl, H5F_FSPACE_STRATEGY_AGGR, 0, 1);
+      break;
+    default:
+      status = H5Pset_file_space_strategy(fcpl, H5F_FSPACE_STRATEGY_NONE, 0, 1);
+      break;
+  }
+  if (status >= 0 && options->fspace_page_size)
+    status = H5Pset_file_space_page_size(fcpl, options->fspace_page_size);
+#else
+  status = -1;
+#endif
+
+  if (status < 0)
+  {
+    AH5_log_error("Invalid file creation options.");
+    H5Pclose(fcpl);
+    return -1;
+  }
+
+  return fcpl;
+}
+
+
+hid_t AH5_create_ex(const char *name, unsigned flags, const char *entry_point,
+                    const AH5_file_options_t *options)
+{
+  hid_t file_id = -1;
+  hid_t fcpl, fapl;
+
+  fcpl = AH5_file_create_plist(options);
+  fapl = AH5_file_access_plist(options);
+  if (fcpl >= 0 && fapl >= 0)
+    file_id = H5Fcreate(name, flags, fcpl, fapl);
+  if (fcpl >= 0 && fcpl != H5P_DEFAULT)
+    H5Pclose(fcpl);
+  if (fapl >= 0 && fapl != H5P_DEFAULT)
+    H5Pclose(fapl);
+  if (file_id < 0)
+    return file_id;
 
   AH5_write_str_root_attr(file_id, AH5_FILE_A_FORMAT, AH5_FILE_FORMAT);
   AH5_write_str_root_attr(file_id, AH5_FILE_A_VERSION, AH5_FILE_DEFAULT_VERSION);
@@ -49,16 +199,86 @@ hid_t AH5_create(const char *name, unsigned flags, const char *entry_point)
 }
 
 
+hid_t AH5_create(const char *name, unsigned flags, const char *entry_point)
+{
+  return AH5_create_ex(name, flags, entry_point, NULL);
+}
+
+
+hid_t AH5_open_ex(const char *name, unsigned flags, const AH5_file_options_t *options)
+{
+  hid_t file_id = -1;
+  hid_t fapl;
+
+  fapl = AH5_file_access_plist(options);
+  if (fapl >= 0)
+    file_id = H5Fopen(name, flags, fapl);
+  if (fapl >= 0 && fapl != H5P_DEFAULT)
+    H5Pclose(fapl);
+
+  return file_id;
+}
+
+
 hid_t AH5_open(const char *name, unsigned flags)
 {
-  return H5Fopen(name, flags, H5P_DEFAULT);
+  return AH5_open_ex(name, flags, NULL);
+}
+
+
+hid_t AH5_open_in_memory(const char *name, unsigned flags, char write_back)
+{
+  AH5_file_options_t options;
+
+  AH5_init_file_options(&options);
+  options.driver = AH5_DRIVER_CORE;
+  options.core_backing_store = write_back;
+  return AH5_open_ex(name, flags, &options);
+}
+
+
+hid_t AH5_open_image(void *image, size_t size, unsigned flags)
+{
+  return H5LTopen_file_image(image, size, flags);
+}
+
+
+char AH5_get_image(hid_t file_id, void **image, size_t *size)
+{
+  ssize_t length;
+
+  *image = NULL;
+  *size = 0;
+
+  H5Fflush(file_id, H5F_SCOPE_GLOBAL);
+  length = H5Fget_file_image(file_id, NULL, 0);
+  if (length <= 0)
+    return AH5_FALSE;
+
+  *image = AH5_alloc((size_t) length);
+  if (*image == NULL)
+    return AH5_FALSE;
+
+  if (H5Fget_file_image(file_id, *image, (size_t) length) != length)
+  {
+    AH5_release(*image);
+    *image = NULL;
+    return AH5_FALSE;
+  }
+
+  *size = (size_t) length;
+  return AH5_TRUE;
 }
 
 
 int AH5_close(hid_t file_id)
 {
   const ssize_t count = H5Fget_obj_count(file_id, H5F_OBJ_ALL) - 1;
-  const herr_t err = H5Fclose(file_id);
+  herr_t err;
+
+  AH5_clear_path_cache(file_id);
+  err = H5Fclose(file_id);
+  AH5_set_filter_policy(file_id, NULL);
 
   if (count) {
     AH5_log_error(
@@ -94,6 +314,53 @@ size_t AH5_read_entrypoint_strlen(hid_t file_id)
 }
 
 
+static void *AH5_default_alloc(size_t size, void *UNUSED(user_data))
+{
+  return malloc(size);
+}
+
+
+static void AH5_default_release(void *ptr, void *UNUSED(user_data))
+{
+  free(ptr);
+}
+
+
+static AH5_allocator_t AH5_allocator = {AH5_default_alloc, AH5_default_release, NULL};
+
+
+void AH5_set_allocator(const AH5_allocator_t *allocator)
+{
+  if (allocator && allocator->alloc && allocator->release)
+    AH5_allocator = *allocator;
+  else
+  {
+    AH5_allocator.alloc = AH5_default_alloc;
+    AH5_allocator.release = AH5_default_release;
+    AH5_allocator.user_data = NULL;
+  }
+}
+
+
+const AH5_allocator_t *AH5_get_allocator(void)
+{
+  return &AH5_allocator;
+}
+
+
+void *AH5_alloc(size_t size)
+{
+  return AH5_allocator.alloc(size, AH5_allocator.user_data);
+}
+
+
+void AH5_release(void *ptr)
+{
+  if (ptr != NULL)
+    AH5_allocator.release(ptr, AH5_allocator.user_data);
+}
+
+
 // Set complex number
 AH5_complex_t AH5_set_complex(float real, float imag)
 {
@@ -110,13 +377,40 @@ AH5_complex_t AH5_set_complex(float real, float imag)
 }
 
 
+// Set double complex number
+AH5_dcomplex_t AH5_set_dcomplex(double real, double imag)
+{
+  AH5_dcomplex_t rdata;
+
+#ifdef AH5_SDT_CCOMPLEX
+  rdata =  real + imag * _Complex_I;
+#else
+  rdata.re = real;
+  rdata.im = imag;
+#endif /*AH5_SDT_CCOMPLEX*/
+
+  return rdata;
+}
+
+
+// Offsets of the real and imaginary parts in AH5_complex_t and AH5_dcomplex_t
+#ifdef AH5_SDT_CCOMPLEX
+#define AH5_CPX_RE_OFFSET(type, part) 0
+#define AH5_CPX_IM_OFFSET(type, part) sizeof(part)
+#else
+#define AH5_CPX_RE_OFFSET(type, part) HOFFSET(type, re)
+#define AH5_CPX_IM_OFFSET(type, part) HOFFSET(type, im)
+#endif /*AH5_SDT_CCOMPLEX*/
+
+
+// The layout of AH5_complex_t: the values are read and written in place.
 hid_t AH5_H5Tcreate_cpx_memtype(void)
 {
   hid_t cpx_memtype;
 
-  cpx_memtype = H5Tcreate(H5T_COMPOUND, H5Tget_size(H5T_NATIVE_FLOAT) * 2);
-  H5Tinsert(cpx_memtype, "r", 0, H5T_NATIVE_FLOAT);
-  H5Tinsert(cpx_memtype, "i", H5Tget_size(H5T_NATIVE_FLOAT), H5T_NATIVE_FLOAT);
+  cpx_memtype = H5Tcreate(H5T_COMPOUND, sizeof(AH5_complex_t));
+  H5Tinsert(cpx_memtype, "r", AH5_CPX_RE_OFFSET(AH5_complex_t, float), H5T_NATIVE_FLOAT);
+  H5Tinsert(cpx_memtype, "i", AH5_CPX_IM_OFFSET(AH5_complex_t, float), H5T_NATIVE_FLOAT);
 
   return cpx_memtype;
 }
@@ -134,6 +428,31 @@ hid_t AH5_H5Tcreate_cpx_filetype(void)
 }
 
 
+// The layout of AH5_dcomplex_t: the values are read and written in place.
+hid_t AH5_H5Tcreate_dcpx_memtype(void)
+{
+  hid_t dcpx_memtype;
+
+  dcpx_memtype = H5Tcreate(H5T_COMPOUND, sizeof(AH5_dcomplex_t));
+  H5Tinsert(dcpx_memtype, "r", AH5_CPX_RE_OFFSET(AH5_dcomplex_t, double), H5T_NATIVE_DOUBLE);
+  H5Tinsert(dcpx_memtype, "i", AH5_CPX_IM_OFFSET(AH5_dcomplex_t, double), H5T_NATIVE_DOUBLE);
+
+  return dcpx_memtype;
+}
+
+
+hid_t AH5_H5Tcreate_dcpx_filetype(void)
+{
+  hid_t dcpx_filetype;
+
+  dcpx_filetype = H5Tcreate(H5T_COMPOUND, H5Tget_size(AH5_NATIVE_DOUBLE) * 2);
+  H5Tinsert(dcpx_filetype, "r", 0, AH5_NATIVE_DOUBLE);
+  H5Tinsert(dcpx_filetype, "i", H5Tget_size(AH5_NATIVE_DOUBLE), AH5_NATIVE_DOUBLE);
+
+  return dcpx_filetype;
+}
+
+
 /*
     AH5_FALSE = AH5_version_minimum("0.5", "0.1");
     AH5_FALSE = AH5_version_minimum("3.5", "2");
@@ -362,54 +681,184 @@ char *AH5_trim_path(char *path)
 }
 
 
-// Check for path validity
-char AH5_path_valid(hid_t loc_id, const char *path)
+// Known valid paths cache (direct mapped, keyed by location and path). The
+// location is the file number and object address, not reused as the ids are.
+#define AH5_PATH_CACHE_SIZE 1024
+
+typedef struct _AH5_path_cache_loc_t
+{
+  unsigned long   fileno;
+  haddr_t         addr;
+} AH5_path_cache_loc_t;
+
+typedef struct _AH5_path_cache_entry_t
+{
+  AH5_path_cache_loc_t loc;
+  unsigned long   hash;
+  size_t          length;
+  char            *path;
+} AH5_path_cache_entry_t;
+
+static AH5_path_cache_entry_t AH5_path_cache[AH5_PATH_CACHE_SIZE];
+static char AH5_path_cache_enabled = AH5_TRUE;
+#if AH5_WITH_PTHREADS_
+static pthread_mutex_t AH5_path_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+
+// Get the cache key of a location
+static char AH5_path_cache_loc(hid_t loc_id, AH5_path_cache_loc_t *loc)
+{
+  H5O_info_t info;
+
+#if H5_VERSION_GE(1, 10, 3)
+  if (H5Oget_info2(loc_id, &info, H5O_INFO_BASIC) < 0)
+#else
+  if (H5Oget_info(loc_id, &info) < 0)
+#endif
+    return AH5_FALSE;
+  loc->fileno = info.fileno;
+  loc->addr = info.addr;
+  return AH5_TRUE;
+}
+
+
+static unsigned long AH5_path_cache_hash(const AH5_path_cache_loc_t *loc,
+                                         const char *path, size_t length)
+{
+  unsigned long hash = 5381UL ^ loc->fileno ^ ((unsigned long) loc->addr << 8);
+  size_t i;
+
+  for (i = 0; i < length; ++i)
+    hash = (hash * 33UL) ^ (unsigned char) path[i];
+  return hash;
+}
+
+
+// Return AH5_TRUE if the length first characters of path are a known valid path
+static char AH5_path_cache_find(const AH5_path_cache_loc_t *loc, const char *path, size_t length)
 {
+  unsigned long hash = AH5_path_cache_hash(loc, path, length);
+  const AH5_path_cache_entry_t *entry = AH5_path_cache + hash % AH5_PATH_CACHE_SIZE;
+  char found;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&AH5_path_cache_lock);
+#endif
+  found = entry->path && entry->loc.fileno == loc->fileno && entry->loc.addr == loc->addr
+          && entry->hash == hash && entry->length == length
+          && strncmp(entry->path, path, length) == 0;
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&AH5_path_cache_lock);
+#endif
+  return found;
+}
+
+
+static void AH5_path_cache_add(const AH5_path_cache_loc_t *loc, const char *path, size_t length)
+{
+  unsigned long hash = AH5_path_cache_hash(loc, path, length);
+  AH5_path_cache_entry_t *entry = AH5_path_cache + hash % AH5_PATH_CACHE_SIZE;
   char *temp;
-  int i, slashes = 0;
 
-  temp = strdup(path);
-  for (i = (int) strlen(path); i > 0; i--)
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&AH5_path_cache_lock);
+#endif
+  temp = (char *) realloc(entry->path, length + 1);
+  if (temp)
   {
-    if (temp[i] == '/')
-    {
-      temp[i] = '\0';
-      slashes++;  /* count number of slashes excluding the first one */
-    }
+    memcpy(temp, path, length);
+    temp[length] = '\0';
+    entry->path = temp;
+    entry->loc = *loc;
+    entry->hash = hash;
+    entry->length = length;
   }
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&AH5_path_cache_lock);
+#endif
+}
 
-  if (strcmp(path, ".") == 0)
-  {
-    if (!H5Iis_valid(loc_id))
+
+// Forget the known valid paths of the file of a location (all if loc_id is negative)
+void AH5_clear_path_cache(hid_t loc_id)
+{
+  AH5_path_cache_loc_t loc;
+  int i;
+
+  if (loc_id >= 0 && !AH5_path_cache_loc(loc_id, &loc))
+    return;
+
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_lock(&AH5_path_cache_lock);
+#endif
+  for (i = 0; i < AH5_PATH_CACHE_SIZE; ++i)
+    if (AH5_path_cache[i].path && (loc_id < 0 || AH5_path_cache[i].loc.fileno == loc.fileno))
     {
-      free(temp);
-      return AH5_FALSE;
+      free(AH5_path_cache[i].path);
+      AH5_path_cache[i].path = NULL;
     }
-  }
-  else
+#if AH5_WITH_PTHREADS_
+  pthread_mutex_unlock(&AH5_path_cache_lock);
+#endif
+}
+
+
+// Enable or disable (and clear) the known valid paths cache
+void AH5_set_path_cache(char enabled)
+{
+  AH5_path_cache_enabled = enabled;
+  if (!enabled)
+    AH5_clear_path_cache(-1);
+}
+
+
+// Check for path validity
+char AH5_path_valid(hid_t loc_id, const char *path)
+{
+  AH5_path_cache_loc_t loc;
+  char *temp, valid = AH5_TRUE, c, cached;
+  size_t i, end, length;
+
+  if (strcmp(path, ".") == 0)
+    return H5Iis_valid(loc_id) > 0;
+
+  length = strlen(path);
+  if (length == 0)
+    return AH5_FALSE;
+
+  // Start after the longest known prefix.
+  end = 0;
+  cached = AH5_path_cache_enabled && AH5_path_cache_loc(loc_id, &loc);
+  if (cached)
   {
-    if(H5Lexists(loc_id, temp, H5P_DEFAULT) != AH5_TRUE)
-    {
-      free(temp);
-      return AH5_FALSE;
-    }
+    end = length;
+    while (end > 0 && !AH5_path_cache_find(&loc, path, end))
+      do
+        end--;
+      while (end > 0 && path[end] != '/');
+
+    if (end == length)
+      return AH5_TRUE;
   }
 
-  i = 1;
-  while (slashes > 0)
+  // Check each remaining component ("/a", "/a/b", ...).
+  temp = strdup(path);
+  for (i = end + 1; valid && i <= length; ++i)
   {
-    while (temp[i] != '\0')
-      i++;
-    temp[i] = '/';
-    slashes--;
-    if(H5Lexists(loc_id, temp, H5P_DEFAULT) != AH5_TRUE)
-    {
-      free(temp);
-      return AH5_FALSE;
-    }
+    if (i < length && temp[i] != '/')
+      continue;
+
+    c = temp[i];
+    temp[i] = '\0';
+    if (H5Lexists(loc_id, temp, H5P_DEFAULT) != AH5_TRUE)
+      valid = AH5_FALSE;
+    else if (cached)
+      AH5_path_cache_add(&loc, temp, i);
+    temp[i] = c;
   }
   free(temp);
-  return AH5_TRUE;
+  return valid;
 }
 
 
@@ -436,30 +885,126 @@ char AH5_setpath(char **dest, const char *src)
 }
 
 
-// Add element to aset; allocates new memory!!!
+// Add element to aset (copied in the set)
 AH5_set_t* AH5_add_to_set(AH5_set_t* aset, const char *aelement)
 {
-  char** tmp = NULL;
-  hsize_t i = 0;
-  size_t len = 0;
-  if (!AH5_index_in_set(aset, aelement, NULL))
+  return AH5_add_all_to_set(aset, &aelement, 1);
+}
+
+
+#define AH5_SET_BLOCK_SIZE 65536
+
+
+static unsigned long AH5_set_hash(const char *aelement)
+{
+  unsigned long hash = 2166136261UL;
+
+  while (*aelement)
+    hash = (hash ^ (unsigned char) *aelement++) * 16777619UL;
+  return hash;
+}
+
+
+// Return the table slot of an element, either its slot or the empty one to use
+static hsize_t AH5_set_slot(const AH5_set_t* aset, const char *aelement)
+{
+  hsize_t mask = aset->table_size - 1, slot;
+
+  slot = AH5_set_hash(aelement) & mask;
+  while (aset->table[slot] && strcmp(aset->values[aset->table[slot] - 1], aelement) != 0)
+    slot = (slot + 1) & mask;
+  return slot;
+}
+
+
+// Make room for size values (the table is kept at most half full)
+static char AH5_reserve_set(AH5_set_t* aset, hsize_t size)
+{
+  hsize_t capacity, table_size, i;
+  hsize_t *table;
+  char **values;
+
+  if (size > aset->capacity)
+  {
+    // Grow geometrically so that the single adds are amortized
+    capacity = aset->capacity ? 2 * aset->capacity : 16;
+    if (capacity < size)
+      capacity = size;
+    values = (char **) realloc(aset->values, (size_t) capacity * sizeof(char *));
+    if (!values)
+      return AH5_FALSE;
+    aset->values = values;
+    aset->capacity = capacity;
+  }
+
+  if (2 * size > aset->table_size)
+  {
+    table_size = aset->table_size ? aset->table_size : 16;
+    while (table_size < 2 * size)
+      table_size *= 2;
+    table = (hsize_t *) calloc((size_t) table_size, sizeof(hsize_t));
+    if (!table)
+      return AH5_FALSE;
+
+    free(aset->table);
+    aset->table = table;
+    aset->table_size = table_size;
+    for (i = 0; i < aset->nb_values; ++i)
+      aset->table[AH5_set_slot(aset, aset->values[i])] = i + 1;
+  }
+  return AH5_TRUE;
+}
+
+
+// Copy a value in the set blocks
+static char *AH5_intern_in_set(AH5_set_t* aset, const char *aelement)
+{
+  size_t length = strlen(aelement) + 1, size;
+  char **blocks, *value;
+
+  if (aset->block_used + length > aset->block_size)
   {
-    tmp = malloc(sizeof(char*) * (1 + aset->nb_values));
-    for (i = 0; i < aset->nb_values; ++i) {
-      len = strlen(aset->values[i]);
-      tmp[i] = malloc(len + 1);
-      strncpy(tmp[i], aset->values[i], len);
-      tmp[i][len] = '\0';
-      free(aset->values[i]);
+    blocks = (char **) realloc(aset->blocks, (size_t) (aset->nb_blocks + 1) * sizeof(char *));
+    if (!blocks)
+      return NULL;
+    aset->blocks = blocks;
+
+    size = length > AH5_SET_BLOCK_SIZE ? length : AH5_SET_BLOCK_SIZE;
+    aset->blocks[aset->nb_blocks] = (char *) malloc(size);
+    if (!aset->blocks[aset->nb_blocks])
+      return NULL;
+    aset->nb_blocks++;
+    aset->block_size = size;
+    aset->block_used = 0;
+  }
+
+  value = aset->blocks[aset->nb_blocks - 1] + aset->block_used;
+  memcpy(value, aelement, length);
+  aset->block_used += length;
+  return value;
+}
+
+
+// Add elements to a set (the ones already present are skipped)
+AH5_set_t* AH5_add_all_to_set(AH5_set_t* aset, const char * const *aelements, hsize_t nb_elements)
+{
+  hsize_t i, slot;
+  char *value;
+
+  if (!AH5_reserve_set(aset, aset->nb_values + nb_elements))
+    return NULL;
+
+  for (i = 0; i < nb_elements; ++i)
+  {
+    slot = AH5_set_slot(aset, aelements[i]);
+    if (!aset->table[slot])
+    {
+      value = AH5_intern_in_set(aset, aelements[i]);
+      if (!value)
+        return NULL;
+      aset->values[aset->nb_values++] = value;
+      aset->table[slot] = aset->nb_values;
     }
-    len = strlen(aelement);
-    tmp[aset->nb_values] = malloc(len);
-    strncpy(tmp[i], aelement, len);
-    tmp[i][len] = '\0';
-
-    free(aset->values);
-    aset->values = tmp;
-    ++aset->nb_values;
   }
   return aset;
 }
@@ -468,92 +1013,162 @@ AH5_set_t* AH5_add_to_set(AH5_set_t* aset, const char *aelement)
 void AH5_init_set(AH5_set_t* aset) {
   aset->nb_values = 0;
   aset->values = NULL;
+  aset->capacity = 0;
+  aset->table = NULL;
+  aset->table_size = 0;
+  aset->blocks = NULL;
+  aset->nb_blocks = 0;
+  aset->block_size = 0;
+  aset->block_used = 0;
 }
 
 void AH5_free_set(AH5_set_t* aset)
 {
   hsize_t i = 0;
-  if (aset->nb_values > 0) {
-    for (i = 0; i < aset->nb_values; ++i) free(aset->values[i]);
-    free(aset->values);
-    AH5_init_set(aset);
-  }
+
+  for (i = 0; i < aset->nb_blocks; ++i)
+    free(aset->blocks[i]);
+  free(aset->blocks);
+  free(aset->values);
+  free(aset->table);
+  AH5_init_set(aset);
 }
 
 
-// Return the index of first occurrence of an element
+// Return the index of an element
 char AH5_index_in_set(const AH5_set_t* aset, const char *aelement, hsize_t *index)
 {
-  char present = AH5_FALSE;
-  hsize_t i;
+  hsize_t slot;
 
-  for (i = 0; i < aset->nb_values; i++)
-  {
-    if (AH5_strcmp(aelement, aset->values[i]) == 0)
-    {
-      if (index != NULL) *index = i;
-      present = AH5_TRUE;
-      break;
-    }
-  }
-  return present;
+  if (!aset->table_size)
+    return AH5_FALSE;
+
+  slot = AH5_set_slot(aset, aelement);
+  if (!aset->table[slot])
+    return AH5_FALSE;
+
+  if (index != NULL)
+    *index = aset->table[slot] - 1;
+  return AH5_TRUE;
 }
 
 
 // Read children names of an object
 AH5_children_t AH5_read_children_name(hid_t file_id, const char *path)
 {
-  H5G_info_t ginfo;
   AH5_children_t children;
-  hsize_t i, j = 0;
-  ssize_t size;
-  hid_t group_id;
-  char *temp;
+  AH5_names_t names;
+  hsize_t i;
 
   children.childnames = NULL;
-  /*
-      - path must exist
-      - number of children must be greater than zero
-      - element name
-          - must be readable
-          - must NOT be same as "_param"
-  */
-  if (AH5_path_valid(file_id, path) || strcmp(path, "/") == 0)
+  children.nb_children = 0;
+
+  AH5_init_names(&names);
+  AH5_read_names(file_id, path, &names);
+  if (names.nb_names > 0)
   {
-    group_id = H5Gopen(file_id, path, H5P_DEFAULT);
-    H5Gget_info(group_id, &ginfo);
-    if (ginfo.nlinks > 0)
-    {
-      temp = malloc(sizeof(*temp));
-      children.childnames = (char **) malloc((size_t) ginfo.nlinks * sizeof(char *));
-      for (i = 0; i < ginfo.nlinks; i++)
-      {
-        size = H5Lget_name_by_idx(group_id, ".", H5_INDEX_NAME, H5_ITER_INC, i, NULL, 0, H5P_DEFAULT);
-        if (size < 0)
-          AH5_log_error("Cannot read all children of \"%s\". *****\n\n", path);
-        else
-        {
-          temp = realloc(temp, (size + 1) * sizeof(*temp));
-          H5Lget_name_by_idx(group_id, ".", H5_INDEX_NAME, H5_ITER_INC, i, temp, size + 1, H5P_DEFAULT);
-          if (strcmp(temp, "_param") != 0)  // exclude parameterized attributes
-          {
-            children.childnames[j] = (char *) malloc((size + 2) * sizeof(char));
-            strcpy(children.childnames[j], "/");
-            strcat(children.childnames[j++], temp);
-          }
-        }
-      }
-      free(temp);
-      if (j == 0)
-        free(children.childnames);
-    }
-    H5Gclose(group_id);
+    children.childnames = (char **) malloc((size_t) names.nb_names * sizeof(char *));
+    for (i = 0; i < names.nb_names; i++)
+      children.childnames[i] = strdup(AH5_NAME(&names, i));
+    children.nb_children = names.nb_names;
   }
-  children.nb_children = j;
+  AH5_free_names(&names);
   return children;
 }
 
 
+void AH5_init_names(AH5_names_t *names)
+{
+  names->nb_names = 0;
+  names->capacity = 0;
+  names->offsets = NULL;
+  names->buffer = NULL;
+  names->size = 0;
+  names->buffer_size = 0;
+}
+
+
+// Append "/<name>" to the names arena
+static char AH5_push_name(AH5_names_t *names, const char *name)
+{
+  size_t length = strlen(name) + 2, *offsets;
+  hsize_t capacity;
+  char *buffer;
+
+  if (names->nb_names == names->capacity)
+  {
+    capacity = names->capacity ? 2 * names->capacity : 16;
+    offsets = (size_t *) realloc(names->offsets, (size_t) capacity * sizeof(size_t));
+    if (!offsets)
+      return AH5_FALSE;
+    names->offsets = offsets;
+    names->capacity = capacity;
+  }
+
+  if (names->size + length > names->buffer_size)
+  {
+    buffer = (char *) realloc(names->buffer, 2 * (names->size + length));
+    if (!buffer)
+      return AH5_FALSE;
+    names->buffer = buffer;
+    names->buffer_size = 2 * (names->size + length);
+  }
+
+  names->offsets[names->nb_names++] = names->size;
+  names->buffer[names->size] = '/';
+  strcpy(names->buffer + names->size + 1, name);
+  names->size += length;
+  return AH5_TRUE;
+}
+
+
+static herr_t AH5_read_names_op(
+    hid_t UNUSED(loc_id), const char *name, const H5L_info_t *UNUSED(info), void *op_data)
+{
+  if (strcmp(name, "_param") == 0)  // exclude parameterized attributes
+    return 0;
+  return AH5_push_name((AH5_names_t *) op_data, name) ? 0 : -1;
+}
+
+
+/**
+ * Read the children names of a group in one pass.
+ *
+ * The previous names are dropped but their storage is reused.
+ *
+ * @param[in] loc_id the file or location identifier
+ * @param[in] path the group path
+ * @param[in,out] names the names (initialized with AH5_init_names)
+ *
+ * @return AH5_TRUE on success, AH5_FALSE if the group does not exist or
+ * cannot be read.
+ */
+char AH5_read_names(hid_t loc_id, const char *path, AH5_names_t *names)
+{
+  names->nb_names = 0;
+  names->size = 0;
+
+  if (!AH5_path_valid(loc_id, path) && strcmp(path, "/") != 0)
+    return AH5_FALSE;
+
+  if (H5Literate_by_name(loc_id, path, H5_INDEX_NAME, H5_ITER_INC, NULL,
+                         AH5_read_names_op, names, H5P_DEFAULT) < 0)
+  {
+    AH5_log_error("Cannot read all children of \"%s\". *****\n\n", path);
+    return AH5_FALSE;
+  }
+  return AH5_TRUE;
+}
+
+
+void AH5_free_names(AH5_names_t *names)
+{
+  free(names->offsets);
+  free(names->buffer);
+  AH5_init_names(names);
+}
+
+
 // Get last part of a path; does not allocate new memory
 char *AH5_get_name_from_path(const char *path)
 {
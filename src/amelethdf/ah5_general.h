@@ -4,6 +4,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 #include <hdf5.h>
 #include <hdf5_hl.h>
 
@@ -89,17 +90,24 @@ extern "C" {
 #ifdef AH5_SDT_CCOMPLEX
 #include <complex.h>
 typedef float complex AH5_complex_t;
+typedef double complex AH5_dcomplex_t;
 #else
 typedef struct _AH5_complex_t
 {
   float			re;
   float			im;
 } AH5_complex_t;
+typedef struct _AH5_dcomplex_t
+{
+  double		re;
+  double		im;
+} AH5_dcomplex_t;
 #define creal(z) ((z).re)
 #define cimag(z) ((z).im)
 #endif /*AH5_STD_CCOMPLEX*/
 
 AH5_PUBLIC AH5_complex_t AH5_set_complex(float real, float imag);
+AH5_PUBLIC AH5_dcomplex_t AH5_set_dcomplex(double real, double imag);
 
 #include "ah5_attribute.h"
 #include "ah5_dataset.h"
@@ -110,12 +118,60 @@ typedef struct _AH5_children_t
   hsize_t         nb_children;
 } AH5_children_t;
 
+/**
+ * Children names packed in one reusable arena.
+ *
+ * The name i ("/<child name>", like AH5_children_t) is at
+ * buffer + offsets[i], see AH5_NAME. The storage is kept between
+ * AH5_read_names calls and released by AH5_free_names.
+ */
+typedef struct _AH5_names_t
+{
+  hsize_t         nb_names;
+  hsize_t         capacity;
+  size_t          *offsets;
+  char            *buffer;
+  size_t          size;
+  size_t          buffer_size;
+} AH5_names_t;
+
+#define AH5_NAME(names, i) ((names)->buffer + (names)->offsets[i])
+
+/**
+ * Set of strings, the values keep their insertion order.
+ *
+ * The values are interned in blocks owned by the set and indexed by an open
+ * addressing hash table, so insertion and lookup are O(1). Initialize it
+ * with AH5_init_set and release it with AH5_free_set.
+ */
 typedef struct _AH5_set_t
 {
   char            **values;
   hsize_t         nb_values;
+  hsize_t         capacity;
+  hsize_t         *table;       // value index + 1 (0 is an empty slot)
+  hsize_t         table_size;
+  char            **blocks;     // interned values
+  hsize_t         nb_blocks;
+  size_t          block_size;   // size of the last block
+  size_t          block_used;
 } AH5_set_t;
 
+/**
+ * Memory allocator used for the bulk payload buffers filled by the readers
+ * (unstructured mesh nodes and connectivity, floatingType dataset values).
+ *
+ * The buffers owned by these structures are released with the same
+ * allocator by the matching AH5_free_* function, so the allocator must not
+ * be changed while such structures are alive.
+ */
+typedef struct _AH5_allocator_t
+{
+  void *(*alloc)(size_t size, void *user_data);  /// allocate size bytes
+  void (*release)(void *ptr, void *user_data);   /// release a block given by alloc
+  void            *user_data;                    /// passed to alloc and release
+} AH5_allocator_t;
+
 /**
  * Write string attribute in given node.
  *
@@ -127,6 +183,57 @@ typedef struct _AH5_set_t
  */
 AH5_PUBLIC char AH5_write_str_root_attr(hid_t loc_id, const char *attr_name, const char *wdata);
 
+/**
+ * File driver of AH5_file_options_t.
+ */
+typedef enum _AH5_driver_t
+{
+  AH5_DRIVER_DEFAULT = 0,       /**< the HDF5 default driver */
+  AH5_DRIVER_SEC2,              /**< POSIX I/O */
+  AH5_DRIVER_CORE               /**< file in memory (see core_increment and core_backing_store) */
+} AH5_driver_t;
+
+/**
+ * File-space strategy of AH5_file_options_t (see H5Pset_file_space_strategy).
+ */
+typedef enum _AH5_fspace_t
+{
+  AH5_FSPACE_DEFAULT = 0,       /**< the HDF5 default strategy */
+  AH5_FSPACE_FSM_AGGR,          /**< free-space managers and aggregators */
+  AH5_FSPACE_PAGE,              /**< paged aggregation, needed by the page buffer */
+  AH5_FSPACE_AGGR,              /**< aggregators only */
+  AH5_FSPACE_NONE               /**< no free-space tracking */
+} AH5_fspace_t;
+
+/**
+ * File access and creation options of AH5_create_ex and AH5_open_ex.
+ *
+ * The zero values (see AH5_init_file_options) keep the HDF5 defaults. The
+ * page buffer and the file-space strategy need HDF5 1.10.1, the
+ * file-space strategy is only used at the file creation and the page
+ * buffer needs a file created with AH5_FSPACE_PAGE.
+ */
+typedef struct _AH5_file_options_t
+{
+  size_t          chunk_cache_slots;  /**< chunk cache hash table slots (a prime number) */
+  size_t          chunk_cache_bytes;  /**< chunk cache size per dataset */
+  double          chunk_cache_w0;     /**< chunk preemption policy (0 to 1), <0 for the default */
+  size_t          mdc_size;           /**< initial and minimum metadata cache size */
+  size_t          page_buffer_size;   /**< page buffer size (a multiple of the page size) */
+  AH5_fspace_t    fspace_strategy;    /**< file-space strategy */
+  hsize_t         fspace_page_size;   /**< file-space page size */
+  hsize_t         alignment;          /**< alignment of the objects of at least alignment_threshold bytes */
+  hsize_t         alignment_threshold;
+  AH5_driver_t    driver;             /**< file driver */
+  size_t          core_increment;     /**< memory increment of the core driver (0 for 1 MiB) */
+  char            core_backing_store; /**< write the core file to disk on close */
+} AH5_file_options_t;
+
+/**
+ * Initialize options that keep the HDF5 defaults.
+ */
+AH5_PUBLIC void AH5_init_file_options(AH5_file_options_t *options);
+
 /**
  * Create a Amelet-HDF file and set entry point if not null.
  *
@@ -139,6 +246,20 @@ AH5_PUBLIC char AH5_write_str_root_attr(hid_t loc_id, const char *attr_name, con
  */
 AH5_PUBLIC hid_t AH5_create(const char *name, unsigned flags, const char *entry_point);
 
+/**
+ * Create a Amelet-HDF file with options (see AH5_create).
+ *
+ * @param name name of the file to access.
+ * @param flags file access flags (see H5Fcreate)
+ * @param entry_point the Amelet-HDF entry point if NULL it is ignored.
+ * @param options the file options or NULL for the HDF5 defaults
+ *
+ * @return Returns a file identifier if successful; otherwise returns a
+ * negative value.
+ */
+AH5_PUBLIC hid_t AH5_create_ex(const char *name, unsigned flags, const char *entry_point,
+                               const AH5_file_options_t *options);
+
 /**
  * Open a Amelet-HDF file
  *
@@ -150,6 +271,62 @@ AH5_PUBLIC hid_t AH5_create(const char *name, unsigned flags, const char *entry_
  */
 AH5_PUBLIC hid_t AH5_open(const char *name, unsigned flags);
 
+/**
+ * Open a Amelet-HDF file with options (see AH5_open).
+ *
+ * @param name name name of the file to access.
+ * @param flags flags file access flags (see H5Fopen)
+ * @param options the file options or NULL for the HDF5 defaults
+ *
+ * @return Returns a file identifier if successful; otherwise returns a
+ * negative value.
+ */
+AH5_PUBLIC hid_t AH5_open_ex(const char *name, unsigned flags, const AH5_file_options_t *options);
+
+/**
+ * Open a Amelet-HDF file loaded in memory (core driver).
+ *
+ * The whole file is read at the opening, the reads are then done in
+ * memory. With write_back the changes are written to the file on close,
+ * otherwise they are lost.
+ *
+ * @param name name of the file to access.
+ * @param flags file access flags (see H5Fopen)
+ * @param write_back AH5_TRUE to write the file on close
+ *
+ * @return Returns a file identifier if successful; otherwise returns a
+ * negative value.
+ */
+AH5_PUBLIC hid_t AH5_open_in_memory(const char *name, unsigned flags, char write_back);
+
+/**
+ * Open a Amelet-HDF file from a memory image (see H5LTopen_file_image).
+ *
+ * By default the image is copied and can be released after the call. With
+ * H5LT_FILE_IMAGE_DONT_COPY | H5LT_FILE_IMAGE_DONT_RELEASE the image is
+ * used in place, so one image (read only) can be opened several times
+ * without copy; it must then outlive the files.
+ *
+ * @param image the file image (see AH5_get_image)
+ * @param size the image size in bytes
+ * @param flags H5LT_FILE_IMAGE_* flags
+ *
+ * @return Returns a file identifier if successful; otherwise returns a
+ * negative value.
+ */
+AH5_PUBLIC hid_t AH5_open_image(void *image, size_t size, unsigned flags);
+
+/**
+ * Get the memory image of an open file.
+ *
+ * @param file_id the file
+ * @param image the image, allocated with AH5_alloc
+ * @param size the image size in bytes
+ *
+ * @return AH5_TRUE on success.
+ */
+AH5_PUBLIC char AH5_get_image(hid_t file_id, void **image, size_t *size);
+
 
   /**
    * Close a Amelet-HDF file
@@ -190,17 +367,62 @@ AH5_PUBLIC char* AH5_read_entrypoint(hid_t file_id, char *entrypoint);
  */
 AH5_PUBLIC size_t AH5_read_entrypoint_strlen(hid_t file_id);
 
+/**
+ * Set the allocator used for the bulk payload buffers.
+ *
+ * @param allocator the allocator to use, it is copied. If NULL (or if one of
+ * its functions is NULL) the default malloc/free allocator is restored.
+ */
+AH5_PUBLIC void AH5_set_allocator(const AH5_allocator_t *allocator);
+
+/**
+ * Return the allocator used for the bulk payload buffers.
+ */
+AH5_PUBLIC const AH5_allocator_t *AH5_get_allocator(void);
+
+/**
+ * Allocate size bytes with the current allocator.
+ *
+ * @return a pointer to the allocated block or NULL.
+ */
+AH5_PUBLIC void *AH5_alloc(size_t size);
+
+/**
+ * Release a block allocated by AH5_alloc, do nothing if ptr is NULL.
+ */
+AH5_PUBLIC void AH5_release(void *ptr);
+
 AH5_PUBLIC hid_t AH5_H5Tcreate_cpx_memtype(void);
 AH5_PUBLIC hid_t AH5_H5Tcreate_cpx_filetype(void);
+AH5_PUBLIC hid_t AH5_H5Tcreate_dcpx_memtype(void);
+AH5_PUBLIC hid_t AH5_H5Tcreate_dcpx_filetype(void);
 
 AH5_PUBLIC char AH5_version_minimum(const char *required_version, const char *sim_version);
 AH5_PUBLIC char *AH5_trim_zeros(const char *version);
 AH5_PUBLIC char AH5_path_valid(hid_t file_id, const char *path);
+
+/**
+ * Known valid paths cache used by AH5_path_valid.
+ *
+ * The valid prefixes found by AH5_path_valid are cached by location
+ * (file number and object address), so the next checks of the same
+ * prefixes only query the location. AH5_close clears the entries of the
+ * file. Clear the cache of a file after removing links from it (loc_id is
+ * any location of the file, loc_id < 0 clears all the files). The cache is
+ * enabled by default and locked when built with pthreads.
+ */
+AH5_PUBLIC void AH5_clear_path_cache(hid_t loc_id);
+AH5_PUBLIC void AH5_set_path_cache(char enabled);
 AH5_PUBLIC AH5_set_t* AH5_add_to_set(AH5_set_t* aset, const char *aelement);
+AH5_PUBLIC AH5_set_t* AH5_add_all_to_set(
+    AH5_set_t* aset, const char * const *aelements, hsize_t nb_elements);
 AH5_PUBLIC char AH5_index_in_set(const AH5_set_t* aset, const char *aelement, hsize_t *index);
 AH5_PUBLIC void AH5_free_set(AH5_set_t* aset);
 AH5_PUBLIC void AH5_init_set(AH5_set_t* aset);
 AH5_PUBLIC AH5_children_t AH5_read_children_name(hid_t file_id, const char *path);
+AH5_PUBLIC void AH5_init_names(AH5_names_t *names);
+AH5_PUBLIC char AH5_read_names(hid_t loc_id, const char *path, AH5_names_t *names);
+AH5_PUBLIC void AH5_free_names(AH5_names_t *names);
 
 AH5_PUBLIC char *AH5_get_name_from_path(const char *path);
 AH5_PUBLIC char *AH5_get_base_from_path(const char *path);
@@ -2,6 +2,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 #include <ah5.h>
 #include "utest.h"
@@ -68,6 +69,37 @@ char *test_write_complex_dataset()
   return MU_FINISHED_WITHOUT_ERRORS;
 }
 
+char *test_complex_array()
+{
+  hid_t file_id;
+  int i;
+  hsize_t dims[2] = {3, 2}, start[2] = {1, 1}, count[2] = {2, 1};
+  AH5_complex_t cplx[6], slab[2], attr;
+
+  file_id = AH5_auto_test_file();
+  for (i = 0; i < 6; i++)
+    cplx[i] = AH5_set_complex(i, -0.5 * i);
+
+  // Written and read in place.
+  mu_assert("Write complex array.", AH5_write_cpx_array(file_id, "array", 2, dims, cplx));
+  mu_assert("Read complex slab.",
+            AH5_read_cpx_slab(file_id, "array", 2, start, count, NULL, slab));
+  for (i = 0; i < 2; i++)
+  {
+    mu_assert_equal("Check the real values.", creal(slab[i]), creal(cplx[3 + 2 * i]));
+    mu_assert_equal("Check the imaginary values.", cimag(slab[i]), cimag(cplx[3 + 2 * i]));
+  }
+
+  mu_assert("Write complex attribute.", AH5_write_cpx_attr(file_id, "array", "z", cplx[5]));
+  mu_assert("Read complex attribute.", AH5_read_cpx_attr(file_id, "array", "z", &attr));
+  mu_assert_equal("Check the real value.", creal(attr), creal(cplx[5]));
+  mu_assert_equal("Check the imaginary value.", cimag(attr), cimag(cplx[5]));
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
 char *test_read_complex_dataset()
 {
 
@@ -239,12 +271,266 @@ char *test_write_string_dataset()
 }
 
 
+//! Count the allocator calls.
+static int alloc_count = 0;
+
+void *counting_alloc(size_t size, void *user_data)
+{
+  ++*(int *)user_data;
+  return malloc(size);
+}
+
+void counting_release(void *ptr, void *user_data)
+{
+  --*(int *)user_data;
+  free(ptr);
+}
+
+//! Allow a number of allocations then fail.
+void *bounded_alloc(size_t size, void *user_data)
+{
+  if (*(int *)user_data == 0)
+    return NULL;
+  --*(int *)user_data;
+  return malloc(size);
+}
+
+void bounded_release(void *ptr, void *user_data)
+{
+  (void) user_data;
+  free(ptr);
+}
+
+//! Test read dataset into caller buffers and the allocator hook.
+char *test_read_dataset_into()
+{
+  hid_t file_id;
+  int i;
+  int idata[4] = {1, 2, 3, 4}, ibuf[4];
+  float fdata[3] = {0.5, 1.5, 2.5}, fbuf[3];
+  char *sdata[] = {"abc", "def"}, sbuf[2 * 4];
+  hsize_t dims[2] = {2, 2}, start[1] = {0};
+  AH5_allocator_t allocator;
+  AH5_dataset_t dataset;
+
+  file_id = AH5_auto_test_file();
+
+  mu_assert("Write int dataset.", AH5_write_int_dataset(file_id, "int", 4, idata));
+  mu_assert("Write float dataset.", AH5_write_flt_dataset(file_id, "flt", 3, fdata));
+  mu_assert("Write string dataset.", AH5_write_str_dataset(file_id, "str", 2, 3, sdata));
+  mu_assert("Write int array.", AH5_write_int_array(file_id, "array", 2, dims, idata));
+
+  mu_assert("Read int dataset into.",
+            AH5_read_int_dataset_into(file_id, "int", 4, H5P_DEFAULT, ibuf));
+  for (i = 0; i < 4; ++i)
+    mu_assert_eq("Check int value.", ibuf[i], idata[i]);
+  mu_assert("Read int dataset into a too small buffer.",
+            !AH5_read_int_dataset_into(file_id, "int", 3, H5P_DEFAULT, ibuf));
+
+  mu_assert("Read float dataset into.",
+            AH5_read_flt_dataset_into(file_id, "flt", 3, H5P_DEFAULT, fbuf));
+  for (i = 0; i < 3; ++i)
+    mu_assert_equal("Check float value.", fbuf[i], fdata[i]);
+  mu_assert("Read int dataset into with a memory type.",
+            AH5_read_char_dataset_into(file_id, "int", 8, H5T_NATIVE_CHAR, sbuf));
+  mu_assert_eq("Check converted value.", sbuf[3], 4);
+
+  mu_assert("Read string dataset into.",
+            AH5_read_str_dataset_into(file_id, "str", 2, 3, H5P_DEFAULT, sbuf));
+  mu_assert_str_equal("Check string value.", sbuf, "abc");
+  mu_assert_str_equal("Check string value.", sbuf + 4, "def");
+
+  // Use a custom allocator for the payload buffers.
+  allocator.alloc = counting_alloc;
+  allocator.release = counting_release;
+  allocator.user_data = &alloc_count;
+  AH5_set_allocator(&allocator);
+  mu_assert("Read floatingType dataset.", AH5_read_ft_dataset(file_id, "/array", &dataset));
+  mu_assert_eq("Check allocator calls.", alloc_count, 1);
+  for (i = 0; i < 4; ++i)
+    mu_assert_eq("Check floatingType dataset value.", dataset.values.i[i], idata[i]);
+  AH5_free_ft_dataset(&dataset);
+  mu_assert_eq("Check allocator calls.", alloc_count, 0);
+
+  // An allocator returning NULL fails the read.
+  mu_assert("Read strings.", AH5_read_ft_dataset(file_id, "/str", &dataset));
+  AH5_free_ft_dataset(&dataset);
+  mu_assert("Read string slab.",
+            AH5_read_ft_dataset_slab(file_id, "/str", start, dims, NULL, &dataset));
+  AH5_free_ft_dataset(&dataset);
+  allocator.alloc = bounded_alloc;
+  allocator.release = bounded_release;
+  allocator.user_data = &alloc_count;
+  AH5_set_allocator(&allocator);
+  for (i = 0; i < 2; ++i)
+  {
+    alloc_count = i;
+    mu_assert("Read strings without memory.", !AH5_read_ft_dataset(file_id, "/str", &dataset));
+    mu_assert("Check no values.", dataset.values.s == NULL);
+    alloc_count = i;
+    mu_assert("Read string slab without memory.",
+              !AH5_read_ft_dataset_slab(file_id, "/str", start, dims, NULL, &dataset));
+  }
+  alloc_count = 0;
+  AH5_set_allocator(NULL);
+  mu_assert("Check the default allocator.", AH5_get_allocator()->user_data == NULL);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+//! Test the 64-bit and double complex datasets.
+char *test_wide_dataset()
+{
+  hid_t file_id, mem_type;
+  int i;
+  double ddata[3] = {1.0e9 + 0.001, -2.5, 1.0e-300}, dbuf[3], *dread;
+  int64_t ldata[3] = {0, -1, 0}, lbuf[2], *lread;
+  AH5_dcomplex_t zdata[2], *zread;
+  hsize_t dims[2] = {3, 1}, start[2] = {1, 0}, count[2] = {2, 1};
+
+  ldata[0] = (int64_t) 3 << 32;
+  ldata[2] = ((int64_t) 1 << 31) + 7;
+  zdata[0] = AH5_set_dcomplex(1.0e9 + 0.001, -1.0e-9);
+  zdata[1] = AH5_set_dcomplex(0.5, 2.0);
+
+  file_id = AH5_auto_test_file();
+
+  mu_assert("Write double dataset.", AH5_write_dbl_dataset(file_id, "dbl", 3, ddata));
+  mu_assert("Write int64 dataset.", AH5_write_i64_dataset(file_id, "i64", 3, ldata));
+  mu_assert("Write double complex dataset.", AH5_write_dcpx_dataset(file_id, "dcpx", 2, zdata));
+  mu_assert("Write double array.", AH5_write_dbl_array(file_id, "dbl2", 2, dims, ddata));
+  mu_assert("Write int64 array.", AH5_write_i64_array(file_id, "i642", 2, dims, ldata));
+
+  mu_assert("Read double dataset.", AH5_read_dbl_dataset(file_id, "dbl", 3, &dread));
+  for (i = 0; i < 3; ++i)
+    mu_assert_equal("Check double value.", dread[i], ddata[i]);
+  free(dread);
+
+  mu_assert("Read int64 dataset.", AH5_read_i64_dataset(file_id, "i64", 3, &lread));
+  for (i = 0; i < 3; ++i)
+    mu_assert("Check int64 value.", lread[i] == ldata[i]);
+  free(lread);
+
+  mu_assert("Read double complex dataset.", AH5_read_dcpx_dataset(file_id, "dcpx", 2, &zread));
+  for (i = 0; i < 2; ++i)
+  {
+    mu_assert_equal("Check real part.", creal(zread[i]), creal(zdata[i]));
+    mu_assert_equal("Check imaginary part.", cimag(zread[i]), cimag(zdata[i]));
+  }
+  free(zread);
+
+  mu_assert("Read double slab.", AH5_read_dbl_slab(file_id, "dbl2", 2, start, count, NULL, dbuf));
+  mu_assert_equal("Check double slab.", dbuf[1], ddata[2]);
+  mu_assert("Read int64 slab.", AH5_read_i64_slab(file_id, "i642", 2, start, count, NULL, lbuf));
+  mu_assert("Check int64 slab.", lbuf[1] == ldata[2]);
+
+  // The native memory type reads without conversion.
+  mem_type = AH5_get_dataset_memtype(file_id, "dbl");
+  mu_assert("Double memory type.", H5Tequal(mem_type, H5T_NATIVE_DOUBLE) > 0);
+  H5Tclose(mem_type);
+  mem_type = AH5_get_dataset_memtype(file_id, "i64");
+  mu_assert("Int64 memory type.", H5Tequal(mem_type, H5T_NATIVE_INT64) > 0);
+  H5Tclose(mem_type);
+  mu_assert("No memory type.", AH5_get_dataset_memtype(file_id, "none") < 0);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+// Number of filters of a dataset.
+static int nb_filters(hid_t file_id, const char *path)
+{
+  hid_t dset, plist;
+  int nb;
+
+  dset = H5Dopen(file_id, path, H5P_DEFAULT);
+  plist = H5Dget_create_plist(dset);
+  nb = H5Pget_nfilters(plist);
+  H5Pclose(plist);
+  H5Dclose(dset);
+  return nb;
+}
+
+//! Test the filter policy of the written datasets.
+char *test_filter_policy()
+{
+  hid_t file_id;
+  AH5_filter_policy_t policy;
+  int *idata, small[4] = {1, 2, 3, 4};
+  float *fdata;
+  hsize_t dims[2] = {100, 100};
+  int i;
+
+  file_id = AH5_auto_test_file();
+
+  idata = (int *) malloc(10000 * sizeof(int));
+  fdata = (float *) malloc(10000 * sizeof(float));
+  for (i = 0; i < 10000; ++i)
+  {
+    idata[i] = i % 100;
+    fdata[i] = 0.001f * i;
+  }
+
+  // No policy: nothing changes.
+  mu_assert("Write int dataset.", AH5_write_int_dataset(file_id, "raw", 10000, idata));
+  mu_assert_eq("No filter.", nb_filters(file_id, "raw"), 0);
+
+  AH5_init_filter_policy(&policy);
+  policy.deflate = 6;
+  policy.shuffle = AH5_TRUE;
+  policy.float_digits = 3;
+  policy.min_size = 1024;
+  // More files with a policy than the first table holds.
+  for (i = 1; i <= 20; ++i)
+    mu_assert("Set other policy.", AH5_set_filter_policy(file_id + i, &policy));
+  mu_assert("Set policy.", AH5_set_filter_policy(file_id, &policy));
+
+  mu_assert("Write int dataset.", AH5_write_int_dataset(file_id, "int", 10000, idata));
+  mu_assert_eq("Shuffle and deflate.", nb_filters(file_id, "int"), 2);
+  mu_assert("Write small dataset.", AH5_write_int_dataset(file_id, "small", 4, small));
+  mu_assert_eq("Too small to be filtered.", nb_filters(file_id, "small"), 0);
+  mu_assert("Write float array.", AH5_write_flt_array(file_id, "flt", 2, dims, fdata));
+  mu_assert_eq("Scale-offset and deflate.", nb_filters(file_id, "flt"), 2);
+
+  memset(idata, 0, 10000 * sizeof(int));
+  memset(fdata, 0, 10000 * sizeof(float));
+  mu_assert("Read int dataset.", AH5_read_int_dataset_into(file_id, "int", 10000, H5P_DEFAULT, idata));
+  mu_assert("Read float array.", AH5_read_flt_dataset_into(file_id, "flt", 10000, H5P_DEFAULT, fdata));
+  for (i = 0; i < 10000; ++i)
+  {
+    mu_assert_eq("Lossless int.", idata[i], i % 100);
+    mu_assert("Float digits.", fabs(fdata[i] - 0.001f * i) < 0.001);
+  }
+
+  // Removed policy.
+  mu_assert("Remove policy.", AH5_set_filter_policy(file_id, NULL));
+  for (i = 1; i <= 20; ++i)
+    mu_assert("Remove other policy.", AH5_set_filter_policy(file_id + i, NULL));
+  mu_assert("Write int dataset.", AH5_write_int_dataset(file_id, "int2", 10000, idata));
+  mu_assert_eq("No filter.", nb_filters(file_id, "int2"), 0);
+
+  free(idata);
+  free(fdata);
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
 // Run all tests
 char *all_tests()
 {
   mu_run_test(test_write_complex_dataset);
   mu_run_test(test_read_complex_dataset);
+  mu_run_test(test_complex_array);
   mu_run_test(test_write_string_dataset);
+  mu_run_test(test_read_dataset_into);
+  mu_run_test(test_wide_dataset);
+  mu_run_test(test_filter_policy);
 
   return MU_FINISHED_WITHOUT_ERRORS;
 }
@@ -275,6 +275,209 @@ static char *test_Edataset(hid_t hdf)
 
 
 
+static char *test_buffered_Edataset(hid_t hdf)
+{
+  AH5_Edataset_t v;
+  int row[3];
+  int big[3 * 5];
+  int ref[3 * 12];
+  hsize_t size = 0;
+  char status;
+  int i, k;
+
+  hsize_t dims[] =
+  {
+    3, H5S_UNLIMITED
+  };
+
+  AH5_initialize_Edataset(&v);
+  status = AH5_create_Edataset(hdf, "e_buffered_array",
+                               2, dims, H5T_NATIVE_INT, &v);
+  mu_assert("Creation of Edataset failed.", status==AH5_TRUE);
+
+  status = AH5_set_buffer_Edataset(&v, 4);
+  mu_assert("Set buffer of Edataset failed.", status==AH5_TRUE);
+
+  // 6 appends of one step: flushed at 4 and 2 remain staged
+  for(i=0; i<6; i++)
+  {
+    for(k=0; k<3; k++)
+      row[k] = 10 * k + i;
+    status = AH5_append_Edataset(&v, 1, row);
+    mu_assert("Append to buffered Edataset failed.", status==AH5_TRUE);
+  }
+  mu_assert_eq("Buffered Edataset dims.", v.dims[1], 4);
+  mu_assert_eq("Buffered Edataset staged.", v.buffer_used, 2);
+
+  // too large to be staged: the staged steps are written before
+  for(k=0; k<3; k++)
+    for(i=0; i<5; i++)
+      big[5 * k + i] = 10 * k + 6 + i;
+  status = AH5_append_Edataset(&v, 5, big);
+  mu_assert("Append to buffered Edataset failed.", status==AH5_TRUE);
+  mu_assert_eq("Buffered Edataset dims.", v.dims[1], 11);
+
+  row[0] = 11;
+  row[1] = 21;
+  row[2] = 31;
+  status = AH5_append_Edataset(&v, 1, row);
+  mu_assert("Append to buffered Edataset failed.", status==AH5_TRUE);
+  mu_assert_eq("Buffered Edataset dims.", v.dims[1], 11);
+
+  status = AH5_flush_Edataset(&v);
+  mu_assert("Flush of Edataset failed.", status==AH5_TRUE);
+  mu_assert_eq("Flushed Edataset dims.", v.dims[1], 12);
+  size = 3 * v.dims[1];
+
+  status = AH5_free_Edataset(&v);
+  mu_assert("Free of Edataset failed.", status==AH5_TRUE);
+
+  for(k=0; k<3; k++)
+    for(i=0; i<12; i++)
+      ref[12 * k + i] = 10 * k + i;
+
+  status = Verify(hdf, "e_buffered_array", size, ref);
+  mu_assert("Error in the buffered data.", status==AH5_TRUE);
+
+  return NULL;
+}
+
+
+
+
+static char *get_chunk(hid_t hdf, const char *path, hsize_t chunk[2])
+{
+  hid_t dset, prop;
+
+  dset = H5Dopen(hdf, path, H5P_DEFAULT);
+  mu_assert("Open dataset failed.", dset >= 0);
+  prop = H5Dget_create_plist(dset);
+  mu_assert_eq("Chunk rank.", H5Pget_chunk(prop, 2, chunk), 2);
+  H5Pclose(prop);
+  H5Dclose(dset);
+
+  return NULL;
+}
+
+
+static char *test_chunk_Edataset(hid_t hdf)
+{
+  AH5_Edataset_t v;
+  hsize_t dims[2], initialdims[2], chunk[2];
+  float row[100];
+  char *message;
+  int i;
+
+  for(i=0; i<100; i++)
+    row[i] = (float)i;
+
+  // policy: the time dim is grown up to the target size
+  dims[0] = H5S_UNLIMITED;
+  dims[1] = 100;
+  AH5_initialize_Edataset(&v);
+  mu_assert("Creation of Edataset failed.",
+            AH5_create_flt_Edataset(hdf, "e_chunk_policy", 2, dims, &v));
+  mu_assert("Append to Edataset failed.", AH5_append_Edataset(&v, 1, row));
+  mu_assert("Free of Edataset failed.", AH5_free_Edataset(&v));
+  message = get_chunk(hdf, "e_chunk_policy", chunk);
+  if(message) return message;
+  mu_assert_eq("Policy chunk (time).", chunk[0], AH5_EARRAY_CHUNK_BYTES / 400);
+  mu_assert_eq("Policy chunk.", chunk[1], 100);
+
+  // override
+  dims[0] = H5S_UNLIMITED;
+  chunk[0] = 16;
+  chunk[1] = 50;
+  AH5_initialize_Edataset(&v);
+  mu_assert("Creation of Edataset failed.",
+            AH5_create_flt_Edataset(hdf, "e_chunk_override", 2, dims, &v));
+  mu_assert("Set chunk of Edataset failed.", AH5_set_chunk_Edataset(&v, chunk));
+  mu_assert("Append to Edataset failed.", AH5_append_Edataset(&v, 1, row));
+  mu_assert("Set chunk after the creation.", !AH5_set_chunk_Edataset(&v, chunk));
+  mu_assert("Free of Edataset failed.", AH5_free_Edataset(&v));
+  chunk[0] = chunk[1] = 0;
+  message = get_chunk(hdf, "e_chunk_override", chunk);
+  if(message) return message;
+  mu_assert_eq("Override chunk (time).", chunk[0], 16);
+  mu_assert_eq("Override chunk.", chunk[1], 50);
+
+  // the fixed dims larger than the target are split
+  initialdims[0] = 1;
+  initialdims[1] = 1000000;
+  dims[0] = H5S_UNLIMITED;
+  dims[1] = 1000000;
+  AH5_earray_chunk_dims(2, initialdims, dims, 4, chunk);
+  mu_assert_eq("Split chunk (time).", chunk[0], 1);
+  mu_assert("Split chunk.", chunk[1] * 4 <= AH5_EARRAY_CHUNK_BYTES);
+  mu_assert("Split chunk.", chunk[1] * 8 > AH5_EARRAY_CHUNK_BYTES);
+
+  return NULL;
+}
+
+
+
+
+static char *test_mapped_read(hid_t hdf)
+{
+  AH5_MEMORY_MAPPING_t mapping;
+  int data[10][3], rdata[4][3], rstrided[4], i, j, part;
+  hsize_t total, blockdims[2], start[2], stride[2], count[2], block[2];
+
+  for(i=0; i<10; i++)
+    for(j=0; j<3; j++)
+      data[i][j] = 10 * i + j;
+  blockdims[0] = 10;
+  blockdims[1] = 3;
+  mu_assert("Write dataset failed.", AH5_write_int_array(hdf, "mapped", 2, blockdims,
+            &data[0][0]));
+
+  // contiguous slices: 4, 3 and 3 rows
+  AH5_initialize_memory_mapping(&mapping);
+  total = 0;
+  for(part=0; part<3; part++)
+  {
+    mu_assert("Block mapping failed.",
+              AH5_set_block_memory_mapping(&mapping, hdf, "mapped", 3, part));
+    mu_assert_eq("Block rows.", mapping.blockdims[0], 4 - (part > 0));
+    mu_assert_eq("Block cols.", mapping.blockdims[1], 3);
+    mu_assert_eq("Block start.", mapping.start[0], total);
+    mu_assert("Mapped read failed.", AH5_read_mapped_array(hdf, "mapped", &mapping,
+              &rdata[0][0], H5T_NATIVE_INT));
+    for(i=0; i<(int)mapping.blockdims[0]; i++)
+      for(j=0; j<3; j++)
+        mu_assert_eq("Mapped data.", rdata[i][j], data[total + i][j]);
+    total += mapping.blockdims[0];
+  }
+  mu_assert_eq("All rows read.", total, 10);
+
+  // more parts than rows: the last parts are empty but still read
+  mu_assert("Block mapping failed.",
+            AH5_set_block_memory_mapping(&mapping, hdf, "mapped", 12, 11));
+  mu_assert_eq("Empty block.", mapping.blockdims[0], 0);
+  mu_assert("Empty mapped read failed.", AH5_read_mapped_array(hdf, "mapped", &mapping,
+            &rdata[0][0], H5T_NATIVE_INT));
+  mu_assert("Invalid part.", !AH5_set_block_memory_mapping(&mapping, hdf, "mapped", 3, 3));
+  AH5_free_memory_mapping(&mapping);
+
+  // strided mapping: every third row, last column
+  blockdims[0] = 4; blockdims[1] = 1;
+  start[0] = 0;     start[1] = 2;
+  stride[0] = 3;    stride[1] = 1;
+  count[0] = 4;     count[1] = 1;
+  block[0] = 1;     block[1] = 1;
+  AH5_set_memory_mapping(&mapping, 2, blockdims, start, stride, count, block);
+  mu_assert("Mapped read failed.", AH5_read_mapped_array(hdf, "mapped", &mapping,
+            rstrided, H5T_NATIVE_INT));
+  for(i=0; i<4; i++)
+    mu_assert_eq("Strided data.", rstrided[i], 30 * i + 2);
+  AH5_free_memory_mapping(&mapping);
+
+  return NULL;
+}
+
+
+
+
 static char *test_Earrayset(hid_t hdf)
 {
 
@@ -348,6 +551,67 @@ static char *test_Earrayset(hid_t hdf)
 
 
 
+static char *test_buffered_Earrayset(hid_t hdf)
+{
+  AH5_Earrayset_t a;
+  char status;
+  int i, k;
+  int row[3], valdim;
+  int ref[3 * 5], refdim[5];
+
+  hsize_t dims[] =
+  {
+    H5S_UNLIMITED, 3
+  };
+  hsize_t dims0[] = {0};
+  hsize_t dims1[] = {3};
+  int datadim[] = {1, 2, 3};
+
+  AH5_initialize_Earrayset(&a);
+  status = AH5_create_Earrayset(hdf, "buffered_arrayset",
+                                2, dims, H5T_NATIVE_INT, &a);
+  mu_assert("Creation of Earrayset failed.", status==AH5_TRUE);
+  status = AH5_set_dim_Earrayset(&a, 0,
+                                 1, dims0, NULL, H5T_NATIVE_INT,
+                                 NULL, NULL, NULL);
+  mu_assert("Set dim 0 of Earrayset failed.", status==AH5_TRUE);
+  status = AH5_set_dim_Earrayset(&a, 1,
+                                 1, dims1, datadim, H5T_NATIVE_INT,
+                                 NULL, NULL, NULL);
+  mu_assert("Set dim 1 of Earrayset failed.", status==AH5_TRUE);
+
+  status = AH5_set_buffer_Earrayset(&a, 2);
+  mu_assert("Set buffer of Earrayset failed.", status==AH5_TRUE);
+
+  // 5 appends of one row: flushed at 2 and 4, 1 remains staged
+  for(i=0; i<5; i++)
+  {
+    for(k=0; k<3; k++)
+      row[k] = ref[3 * i + k] = 3 * i + k;
+    valdim = refdim[i] = 10 * i;
+    status = AH5_append_Earrayset(&a, 1, row, &valdim);
+    mu_assert("Append to buffered Earrayset failed.", status==AH5_TRUE);
+  }
+  mu_assert_eq("Buffered Earrayset dims.", a.data.dims[0], 4);
+
+  status = AH5_flush_Earrayset(&a);
+  mu_assert("Flush of Earrayset failed.", status==AH5_TRUE);
+  mu_assert_eq("Flushed Earrayset dims.", a.data.dims[0], 5);
+
+  status = AH5_free_Earrayset(&a);
+  mu_assert("Free of Earrayset failed.", status==AH5_TRUE);
+
+  status = Verify(hdf, "buffered_arrayset/data", 3 * 5, ref);
+  mu_assert("Error in the buffered data.", status==AH5_TRUE);
+  status = Verify(hdf, "buffered_arrayset/ds/dim2", 5, refdim);
+  mu_assert("Error in the buffered dim.", status==AH5_TRUE);
+
+  return NULL;
+}
+
+
+
+
 int main(int UNUSED(argc), char **UNUSED(argv))
 {
 
@@ -380,6 +644,30 @@ int main(int UNUSED(argc), char **UNUSED(argv))
     return EXIT_FAILURE;
   }
 
+  message = test_buffered_Edataset(hdf);
+  if(message != NULL)
+  {
+    H5Fclose(hdf);
+    printf("%s", message);
+    return EXIT_FAILURE;
+  }
+
+  message = test_chunk_Edataset(hdf);
+  if(message != NULL)
+  {
+    H5Fclose(hdf);
+    printf("%s", message);
+    return EXIT_FAILURE;
+  }
+
+  message = test_mapped_read(hdf);
+  if(message != NULL)
+  {
+    H5Fclose(hdf);
+    printf("%s", message);
+    return EXIT_FAILURE;
+  }
+
   message = test_Earrayset(hdf);
   if(message != NULL)
   {
@@ -388,6 +676,14 @@ int main(int UNUSED(argc), char **UNUSED(argv))
     return EXIT_FAILURE;
   }
 
+  message = test_buffered_Earrayset(hdf);
+  if(message != NULL)
+  {
+    H5Fclose(hdf);
+    printf("%s", message);
+    return EXIT_FAILURE;
+  }
+
   H5Fclose(hdf);
   printf("SUCCESS\n");
 
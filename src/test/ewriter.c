@@ -0,0 +1,277 @@
+// test the background writer of the extendible datasets
+
+#include <stdio.h>
+
+#include "utest.h"
+#include <ah5.h>
+#include <ah5_ewriter.h>
+#include <ah5_estage.h>
+
+//! Test suite counter.
+int tests_run = 0;
+
+
+char *test_ewriter_Edataset()
+{
+  hid_t file_id;
+  AH5_ewriter_t *writer;
+  AH5_Edataset_t v, b;
+  hsize_t dims[] = {3, H5S_UNLIMITED};
+  int row[3];
+  int *data;
+  int i, k;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_initialize_Edataset(&v);
+  AH5_initialize_Edataset(&b);
+  mu_assert_true("create", AH5_create_int_Edataset(file_id, "steps", 2, dims, &v));
+  dims[1] = H5S_UNLIMITED;
+  mu_assert_true("create", AH5_create_int_Edataset(file_id, "buffered", 2, dims, &b));
+  mu_assert_true("buffer", AH5_set_buffer_Edataset(&b, 8));
+
+  // room for two steps only: the appends wait for the writer
+  mu_assert_true("open", AH5_open_ewriter(2 * sizeof(row), &writer));
+  for(i=0; i<50; i++)
+  {
+    for(k=0; k<3; k++)
+      row[k] = 100 * k + i;
+    mu_assert_true("append", AH5_ewriter_append_Edataset(writer, &v, 1, row));
+    mu_assert_true("append", AH5_ewriter_append_Edataset(writer, &b, 1, row));
+  }
+  mu_assert_true("flush", AH5_ewriter_flush(writer));
+  mu_assert_eq("dims", v.dims[1], 50);
+  mu_assert_eq("dims", b.dims[1], 48);
+
+  mu_assert_true("close", AH5_close_ewriter(writer));
+  mu_assert_true("free", AH5_free_Edataset(&v));
+  mu_assert_true("free", AH5_free_Edataset(&b));
+
+  mu_assert_true("read", AH5_read_int_dataset(file_id, "steps", 150, &data));
+  for(k=0; k<3; k++)
+    for(i=0; i<50; i++)
+      mu_assert_eq("data", data[50 * k + i], 100 * k + i);
+  free(data);
+
+  mu_assert_true("read", AH5_read_int_dataset(file_id, "buffered", 150, &data));
+  for(k=0; k<3; k++)
+    for(i=0; i<50; i++)
+      mu_assert_eq("buffered data", data[50 * k + i], 100 * k + i);
+  free(data);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *test_ewriter_Earrayset()
+{
+  hid_t file_id;
+  AH5_ewriter_t *writer;
+  AH5_Earrayset_t a;
+  hsize_t dims[] = {H5S_UNLIMITED, 2};
+  hsize_t dims0[] = {0};
+  hsize_t dims1[] = {2};
+  float datadim[] = {0.5, 1.5};
+  float values[2];
+  float time;
+  float *data;
+  int i;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_initialize_Earrayset(&a);
+  mu_assert_true("create", AH5_create_flt_Earrayset(file_id, "fields", 2, dims, &a));
+  mu_assert_true("dim", AH5_set_flt_dim_Earrayset(&a, 0, 1, dims0, NULL, NULL, NULL, NULL));
+  mu_assert_true("dim", AH5_set_flt_dim_Earrayset(&a, 1, 1, dims1, datadim,
+                 NULL, NULL, NULL));
+
+  mu_assert_true("open", AH5_open_ewriter(1024, &writer));
+  for(i=0; i<10; i++)
+  {
+    time = 0.1f * i;
+    values[0] = (float) i;
+    values[1] = (float) -i;
+    mu_assert_true("append", AH5_ewriter_append_Earrayset(writer, &a, 1, values, &time));
+  }
+  mu_assert_true("close", AH5_close_ewriter(writer));
+  mu_assert_true("free", AH5_free_Earrayset(&a));
+
+  mu_assert_true("read", AH5_read_flt_dataset(file_id, "fields/data", 20, &data));
+  for(i=0; i<10; i++)
+  {
+    mu_assert_eq("data", data[2 * i], (float) i);
+    mu_assert_eq("data", data[2 * i + 1], (float) -i);
+  }
+  free(data);
+
+  mu_assert_true("read", AH5_read_flt_dataset(file_id, "fields/ds/dim2", 10, &data));
+  for(i=0; i<10; i++)
+    mu_assert_eq("time", data[i], 0.1f * i);
+  free(data);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+// call data: the dataset to look at and its size seen by the writer thread
+typedef struct _steps_call_t
+{
+  hid_t file_id;
+  hsize_t nb_steps;
+} steps_call_t;
+
+static char count_steps(void *data)
+{
+  steps_call_t *call = (steps_call_t *)data;
+  hsize_t dims[2];
+  H5T_class_t type_class;
+  size_t length;
+  int value = 1;
+
+  if(H5LTget_dataset_info(call->file_id, "steps", dims, &type_class, &length) < 0)
+    return AH5_FALSE;
+  call->nb_steps = dims[1];
+  return AH5_write_int_dataset(call->file_id, "marker", 1, &value);
+}
+
+static char fail_call(void *data)
+{
+  (void) data;
+  return AH5_FALSE;
+}
+
+char *test_ewriter_call()
+{
+  hid_t file_id;
+  AH5_ewriter_t *writer;
+  AH5_Edataset_t v;
+  hsize_t dims[] = {3, H5S_UNLIMITED};
+  steps_call_t call;
+  int row[3] = {1, 2, 3};
+  int i;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_initialize_Edataset(&v);
+  mu_assert_true("create", AH5_create_int_Edataset(file_id, "steps", 2, dims, &v));
+  mu_assert_true("open", AH5_open_ewriter(1024, &writer));
+
+  // the call runs after the queued appends, before the flush
+  for(i=0; i<10; i++)
+    mu_assert_true("append", AH5_ewriter_append_Edataset(writer, &v, 1, row));
+  call.file_id = file_id;
+  call.nb_steps = 0;
+  mu_assert_true("call", AH5_ewriter_call(writer, count_steps, &call));
+  mu_assert_eq("steps", (int) call.nb_steps, 10);
+  mu_assert_true("append", AH5_ewriter_append_Edataset(writer, &v, 1, row));
+
+  // a failed call does not fail the appends
+  mu_assert_false("call", AH5_ewriter_call(writer, fail_call, NULL));
+  mu_assert_true("flush", AH5_ewriter_flush(writer));
+  mu_assert_eq("dims", (int) v.dims[1], 11);
+
+  mu_assert_true("close", AH5_close_ewriter(writer));
+  mu_assert_true("free", AH5_free_Edataset(&v));
+  mu_assert_true("marker", AH5_path_valid(file_id, "marker"));
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *test_estage()
+{
+  hid_t file_id;
+  AH5_ewriter_t *writer;
+  AH5_Earrayset_t a;
+  AH5_estage_t *stage;
+  hsize_t dims[] = {H5S_UNLIMITED, 64, 4};
+  hsize_t dims0[] = {0};
+  float slab[4];
+  float time;
+  float *data;
+  int step, t, k, nb_errors;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_initialize_Earrayset(&a);
+  mu_assert_true("create", AH5_create_flt_Earrayset(file_id, "field", 3, dims, &a));
+  mu_assert_true("dim", AH5_set_flt_dim_Earrayset(&a, 0, 1, dims0, NULL, NULL, NULL, NULL));
+  mu_assert_true("open", AH5_open_estage(&a, 1, &stage));
+  mu_assert_true("open", AH5_open_ewriter(1024 * 1024, &writer));
+
+  for(step=0; step<5; step++)
+  {
+    // each thread deposits the 4 values of its row
+    nb_errors = 0;
+    #pragma omp parallel for private(k, slab) reduction(+:nb_errors)
+    for(t=0; t<64; t++)
+    {
+      for(k=0; k<4; k++)
+        slab[k] = (float)(1000 * step + 10 * t + k);
+      if(!AH5_estage_deposit(stage, 4 * t, 4, slab))
+        nb_errors++;
+    }
+    mu_assert_eq("deposit", nb_errors, 0);
+
+    time = (float)step;
+    mu_assert_true("commit", AH5_estage_commit(stage, (step % 2) ? writer : NULL, &time));
+    mu_assert_true("flush", AH5_ewriter_flush(writer));
+  }
+
+  // incomplete and out of the block deposits are rejected
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 0, 4, slab));
+  mu_assert_false("incomplete", AH5_estage_commit(stage, NULL, &time));
+  mu_assert_false("overflow", AH5_estage_deposit(stage, 254, 4, slab));
+
+  // overlapping deposits are rejected and fail the commit, even if the
+  // block is covered
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 0, 4, slab));
+  mu_assert_false("overlap", AH5_estage_deposit(stage, 2, 4, slab));
+  mu_assert_false("same slab", AH5_estage_deposit(stage, 0, 4, slab));
+  for(t=1; t<64; t++)
+    mu_assert_true("deposit", AH5_estage_deposit(stage, 4 * t, 4, slab));
+  mu_assert_false("overlap", AH5_estage_commit(stage, NULL, &time));
+
+  // the next block starts clean
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 0, 4, slab));
+  mu_assert_false("incomplete", AH5_estage_commit(stage, NULL, &time));
+
+  // the deposits out of order are merged, then an overlap is still found
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 8, 4, slab));
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 0, 4, slab));
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 4, 4, slab));
+  mu_assert_false("overlap", AH5_estage_deposit(stage, 10, 4, slab));
+  mu_assert_true("deposit", AH5_estage_deposit(stage, 12, 4, slab));
+  mu_assert_false("overlap", AH5_estage_commit(stage, NULL, &time));
+
+  mu_assert_true("close", AH5_close_ewriter(writer));
+  mu_assert_true("close", AH5_close_estage(stage));
+  mu_assert_true("free", AH5_free_Earrayset(&a));
+
+  mu_assert_true("read", AH5_read_flt_dataset(file_id, "field/data", 5 * 256, &data));
+  for(step=0; step<5; step++)
+    for(t=0; t<64; t++)
+      for(k=0; k<4; k++)
+        mu_assert_eq("data", data[256 * step + 4 * t + k],
+                     (float)(1000 * step + 10 * t + k));
+  free(data);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *all_tests()
+{
+  mu_run_test(test_ewriter_Edataset);
+  mu_run_test(test_ewriter_Earrayset);
+  mu_run_test(test_ewriter_call);
+  mu_run_test(test_estage);
+
+  return 0;
+}
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -0,0 +1,137 @@
+// test file create and open options
+
+#include <string.h>
+#include <stdio.h>
+
+#include <ah5.h>
+#include "utest.h"
+
+//! Test suite counter.
+int tests_run = 0;
+
+
+//! Test create and open with options.
+char *test_file_options()
+{
+  hid_t file_id, fapl;
+  AH5_file_options_t options;
+  int data[4] = {1, 2, 3, 4}, *rdata;
+  size_t nslots, nbytes;
+  double w0;
+  int mdc_nelmts;
+  H5AC_cache_config_t mdc;
+  char entry_point[16];
+
+  AH5_init_file_options(&options);
+  options.chunk_cache_slots = 12421;
+  options.chunk_cache_bytes = 64 * 1024 * 1024;
+  options.chunk_cache_w0 = 1;
+  options.mdc_size = 8 * 1024 * 1024;
+  options.fspace_strategy = AH5_FSPACE_PAGE;
+  options.fspace_page_size = 64 * 1024;
+  options.page_buffer_size = 1024 * 1024;
+  options.alignment = 4096;
+  options.alignment_threshold = 64 * 1024;
+  options.driver = AH5_DRIVER_SEC2;
+
+  file_id = AH5_create_ex("test_file_options.test.h5", H5F_ACC_TRUNC, "/mesh", &options);
+  mu_assert("Create with options.", file_id >= 0);
+  mu_assert("Write.", AH5_write_int_dataset(file_id, "data", 4, data));
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  file_id = AH5_open_ex("test_file_options.test.h5", H5F_ACC_RDONLY, &options);
+  mu_assert("Open with options.", file_id >= 0);
+
+  fapl = H5Fget_access_plist(file_id);
+  H5Pget_cache(fapl, &mdc_nelmts, &nslots, &nbytes, &w0);
+  mu_assert_eq("Chunk cache slots.", nslots, 12421);
+  mu_assert_eq("Chunk cache bytes.", nbytes, 64 * 1024 * 1024);
+  mdc.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+  H5Pget_mdc_config(fapl, &mdc);
+  mu_assert_eq("Metadata cache size.", mdc.initial_size, 8 * 1024 * 1024);
+  H5Pclose(fapl);
+
+  mu_assert("Entry point.", AH5_read_entrypoint(file_id, entry_point) != NULL);
+  mu_assert_str_equal("Entry point.", entry_point, "/mesh");
+  mu_assert("Read.", AH5_read_int_dataset(file_id, "data", 4, &rdata));
+  mu_assert_eq("Read.", rdata[3], 4);
+  free(rdata);
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  // The page buffer needs a paged file.
+  options.fspace_strategy = AH5_FSPACE_DEFAULT;
+  file_id = AH5_create_ex("test_file_options_nopage.test.h5", H5F_ACC_TRUNC, NULL, &options);
+  mu_assert("Page buffer without paged file.", file_id < 0);
+
+  // No options are the HDF5 defaults.
+  file_id = AH5_open_ex("test_file_options.test.h5", H5F_ACC_RDONLY, NULL);
+  mu_assert("Open without options.", file_id >= 0);
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+//! Test the in memory files.
+char *test_file_in_memory()
+{
+  hid_t file_id, image_ids[2];
+  int data[4] = {1, 2, 3, 4}, *rdata;
+  void *image;
+  size_t size;
+  int i;
+
+  file_id = AH5_create("test_file_in_memory.test.h5", H5F_ACC_TRUNC, NULL);
+  mu_assert("Create.", file_id >= 0);
+  mu_assert("Write.", AH5_write_int_dataset(file_id, "data", 4, data));
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  // Changes without write back are lost.
+  file_id = AH5_open_in_memory("test_file_in_memory.test.h5", H5F_ACC_RDWR, AH5_FALSE);
+  mu_assert("Open in memory.", file_id >= 0);
+  mu_assert("Write.", AH5_write_int_dataset(file_id, "lost", 4, data));
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  file_id = AH5_open_in_memory("test_file_in_memory.test.h5", H5F_ACC_RDWR, AH5_TRUE);
+  mu_assert("Open in memory.", file_id >= 0);
+  mu_assert_false("Lost changes.", AH5_path_valid(file_id, "/lost"));
+  mu_assert("Write.", AH5_write_int_dataset(file_id, "kept", 4, data));
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  file_id = AH5_open("test_file_in_memory.test.h5", H5F_ACC_RDONLY);
+  mu_assert_true("Written back.", AH5_path_valid(file_id, "/kept"));
+
+  // One image opened twice without copy.
+  mu_assert("Get image.", AH5_get_image(file_id, &image, &size));
+  mu_assert("Image size.", size > 0);
+  mu_assert_eq("Close.", AH5_close(file_id), 0);
+
+  for (i = 0; i < 2; ++i)
+  {
+    image_ids[i] = AH5_open_image(image, size,
+                                  H5LT_FILE_IMAGE_DONT_COPY | H5LT_FILE_IMAGE_DONT_RELEASE);
+    mu_assert("Open image.", image_ids[i] >= 0);
+  }
+  for (i = 0; i < 2; ++i)
+  {
+    mu_assert("Read.", AH5_read_int_dataset(image_ids[i], "kept", 4, &rdata));
+    mu_assert_eq("Read.", rdata[2], 3);
+    free(rdata);
+    mu_assert_eq("Close.", AH5_close(image_ids[i]), 0);
+  }
+  AH5_release(image);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+// Run all tests
+char *all_tests()
+{
+  mu_run_test(test_file_options);
+  mu_run_test(test_file_in_memory);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+AH5_UTEST_MAIN(all_tests, tests_run);
@@ -257,6 +257,94 @@ char *test_write_ft_dataset()
   return MU_FINISHED_WITHOUT_ERRORS;
 }
 
+char *test_read_ft_dataset_slab()
+{
+  hid_t file_id;
+  hsize_t i, j;
+  hsize_t dims[2] = {10, 2};
+  hsize_t start[2] = {1, 1}, count[2] = {3, 1}, stride[2] = {2, 1};
+  AH5_dataset_t ds, rds;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_init_ft_dataset(&ds, "/floatingType/dataset", 2, dims, H5T_FLOAT);
+  for (i = 0; i < dims[0]*dims[1]; ++i)
+    ds.values.f[i] = (float)i;
+  mu_assert("Write ds.", AH5_write_ft_dataset(file_id, &ds));
+  AH5_free_ft_dataset(&ds);
+
+  // Read the second column of the rows 1, 3 and 5.
+  mu_assert("Read ds slab.",
+            AH5_read_ft_dataset_slab(file_id, "/floatingType/dataset", start, count, stride, &rds));
+  mu_assert_eq("Check slab rank.", rds.nb_dims, 2);
+  mu_assert_eq("Check slab dims.", rds.dims[0], 3);
+  mu_assert_eq("Check slab dims.", rds.dims[1], 1);
+  for (j = 0; j < 3; ++j)
+    mu_assert_eq("Check slab values.", rds.values.f[j], (int) (2 * (1 + 2 * j) + 1));
+
+  // Out of range selection.
+  count[0] = 6;
+  mu_assert("Read ds invalid slab.",
+            !AH5_read_ft_dataset_slab(file_id, "/floatingType/dataset", start, count, stride, &ds));
+
+  AH5_free_ft_dataset(&rds);
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *test_read_ft_dataset_wide()
+{
+  hid_t file_id;
+  hsize_t i;
+  hsize_t dims[2] = {3, 2};
+  double dvalues[6];
+  int64_t lvalues[6];
+  AH5_dataset_t ds, rds;
+
+  file_id = AH5_auto_test_file();
+
+  AH5_init_ft_dataset(&ds, "/floatingType/double", 2, dims, H5T_FLOAT);
+  AH5_release(ds.values.f);
+  ds.values.d = dvalues;
+  for (i = 0; i < 6; ++i)
+    dvalues[i] = 1.0e3 + 1.0e-6 * i;
+  mu_assert("Write double ds.", AH5_write_ft_dataset_wide(file_id, &ds));
+
+  free(ds.path);
+  AH5_setpath(&ds.path, "/floatingType/int64");
+  ds.type_class = H5T_INTEGER;
+  ds.values.l = lvalues;
+  for (i = 0; i < 6; ++i)
+    lvalues[i] = ((int64_t) 1 << 40) + i;
+  mu_assert("Write int64 ds.", AH5_write_ft_dataset_wide(file_id, &ds));
+  ds.values.f = NULL;
+  AH5_free_ft_dataset(&ds);
+
+  mu_assert("Read double ds.",
+            AH5_read_ft_dataset_wide(file_id, "/floatingType/double", &rds));
+  mu_assert_eq("Double ds class.", rds.type_class, H5T_FLOAT);
+  for (i = 0; i < 6; ++i)
+    mu_assert_equal("Double values.", rds.values.d[i], dvalues[i]);
+  AH5_free_ft_dataset(&rds);
+
+  mu_assert("Read int64 ds.",
+            AH5_read_ft_dataset_wide(file_id, "/floatingType/int64", &rds));
+  for (i = 0; i < 6; ++i)
+    mu_assert("Int64 values.", rds.values.l[i] == lvalues[i]);
+  AH5_free_ft_dataset(&rds);
+
+  // The legacy reader converts to float.
+  mu_assert("Read double ds as float.",
+            AH5_read_ft_dataset(file_id, "/floatingType/double", &rds));
+  mu_assert_close("Float values.", rds.values.f[5], 1.0e3, 1.e-4);
+  AH5_free_ft_dataset(&rds);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
 char *test_write_ft_arrayset()
 {
   hid_t file_id;
@@ -364,6 +452,48 @@ char *test_write_ft_arrayset()
   return MU_FINISHED_WITHOUT_ERRORS;
 }
 
+char *test_ft_arrayset_wide()
+{
+  hid_t file_id;
+  hsize_t i;
+  hsize_t dims[1] = {3};
+  float fvalues[3] = {0., 0.5, 1.};
+  double dvalues[3];
+  AH5_arrayset_t array, rarray;
+
+  file_id = AH5_auto_test_file();
+
+  array.path = "/floatingType/doublearray";
+  array.opt_attrs.nb_instances = 0;
+  array.nb_dims = 1;
+  array.dims = (AH5_vector_t *)malloc(sizeof(AH5_vector_t));
+  array.dims[0].nb_values = 3;
+  array.dims[0].opt_attrs.nb_instances = 0;
+  array.dims[0].type_class = H5T_FLOAT;
+  array.dims[0].values.f = fvalues;
+  array.data.type_class = H5T_FLOAT;
+  array.data.opt_attrs.nb_instances = 0;
+  array.data.nb_dims = 1;
+  array.data.dims = dims;
+  array.data.values.d = dvalues;
+  for (i = 0; i < 3; ++i)
+    dvalues[i] = 1.0e3 + 1.0e-6 * i;
+
+  mu_assert("Write double arrayset.", AH5_write_ft_arrayset_wide(file_id, &array));
+  free(array.dims);
+
+  mu_assert("Read double arrayset.",
+            AH5_read_ft_arrayset_wide(file_id, "/floatingType/doublearray", &rarray));
+  mu_assert_eq("Double arrayset dims.", rarray.nb_dims, 1);
+  for (i = 0; i < 3; ++i)
+    mu_assert_equal("Double arrayset values.", rarray.data.values.d[i], dvalues[i]);
+  AH5_free_ft_arrayset(&rarray);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
 
 // Run all tests
 char *all_tests()
@@ -371,7 +501,10 @@ char *all_tests()
   mu_run_test(test_write_single_flotingtype);
   mu_run_test(test_write_ft_vector);
   mu_run_test(test_write_ft_dataset);
+  mu_run_test(test_read_ft_dataset_slab);
+  mu_run_test(test_read_ft_dataset_wide);
   mu_run_test(test_write_ft_arrayset);
+  mu_run_test(test_ft_arrayset_wide);
   mu_run_test(test_init_datasetx);
   mu_run_test(test_init_vector);
   mu_run_test(test_init_dataset);
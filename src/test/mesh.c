@@ -888,6 +888,276 @@ char *test_read_umesh()
 }
 
 
+//! Test read all the groups of an unstructured mesh.
+char *test_read_ugroups()
+{
+  AH5_umesh_t umesh;
+  AH5_ugroup_t ugrp, *groups;
+  hid_t file_id, loc_id;
+  hsize_t nb_groups, i;
+  int groupelts[3] = {4, 3, 2};
+
+  // Write a simple mesh with a second (node) group.
+  file_id = AH5_auto_test_file();
+  build_umesh_1(&umesh);
+  loc_id = H5Gcreate(file_id, "/mesh", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  AH5_write_umesh(loc_id, &umesh);
+  ugrp.path = "nodes";
+  ugrp.entitytype = AH5_GROUP_NODE;
+  ugrp.nb_groupelts = 3;
+  ugrp.groupelts = groupelts;
+  mu_assert("Write node group.", AH5_write_ugroup(loc_id, &ugrp, 1));
+  H5Gclose(loc_id);
+  AH5_free_umesh(&umesh);
+
+  mu_assert("Read groups.", AH5_read_ugroups(file_id, "/mesh/group", &nb_groups, &groups));
+  mu_assert_eq("Check number of groups.", nb_groups, 2);
+  mu_assert_str_equal("Check path.", groups[0].path, "/mesh/group/name");
+  mu_assert_eq("Check entity type.", groups[0].entitytype, AH5_GROUP_FACE);
+  mu_assert_eq("Check size.", groups[0].nb_groupelts, 1);
+  mu_assert_eq("Check elements.", groups[0].groupelts[0], 2);
+  mu_assert_str_equal("Check path.", groups[1].path, "/mesh/group/nodes");
+  mu_assert_eq("Check entity type.", groups[1].entitytype, AH5_GROUP_NODE);
+  mu_assert_eq("Check size.", groups[1].nb_groupelts, 3);
+  for (i = 0; i < 3; ++i)
+    mu_assert_eq("Check elements.", groups[1].groupelts[i], groupelts[i]);
+
+  // Same as the one by one reader.
+  mu_assert("Read group.", AH5_read_ugroup(file_id, "/mesh/group/nodes", &ugrp));
+  mu_assert_eq("Check entity type.", ugrp.entitytype, groups[1].entitytype);
+  mu_assert_eq("Check size.", ugrp.nb_groupelts, groups[1].nb_groupelts);
+  free(ugrp.path);
+  AH5_release(ugrp.groupelts);
+
+  for (i = 0; i < nb_groups; ++i)
+  {
+    free(groups[i].path);
+    AH5_release(groups[i].groupelts);
+  }
+  free(groups);
+
+  // No group.
+  mu_assert("Read no group.", AH5_read_ugroups(file_id, "/mesh/nothing", &nb_groups, &groups));
+  mu_assert_eq("Check number of groups.", nb_groups, 0);
+  mu_assert_eq_ptr("Check groups.", groups, NULL);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+//! Test the lazy unstructured mesh.
+char *test_umesh_handle()
+{
+  AH5_umesh_t umesh;
+  AH5_umesh_handle_t handle;
+  AH5_ugroup_t *ugroup;
+  AH5_usom_table_t *som;
+  hid_t file_id, loc_id;
+  float *nodes;
+
+  file_id = AH5_auto_test_file();
+  build_umesh_1(&umesh);
+  loc_id = H5Gcreate(file_id, "/mesh", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  AH5_write_umesh(loc_id, &umesh);
+  H5Gclose(loc_id);
+  AH5_free_umesh(&umesh);
+
+  mu_assert("Open missing mesh.", !AH5_open_umesh_handle(file_id, "/nothing", &handle));
+  mu_assert("Open mesh.", AH5_open_umesh_handle(file_id, "/mesh", &handle));
+  mu_assert_eq("Check sizes.", handle.umesh.nb_elementnodes, 11);
+  mu_assert_eq("Check sizes.", handle.umesh.nb_elementtypes, 3);
+  mu_assert_eq("Check sizes.", handle.umesh.nb_nodes[0], 5);
+  mu_assert_eq("Check sizes.", handle.umesh.nb_nodes[1], 3);
+  mu_assert_eq("Check sizes.", handle.umesh.nb_groups, 1);
+  mu_assert_eq("Check sizes.", handle.umesh.nb_som_tables, 3);
+  mu_assert_eq_ptr("Nothing read.", handle.umesh.nodes, NULL);
+  mu_assert_eq_ptr("Nothing read.", handle.umesh.elementnodes, NULL);
+  mu_assert_eq_ptr("Nothing read.", handle.umesh.groups[0].path, NULL);
+
+  nodes = AH5_umesh_handle_nodes(&handle);
+  mu_assert("Read nodes.", nodes != NULL);
+  mu_assert_eq("Check nodes.", nodes[14], 14);
+  mu_assert_eq_ptr("Read once.", AH5_umesh_handle_nodes(&handle), nodes);
+  mu_assert_eq_ptr("Elements not read.", handle.umesh.elementnodes, NULL);
+
+  mu_assert("Read element nodes.", AH5_umesh_handle_elementnodes(&handle) != NULL);
+  mu_assert_eq("Check element nodes.", handle.umesh.elementnodes[7], 4);
+  mu_assert("Read element types.", AH5_umesh_handle_elementtypes(&handle) != NULL);
+  mu_assert_eq("Check element types.", handle.umesh.elementtypes[2], AH5_UELE_TRI3);
+
+  ugroup = AH5_umesh_handle_group(&handle, 0);
+  mu_assert("Read group.", ugroup != NULL);
+  mu_assert_str_equal("Check group.", ugroup->path, "/mesh/group/name");
+  mu_assert_eq("Check group.", ugroup->groupelts[0], 2);
+  mu_assert_eq_ptr("Out of range group.", AH5_umesh_handle_group(&handle, 1), NULL);
+
+  som = AH5_umesh_handle_som_table(&handle, 0);
+  mu_assert("Read selector on mesh.", som != NULL);
+  mu_assert_eq("Check selector on mesh.", som->type, SOM_EDGE);
+
+  AH5_release_umesh_handle(&handle, AH5_UMESH_NODES | AH5_UMESH_GROUPS);
+  mu_assert_eq_ptr("Released.", handle.umesh.nodes, NULL);
+  mu_assert_eq_ptr("Released.", handle.umesh.groups[0].path, NULL);
+  mu_assert("Not released.", handle.umesh.elementnodes != NULL);
+  mu_assert("Read again.", AH5_umesh_handle_nodes(&handle) != NULL);
+
+  // A failed read leaves the group unread.
+  H5Adelete_by_name(file_id, "/mesh/group/name", AH5_A_ENTITY_TYPE, H5P_DEFAULT);
+  mu_assert_eq_ptr("Invalid group.", AH5_umesh_handle_group(&handle, 0), NULL);
+  mu_assert_eq_ptr("Invalid group.", handle.umesh.groups[0].path, NULL);
+  mu_assert_eq_ptr("Invalid group.", handle.umesh.groups[0].groupelts, NULL);
+  mu_assert_eq("Invalid group.", (int) handle.umesh.groups[0].nb_groupelts, 0);
+
+  AH5_close_umesh_handle(&handle);
+  mu_assert_eq_ptr("Closed.", handle.umesh.nodes, NULL);
+  mu_assert_eq_ptr("Closed.", handle.umesh.groups, NULL);
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+//! Test read a range of an unstructured mesh.
+char *test_read_umesh_slab()
+{
+  AH5_umesh_t umesh;
+  hid_t file_id, loc_id;
+  float nodes[2*3];
+  double dnodes[2*3];
+  hsize_t dims[2] = {2, 3};
+  int elementnodes[4];
+  int64_t lelementnodes[4];
+  char elementtypes[2];
+  int i;
+
+  // Write a simple mesh test.
+  file_id = AH5_auto_test_file();
+  build_umesh_1(&umesh);
+  loc_id = H5Gcreate(file_id, "/mesh", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  AH5_write_umesh(loc_id, &umesh);
+  H5Gclose(loc_id);
+  AH5_free_umesh(&umesh);
+
+  mu_assert("Read nodes slab.", AH5_read_umesh_nodes_slab(file_id, "/mesh", 3, 2, nodes));
+  for (i = 0; i < 2*3; ++i)
+    mu_assert_eq("Check nodes.", nodes[i], 9 + i);
+  mu_assert("Read out of range nodes.", !AH5_read_umesh_nodes_slab(file_id, "/mesh", 4, 2, nodes));
+
+  mu_assert("Read element nodes slab.",
+            AH5_read_umesh_elementnodes_slab(file_id, "/mesh", 4, 4, elementnodes));
+  for (i = 0; i < 4; ++i)
+    mu_assert_eq("Check element nodes.", elementnodes[i], 1 + i);
+
+  mu_assert("Read element types slab.",
+            AH5_read_umesh_elementtypes_slab(file_id, "/mesh", 1, 2, elementtypes));
+  mu_assert_eq("Check element types.", elementtypes[0], AH5_UELE_TETRA4);
+  mu_assert_eq("Check element types.", elementtypes[1], AH5_UELE_TRI3);
+
+  // Double nodes and 64-bit element nodes.
+  mu_assert("Read double nodes slab.",
+            AH5_read_umesh_nodes_dbl_slab(file_id, "/mesh", 3, 2, dnodes));
+  for (i = 0; i < 2*3; ++i)
+    mu_assert_eq("Check double nodes.", dnodes[i], 9 + i);
+  mu_assert("Read 64-bit element nodes slab.",
+            AH5_read_umesh_elementnodes_i64_slab(file_id, "/mesh", 4, 4, lelementnodes));
+  for (i = 0; i < 4; ++i)
+    mu_assert_eq("Check 64-bit element nodes.", lelementnodes[i], 1 + i);
+
+  // The whole mesh reader does not narrow double nodes.
+  H5Ldelete(file_id, "/mesh/nodes", H5P_DEFAULT);
+  AH5_clear_path_cache(file_id);
+  for (i = 0; i < 2*3; ++i)
+    dnodes[i] = 0.1 * i;
+  mu_assert("Write double nodes.", AH5_write_dbl_array(file_id, "/mesh/nodes", 2, dims, dnodes));
+  mu_assert("Read double nodes umesh.", !AH5_read_umesh(file_id, "/mesh", &umesh));
+  AH5_free_umesh(&umesh);
+  mu_assert("Read double nodes slab.",
+            AH5_read_umesh_nodes_dbl_slab(file_id, "/mesh", 0, 2, dnodes));
+  mu_assert("Check double nodes.", dnodes[5] == 0.5);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
+//! Accumulate the blocks read by AH5_read_umesh_*_blocks.
+typedef struct _blocks_t
+{
+  int nb_blocks;
+  int nb_elementnodes;
+  int elementnodes[11];
+  int nb_nodes;
+  float nodes_sum;
+} blocks_t;
+
+char elements_block(hsize_t first_element, hsize_t nb_elements, const char *elementtypes,
+                    hsize_t first_elementnode, hsize_t nb_elementnodes,
+                    const int *elementnodes, void *user_data)
+{
+  blocks_t *blocks = (blocks_t *)user_data;
+  hsize_t i, size = 0;
+
+  for (i = 0; i < nb_elements; ++i)
+    size += AH5_element_size(elementtypes[i]);
+  if (first_element != 2 * (hsize_t)blocks->nb_blocks || size != nb_elementnodes
+      || first_elementnode != (hsize_t)blocks->nb_elementnodes)
+    return AH5_FALSE;
+
+  for (i = 0; i < nb_elementnodes; ++i)
+    blocks->elementnodes[blocks->nb_elementnodes++] = elementnodes[i];
+  blocks->nb_blocks++;
+  return AH5_TRUE;
+}
+
+char nodes_block(hsize_t UNUSED(first_node), hsize_t nb_nodes, hsize_t nodes_dim,
+                 const float *nodes, void *user_data)
+{
+  blocks_t *blocks = (blocks_t *)user_data;
+  hsize_t i;
+
+  for (i = 0; i < nb_nodes * nodes_dim; ++i)
+    blocks->nodes_sum += nodes[i];
+  blocks->nb_nodes += nb_nodes;
+  return AH5_TRUE;
+}
+
+//! Test read an unstructured mesh by blocks.
+char *test_read_umesh_blocks()
+{
+  AH5_umesh_t umesh;
+  hid_t file_id, loc_id;
+  blocks_t blocks;
+  int i;
+
+  file_id = AH5_auto_test_file();
+  build_umesh_1(&umesh);
+  loc_id = H5Gcreate(file_id, "/mesh", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  AH5_write_umesh(loc_id, &umesh);
+  H5Gclose(loc_id);
+
+  memset(&blocks, 0, sizeof(blocks));
+  mu_assert("Read elements by blocks.",
+            AH5_read_umesh_elements_blocks(file_id, "/mesh", 2, elements_block, &blocks));
+  mu_assert_eq("Check number of blocks.", blocks.nb_blocks, 2);
+  mu_assert_eq("Check number of element nodes.", blocks.nb_elementnodes, 11);
+  for (i = 0; i < 11; ++i)
+    mu_assert_eq("Check element nodes.", blocks.elementnodes[i], umesh.elementnodes[i]);
+
+  mu_assert("Read nodes by blocks.",
+            AH5_read_umesh_nodes_blocks(file_id, "/mesh", 2, nodes_block, &blocks));
+  mu_assert_eq("Check number of nodes.", blocks.nb_nodes, 5);
+  mu_assert_eq("Check nodes.", blocks.nodes_sum, 14 * 15 / 2);
+
+  AH5_free_umesh(&umesh);
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
 //! Test
 char *test_element_size()
 {
@@ -910,6 +1180,41 @@ char *test_element_size()
 }
 
 
+//! Test the element offsets index.
+char *test_uelement_index()
+{
+  AH5_umesh_t umesh;
+  AH5_uelement_index_t index;
+  int *nodes, nb_nodes;
+
+  build_umesh_1(&umesh);
+  mu_assert("Build index.", AH5_init_uelement_index(&index, &umesh) == &index);
+  mu_assert_eq("Check nb elements.", index.nb_elements, 3);
+  mu_assert_eq("Check offset.", AH5_UELEMENT_OFFSET(&index, 0), 0);
+  mu_assert_eq("Check offset.", AH5_UELEMENT_OFFSET(&index, 1), 4);
+  mu_assert_eq("Check offset.", AH5_UELEMENT_OFFSET(&index, 2), 8);
+  mu_assert_eq("Check offset.", AH5_UELEMENT_OFFSET(&index, 3), 11);
+  mu_assert_eq("Check size.", AH5_UELEMENT_SIZE(&index, 2), 3);
+  mu_assert_eq("Check type.", AH5_uelement_type(&umesh, 2), AH5_UELE_TRI3);
+  nodes = AH5_uelement_nodes(&umesh, &index, 1, &nb_nodes);
+  mu_assert_eq("Check nb nodes.", nb_nodes, 4);
+  mu_assert_eq("Check nodes.", nodes[0], 1);
+  mu_assert_eq("Check nodes.", nodes[3], 4);
+  AH5_free_uelement_index(&index);
+
+  // Invalid connectivity.
+  umesh.nb_elementnodes = 10;
+  mu_assert("Build invalid index.", AH5_init_uelement_index(&index, &umesh) == NULL);
+  umesh.nb_elementnodes = 11;
+  umesh.elementtypes[1] = 42;
+  mu_assert("Build invalid index.", AH5_init_uelement_index(&index, &umesh) == NULL);
+
+  AH5_free_umesh(&umesh);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+
 // Test write structured mesh
 char* test_write_smesh() {
   AH5_mesh_t mesh;
@@ -1282,8 +1587,13 @@ char *all_tests()
   mu_run_test(test_write_umesh);
   mu_run_test(test_write_unstructured_nodes_mesh);
   mu_run_test(test_read_umesh);
+  mu_run_test(test_read_ugroups);
+  mu_run_test(test_read_umesh_slab);
+  mu_run_test(test_umesh_handle);
+  mu_run_test(test_read_umesh_blocks);
   mu_run_test(test_write_mesh);
   mu_run_test(test_element_size);
+  mu_run_test(test_uelement_index);
   mu_run_test(test_write_smesh);
   mu_run_test(test_umsh_made_of_nodes);
   mu_run_test(test_misformed_umesh);
@@ -133,12 +133,133 @@ char *test_get_base_or_name_from_path()
   return 0;
 }
 
+char *test_path_valid()
+{
+  hid_t file_id, group_id;
+
+  file_id = AH5_auto_test_file();
+  group_id = H5Gcreate(file_id, "/a", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  H5Gclose(H5Gcreate(group_id, "b", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+
+  mu_assert_true("valid", AH5_path_valid(file_id, "/a/b"));
+  mu_assert_true("valid (cached)", AH5_path_valid(file_id, "/a/b"));
+  mu_assert_true("valid prefix", AH5_path_valid(file_id, "/a"));
+  mu_assert_true("relative", AH5_path_valid(group_id, "b"));
+  mu_assert_true("current", AH5_path_valid(group_id, "."));
+  mu_assert_false("invalid", AH5_path_valid(file_id, "/a/c"));
+  mu_assert_false("invalid", AH5_path_valid(file_id, "/a/b/c/d"));
+  mu_assert_false("empty", AH5_path_valid(file_id, ""));
+
+  // The cache of the file must be cleared after removing links.
+  H5Ldelete(file_id, "/a/b", H5P_DEFAULT);
+  AH5_clear_path_cache(file_id);
+  mu_assert_false("removed", AH5_path_valid(file_id, "/a/b"));
+  mu_assert_true("still valid", AH5_path_valid(file_id, "/a"));
+  mu_assert_false("removed from the group", AH5_path_valid(group_id, "b"));
+
+  AH5_set_path_cache(AH5_FALSE);
+  mu_assert_true("no cache", AH5_path_valid(file_id, "/a"));
+  mu_assert_false("no cache", AH5_path_valid(file_id, "/a/b"));
+  AH5_set_path_cache(AH5_TRUE);
+
+  H5Gclose(group_id);
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *test_read_names()
+{
+  hid_t file_id;
+  AH5_names_t names;
+  AH5_children_t children;
+  char name[16];
+  int i;
+
+  file_id = AH5_auto_test_file();
+  H5Gclose(H5Gcreate(file_id, "/a", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+  H5Gclose(H5Gcreate(file_id, "/a/_param", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+  for (i = 0; i < 40; ++i)
+  {
+    sprintf(name, "/a/child_%02d", i);
+    H5Gclose(H5Gcreate(file_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+  }
+
+  AH5_init_names(&names);
+  mu_assert_true("read names", AH5_read_names(file_id, "/a", &names));
+  mu_assert_eq("number of names", names.nb_names, 40);
+  mu_assert_str_equal("first name", AH5_NAME(&names, 0), "/child_00");
+  mu_assert_str_equal("last name", AH5_NAME(&names, 39), "/child_39");
+
+  // Reuse the names.
+  mu_assert_true("read root names", AH5_read_names(file_id, "/", &names));
+  mu_assert_eq("number of names", names.nb_names, 1);
+  mu_assert_str_equal("root name", AH5_NAME(&names, 0), "/a");
+  mu_assert_false("invalid path", AH5_read_names(file_id, "/b", &names));
+  mu_assert_eq("number of names", names.nb_names, 0);
+  AH5_free_names(&names);
+
+  children = AH5_read_children_name(file_id, "/a");
+  mu_assert_eq("number of children", children.nb_children, 40);
+  mu_assert_str_equal("child name", children.childnames[1], "/child_01");
+  for (i = 0; i < 40; ++i)
+    free(children.childnames[i]);
+  free(children.childnames);
+
+  AH5_close_test_file(file_id);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
+char *test_set()
+{
+  AH5_set_t aset;
+  const char *names[4] = {"b", "a", "b", "ab"};
+  char name[16];
+  hsize_t index, i;
+
+  AH5_init_set(&aset);
+  mu_assert_false("empty set", AH5_index_in_set(&aset, "a", &index));
+
+  mu_assert_eq_ptr("add all", AH5_add_all_to_set(&aset, names, 4), &aset);
+  mu_assert_eq("number of values", aset.nb_values, 3);
+  mu_assert_str_equal("insertion order", aset.values[0], "b");
+  mu_assert_str_equal("insertion order", aset.values[2], "ab");
+  mu_assert_true("present", AH5_index_in_set(&aset, "a", &index));
+  mu_assert_eq("index", index, 1);
+  mu_assert_true("present", AH5_index_in_set(&aset, "ab", &index));
+  mu_assert_eq("index", index, 2);
+  mu_assert_false("no prefix match", AH5_index_in_set(&aset, "abc", NULL));
+
+  // Grow the set.
+  for (i = 0; i < 1000; ++i)
+  {
+    sprintf(name, "name_%d", (int) i);
+    AH5_add_to_set(&aset, name);
+    AH5_add_to_set(&aset, name);
+  }
+  mu_assert_eq("number of values", aset.nb_values, 1003);
+  mu_assert_eq("geometric growth", (int) aset.capacity, 1024);
+  mu_assert_true("present", AH5_index_in_set(&aset, "name_500", &index));
+  mu_assert_eq("index", index, 503);
+  mu_assert_str_equal("value", aset.values[1002], "name_999");
+
+  AH5_free_set(&aset);
+  mu_assert_eq("free", aset.nb_values, 0);
+  mu_assert_eq_ptr("free", aset.values, NULL);
+
+  return MU_FINISHED_WITHOUT_ERRORS;
+}
+
 char *all_tests()
 {
   mu_run_test(test_join);
   mu_run_test(test_trim);
   mu_run_test(test_get_base_or_name_from_path);
   mu_run_test(test_set_path);
+  mu_run_test(test_path_valid);
+  mu_run_test(test_read_names);
+  mu_run_test(test_set);
 
   return 0;
 }